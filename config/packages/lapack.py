@@ -47,11 +47,11 @@ class Lapack(package.Package):
   def Check(self,conf,vars,cmake,petsc):
 
     # LAPACK standard functions
-    l = ['laev2','gehrd','lanhs','lange','trexc','trevc','geevx','gees','ggev','ggevx','gelqf','geqp3','gesdd','tgexc','tgevc','pbtrf','stedc','hsein','larfg','larf','lacpy','lascl','lansy','laset','trsyl','trtri']
+    l = ['laev2','gehrd','lanhs','lange','trexc','trevc','geevx','gees','ggev','ggevx','gelqf','geqp3','gesdd','tgexc','tgevc','pbtrf','stedc','hsein','larfg','larf','larft','lacpy','lascl','lansy','laset','trsyl','trtri']
 
     # LAPACK functions with different real and complex versions
     if petsc.scalar == 'real':
-      l += ['orghr','syevr','syevd','sytrd','sygvd','ormlq','orgtr']
+      l += ['orghr','syevr','syevd','sytrd','sygvd','ormlq','orgtr','sbtrd']
       if petsc.precision == 'single':
         prefix = 's'
       elif petsc.precision == '__float128':
@@ -59,7 +59,7 @@ class Lapack(package.Package):
       else:
         prefix = 'd'
     else:
-      l += ['unghr','heevr','heevd','hetrd','hegvd','unmlq','ungtr']
+      l += ['unghr','heevr','heevd','hetrd','hegvd','unmlq','ungtr','hbtrd']
       if petsc.precision == 'single':
         prefix = 'c'
       elif petsc.precision == '__float128':
@@ -73,7 +73,7 @@ class Lapack(package.Package):
       functions.append(prefix + i)
 
     # in this case, the real name represents both versions
-    namesubst = {'unghr':'orghr', 'heevr':'syevr', 'heevd':'syevd', 'hetrd':'sytrd', 'hegvd':'sygvd', 'unmlq':'ormlq', 'ungtr':'orgtr'}
+    namesubst = {'unghr':'orghr', 'heevr':'syevr', 'heevd':'syevd', 'hetrd':'sytrd', 'hegvd':'sygvd', 'unmlq':'ormlq', 'ungtr':'orgtr', 'hbtrd':'sbtrd'}
 
     # LAPACK functions which are always used in real version
     if petsc.precision == 'single':
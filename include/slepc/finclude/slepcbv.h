@@ -32,10 +32,12 @@
 #define BVOrthogRefineType PetscEnum
 #define BVOrthogBlockType  PetscEnum
 #define BVMatMultType      PetscEnum
+#define BVPrecision        PetscEnum
 
 #define BVMAT        'mat'
 #define BVSVEC       'svec'
 #define BVVECS       'vecs'
 #define BVCONTIGUOUS 'contiguous'
+#define BVMMAP       'mmap'
 
 #endif
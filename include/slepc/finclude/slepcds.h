@@ -31,6 +31,7 @@
 #define DSType      character*(80)
 #define DSStateType PetscEnum
 #define DSMatType   PetscEnum
+#define DSParallelType PetscEnum
 
 #define DSHEP       'hep'
 #define DSNHEP      'nhep'
@@ -34,6 +34,7 @@
 
 #define MFNKRYLOV      'krylov'
 #define MFNEXPOKIT     'expokit'
+#define MFNTAYLOR      'taylor'
 
 #endif
 
@@ -28,7 +28,7 @@
 PETSC_EXTERN PetscBool BVRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode BVRegisterAll(void);
 
-PETSC_EXTERN PetscLogEvent BV_Create,BV_Copy,BV_Mult,BV_MultVec,BV_MultInPlace,BV_Dot,BV_DotVec,BV_Orthogonalize,BV_OrthogonalizeVec,BV_Scale,BV_Norm,BV_NormVec,BV_SetRandom,BV_MatMult,BV_MatMultVec,BV_MatProject;
+PETSC_EXTERN PetscLogEvent BV_Create,BV_Copy,BV_Mult,BV_MultVec,BV_MultInPlace,BV_Dot,BV_DotVec,BV_Orthogonalize,BV_OrthogonalizeVec,BV_Scale,BV_Norm,BV_NormVec,BV_SetRandom,BV_MatMult,BV_MatMultVec,BV_MatProject,BV_AllocateWork;
 
 typedef struct _BVOps *BVOps;
 
@@ -79,6 +79,9 @@ struct _p_BV {
   Mat                matrix;       /* inner product matrix */
   PetscBool          indef;        /* matrix is indefinite */
   BVMatMultType      vmm;          /* version of matmult operation */
+  BVPrecision        precision;    /* precision of the stored entries */
+  PetscInt           nthreads;     /* number of threads used in local kernels */
+  PetscInt           mipbs;        /* rows per panel in BVMultInPlace (0 means automatic) */
 
   /*---------------------- Cached data and workspace -------------------*/
   Vec                Bx;           /* result of matrix times a vector x */
@@ -91,6 +94,8 @@ struct _p_BV {
   PetscObjectId      id[2];        /* object id of obtained vectors */
   PetscScalar        *h,*c;        /* orthogonalization coefficients */
   PetscReal          *omega;       /* signature matrix values for indefinite case */
+  PetscScalar        *gram;        /* Gram matrix of the columns, used in low-synchronization CGS */
+  PetscInt           gramk;        /* number of columns (including constraints) with valid Gram entries */
   Mat                B,C;          /* auxiliary dense matrices for matmult operation */
   PetscObjectId      Aid;          /* object id of matrix A of matmult operation */
   PetscBool          defersfo;     /* deferred call to setfromoptions */
@@ -234,6 +239,12 @@ PETSC_STATIC_INLINE PetscErrorCode BV_AllocateMatMult(BV bv,Mat A,PetscInt m)
   PetscFunctionReturn(0);
 }
 
+/*
+  BV_DiscardGram - Invalidate the Gram matrix cached for low-synchronization
+  Gram-Schmidt from column j onwards, because the columns have been modified
+*/
+#define BV_DiscardGram(bv,j) do { (bv)->gramk = PetscMin((bv)->gramk,(bv)->nc+(j)); } while (0)
+
 /*
   BVAvailableVec: First (0) or second (1) vector available for
   getcolumn operation (or -1 if both vectors already fetched).
@@ -262,10 +273,12 @@ PETSC_INTERN PetscErrorCode BVAllocateWork_Private(BV,PetscInt);
 
 PETSC_INTERN PetscErrorCode BVMult_BLAS_Private(BV,PetscInt,PetscInt,PetscInt,PetscInt,PetscScalar,const PetscScalar*,const PetscScalar*,PetscScalar,PetscScalar*);
 PETSC_INTERN PetscErrorCode BVMultVec_BLAS_Private(BV,PetscInt,PetscInt,PetscScalar,const PetscScalar*,const PetscScalar*,PetscScalar,PetscScalar*);
+PETSC_INTERN PetscInt BVMultInPlaceRows_Private(BV,PetscInt,PetscInt,PetscInt);
 PETSC_INTERN PetscErrorCode BVMultInPlace_BLAS_Private(BV,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscScalar*,const PetscScalar*,PetscBool);
 PETSC_INTERN PetscErrorCode BVMultInPlace_Vecs_Private(BV,PetscInt,PetscInt,PetscInt,Vec*,const PetscScalar*,PetscBool);
 PETSC_INTERN PetscErrorCode BVAXPY_BLAS_Private(BV,PetscInt,PetscInt,PetscScalar,const PetscScalar*,PetscScalar,PetscScalar*);
 PETSC_INTERN PetscErrorCode BVDot_BLAS_Private(BV,PetscInt,PetscInt,PetscInt,PetscInt,const PetscScalar*,const PetscScalar*,PetscScalar*,PetscBool);
+PETSC_INTERN PetscErrorCode BVDotHermitianReduce_Private(BV,PetscInt,const PetscScalar*,PetscScalar*,PetscScalar*,PetscInt,PetscBool);
 PETSC_INTERN PetscErrorCode BVDotVec_BLAS_Private(BV,PetscInt,PetscInt,const PetscScalar*,const PetscScalar*,PetscScalar*,PetscBool);
 PETSC_INTERN PetscErrorCode BVScale_BLAS_Private(BV,PetscInt,PetscScalar*,PetscScalar);
 PETSC_INTERN PetscErrorCode BVNorm_LAPACK_Private(BV,PetscInt,PetscInt,const PetscScalar*,NormType,PetscReal*,PetscBool);
@@ -27,7 +27,7 @@
 
 PETSC_EXTERN PetscBool DSRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode DSRegisterAll(void);
-PETSC_EXTERN PetscLogEvent DS_Solve,DS_Vectors,DS_Other;
+PETSC_EXTERN PetscLogEvent DS_Solve,DS_Vectors,DS_Other,DS_AllocateWork;
 PETSC_INTERN const char *DSMatName[];
 
 typedef struct _DSOps *DSOps;
@@ -37,12 +37,14 @@ struct _DSOps {
   PetscErrorCode (*view)(DS,PetscViewer);
   PetscErrorCode (*vectors)(DS,DSMatType,PetscInt*,PetscReal*);
   PetscErrorCode (*solve[DS_MAX_SOLVE])(DS,PetscScalar*,PetscScalar*);
+  PetscErrorCode (*pdsolve[DS_MAX_SOLVE])(DS,PetscScalar*,PetscScalar*);
   PetscErrorCode (*sort)(DS,PetscScalar*,PetscScalar*,PetscScalar*,PetscScalar*,PetscInt*);
   PetscErrorCode (*truncate)(DS,PetscInt);
   PetscErrorCode (*update)(DS);
   PetscErrorCode (*cond)(DS,PetscReal*);
   PetscErrorCode (*transharm)(DS,PetscScalar,PetscReal,PetscBool,PetscScalar*,PetscReal*);
   PetscErrorCode (*transrks)(DS,PetscScalar);
+  PetscErrorCode (*synchronize)(DS,PetscScalar*,PetscScalar*);
   PetscErrorCode (*destroy)(DS);
 };
 
@@ -51,6 +53,7 @@ struct _p_DS {
   /*------------------------- User parameters --------------------------*/
   DSStateType    state;              /* the current state */
   PetscInt       method;             /* identifies the variant to be used */
+  DSParallelType pmode;              /* parallel mode (redundant, synchronized, distributed) */
   PetscBool      compact;            /* whether the matrices are stored in compact form */
   PetscBool      refined;            /* get refined vectors instead of regular vectors */
   PetscBool      extrarow;           /* assume the matrix dimension is (n+1) x n */
@@ -68,13 +71,27 @@ struct _p_DS {
   PetscReal      *rmat[DS_NUM_MAT];  /* the matrices (real) */
   Mat            omat[DS_NUM_MAT];   /* the matrices (PETSc object) */
   PetscInt       *perm;              /* permutation */
+  PetscBool      arrow;              /* the raw matrix has the structure of DS_STATE_ARROW */
   void           *data;              /* placeholder for solver-specific stuff */
   PetscScalar    *work;
   PetscReal      *rwork;
   PetscBLASInt   *iwork;
   PetscInt       lwork,lrwork,liwork;
+  PetscBool      packed;             /* the matrices are in the packed storage of a batch */
+  PetscScalar    *bwork;             /* packed storage of the matrices of a batch, see DSSolveBatch() */
+  PetscReal      *brwork;
+  PetscInt       lbwork,lbrwork;
 };
 
+/*
+   Original location of the matrices of a DS while they are in packed storage
+*/
+typedef struct {
+  PetscScalar    *mat[DS_NUM_MAT];
+  PetscReal      *rmat[DS_NUM_MAT];
+  PetscInt       ld;
+} DSPacked_Private;
+
 /*
     Macros to test valid DS arguments
 */
@@ -116,11 +133,17 @@ PETSC_STATIC_INLINE PetscErrorCode DSAllocateMat_Private(DS ds,DSMatType m) {ret
 PETSC_STATIC_INLINE PetscErrorCode DSAllocateMatReal_Private(DS ds,DSMatType m) {return DSAllocateMatrix_Private(ds,m,PETSC_TRUE);}
 PETSC_INTERN PetscErrorCode DSAllocateWork_Private(DS,PetscInt,PetscInt,PetscInt);
 PETSC_INTERN PetscErrorCode DSSortEigenvalues_Private(DS,PetscScalar*,PetscScalar*,PetscInt*,PetscBool);
+PETSC_INTERN PetscErrorCode DSSortEigenvaluesPartial_Private(DS,PetscScalar*,PetscScalar*,PetscInt*,PetscBool,PetscInt);
 PETSC_INTERN PetscErrorCode DSSortEigenvaluesReal_Private(DS,PetscReal*,PetscInt*);
 PETSC_INTERN PetscErrorCode DSPermuteColumns_Private(DS,PetscInt,PetscInt,DSMatType,PetscInt*);
 PETSC_INTERN PetscErrorCode DSPermuteRows_Private(DS,PetscInt,PetscInt,DSMatType,PetscInt*);
 PETSC_INTERN PetscErrorCode DSPermuteBoth_Private(DS,PetscInt,PetscInt,DSMatType,DSMatType,PetscInt*);
 PETSC_INTERN PetscErrorCode DSCopyMatrix_Private(DS,DSMatType,DSMatType);
+PETSC_INTERN PetscErrorCode DSSynchronize_Private(DS,DSMatType,PetscScalar*,PetscScalar*);
+PETSC_INTERN PetscErrorCode DSSynchronizeError_Private(DS,PetscErrorCode);
+PETSC_INTERN PetscErrorCode DSPackedSize_Private(DS,PetscInt*,PetscInt*);
+PETSC_INTERN PetscErrorCode DSPack_Private(DS,PetscScalar*,PetscReal*,DSPacked_Private*);
+PETSC_INTERN PetscErrorCode DSUnpack_Private(DS,DSPacked_Private*);
 
 PETSC_INTERN PetscErrorCode DSGHIEPOrthogEigenv(DS,DSMatType,PetscScalar*,PetscScalar*,PetscBool);
 PETSC_INTERN PetscErrorCode DSGHIEPComplexEigs(DS,PetscInt,PetscInt,PetscScalar*,PetscScalar*);
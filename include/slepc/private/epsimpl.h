@@ -196,9 +196,13 @@ PETSC_INTERN PetscErrorCode EPSGetStartVector(EPS,PetscInt,PetscBool*);
 /* Private functions of the solver implementations */
 
 PETSC_INTERN PetscErrorCode EPSBasicArnoldi(EPS,PetscBool,PetscScalar*,PetscInt,PetscInt,PetscInt*,PetscReal*,PetscBool*);
+PETSC_INTERN PetscErrorCode EPSPipelinedArnoldi(EPS,PetscScalar*,PetscInt,PetscInt,PetscInt*,PetscReal*,PetscBool*);
+PETSC_INTERN PetscErrorCode EPSSStepArnoldi(EPS,PetscInt,PetscScalar*,PetscReal,PetscScalar*,PetscInt,PetscInt,PetscInt*,PetscReal*,PetscBool*);
+PETSC_INTERN PetscErrorCode EPSBlockArnoldi(EPS,PetscInt,Mat,BV,PetscScalar*,PetscInt,PetscInt,PetscInt);
 PETSC_INTERN PetscErrorCode EPSDelayedArnoldi(EPS,PetscScalar*,PetscInt,PetscInt,PetscInt*,PetscReal*,PetscBool*);
 PETSC_INTERN PetscErrorCode EPSDelayedArnoldi1(EPS,PetscScalar*,PetscInt,PetscInt,PetscInt*,PetscReal*,PetscBool*);
 PETSC_INTERN PetscErrorCode EPSKrylovConvergence(EPS,PetscBool,PetscInt,PetscInt,PetscReal,PetscReal,PetscInt*);
+PETSC_INTERN PetscErrorCode EPSBlockKrylovConvergence(EPS,PetscBool,PetscInt,PetscInt,PetscInt,PetscScalar*,PetscInt,PetscInt*);
 PETSC_INTERN PetscErrorCode EPSFullLanczos(EPS,PetscReal*,PetscReal*,PetscInt,PetscInt*,PetscBool*);
 PETSC_INTERN PetscErrorCode EPSPseudoLanczos(EPS,PetscReal*,PetscReal*,PetscReal*,PetscInt,PetscInt*,PetscBool*,PetscBool*,PetscReal*,Vec);
 PETSC_INTERN PetscErrorCode EPSBuildBalance_Krylov(EPS);
@@ -27,16 +27,20 @@
 
 PETSC_EXTERN PetscBool FNRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode FNRegisterAll(void);
-PETSC_EXTERN PetscLogEvent FN_Evaluate;
+PETSC_EXTERN PetscLogEvent FN_Evaluate,FN_AllocateWork;
+
+#define FN_MAX_SOLVE 6
 
 typedef struct _FNOps *FNOps;
 
 struct _FNOps {
   PetscErrorCode (*evaluatefunction)(FN,PetscScalar,PetscScalar*);
   PetscErrorCode (*evaluatederivative)(FN,PetscScalar,PetscScalar*);
-  PetscErrorCode (*evaluatefunctionmat)(FN,Mat,Mat);
+  PetscErrorCode (*evaluatefunctionarray)(FN,PetscInt,PetscScalar*,PetscScalar*);
+  PetscErrorCode (*evaluatederivativearray)(FN,PetscInt,PetscScalar*,PetscScalar*);
+  PetscErrorCode (*evaluatefunctionmat[FN_MAX_SOLVE])(FN,Mat,Mat);
   PetscErrorCode (*evaluatefunctionmatsym)(FN,Mat,Mat);
-  PetscErrorCode (*evaluatefunctionmatvec)(FN,Mat,Vec);
+  PetscErrorCode (*evaluatefunctionmatvec[FN_MAX_SOLVE])(FN,Mat,Vec);
   PetscErrorCode (*evaluatefunctionmatvecsym)(FN,Mat,Vec);
   PetscErrorCode (*setfromoptions)(PetscOptionItems*,FN);
   PetscErrorCode (*view)(FN,PetscViewer);
@@ -46,16 +50,41 @@ struct _FNOps {
 
 #define FN_MAX_W 6
 
+/*
+   Schur decomposition alpha*A = Q*T*Q' of the argument of a matrix function,
+   kept when the cache is enabled with FNSetSchurCache()
+*/
+typedef struct {
+  PetscObjectId    id;        /* identity of the matrix A */
+  PetscObjectState state;     /* state of A when it was decomposed */
+  PetscInt         n;         /* dimension of A, zero if nothing is stored */
+  PetscInt         nalloc;    /* allocated dimension */
+  PetscScalar      alpha;     /* scaling factor of A in the stored decomposition */
+  PetscScalar      *T;        /* Schur form */
+  PetscScalar      *Q;        /* Schur vectors */
+  PetscScalar      *wr;       /* eigenvalues (real part in real scalars) */
+  PetscReal        *wi;       /* imaginary part of the eigenvalues in real scalars */
+  PetscInt         nhit;      /* number of times the stored decomposition was reused */
+} FN_SCHUR;
+
 struct _p_FN {
   PETSCHEADER(struct _FNOps);
   /*------------------------- User parameters --------------------------*/
   PetscScalar alpha;          /* inner scaling (argument) */
   PetscScalar beta;           /* outer scaling (result) */
+  PetscInt    method;         /* the method to compute matrix functions */
 
   /*---------------------- Cached data and workspace -------------------*/
   Mat         W[FN_MAX_W];    /* workspace matrices */
   PetscInt    nw;             /* number of allocated W matrices */
   PetscInt    cw;             /* current W matrix */
+  PetscScalar  *work;         /* workspace for matrix functions */
+  PetscReal    *rwork;
+  PetscBLASInt *iwork;
+  PetscInt     lwork,lrwork,liwork;
+  FN_SCHUR     *schur;        /* cached Schur decomposition, NULL if not enabled */
+  PetscObjectId    argid;     /* identity of the matrix being evaluated */
+  PetscObjectState argstate;  /* state of the matrix being evaluated */
   void        *data;
 };
 
@@ -85,8 +114,10 @@ PETSC_STATIC_INLINE PetscErrorCode FN_AllocateWorkMat(FN fn,Mat A,Mat *M)
     }
   }
   if (create) {
+    ierr = PetscLogEventBegin(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
     ierr = MatDuplicate(A,MAT_COPY_VALUES,&fn->W[fn->cw]);CHKERRQ(ierr);
     ierr = PetscLogObjectParent((PetscObject)fn,(PetscObject)fn->W[fn->cw]);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
   } else {
     ierr = MatCopy(A,fn->W[fn->cw],SAME_NONZERO_PATTERN);CHKERRQ(ierr);
   }
@@ -108,7 +139,14 @@ PETSC_STATIC_INLINE PetscErrorCode FN_FreeWorkMat(FN fn,Mat *M)
   PetscFunctionReturn(0);
 }
 
+PETSC_INTERN PetscErrorCode FNAllocateWork_Private(FN,PetscInt,PetscInt,PetscInt);
+PETSC_INTERN PetscErrorCode FNSchurDecomposition_Private(FN,PetscBLASInt,PetscScalar*,PetscBLASInt,PetscScalar*,PetscScalar*,PetscReal*,PetscScalar*,PetscReal*);
+PETSC_EXTERN PetscErrorCode FNExpTaylorParameters_Private(PetscReal,PetscInt*,PetscInt*);
+PETSC_EXTERN PetscErrorCode FNExpTaylorStep_Private(PetscScalar,PetscInt,Mat,Vec,Vec*,PetscReal*);
+
 PETSC_INTERN PetscErrorCode SlepcMatDenseSqrt(PetscBLASInt,PetscScalar*,PetscBLASInt);
-PETSC_INTERN PetscErrorCode SlepcSchurParlettSqrt(PetscBLASInt,PetscScalar*,PetscBLASInt,PetscBool);
+PETSC_INTERN PetscErrorCode SlepcSchurParlettSqrt(FN,PetscBLASInt,PetscScalar*,PetscBLASInt,PetscBool);
+PETSC_INTERN PetscErrorCode SlepcSqrtmDenmanBeavers(FN,PetscBLASInt,PetscScalar*,PetscBLASInt,PetscBool);
+PETSC_INTERN PetscErrorCode SlepcSqrtmNewtonSchulz(FN,PetscBLASInt,PetscScalar*,PetscBLASInt,PetscBool);
 
 #endif
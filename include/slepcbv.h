@@ -48,6 +48,7 @@ typedef const char* BVType;
 #define BVSVEC       "svec"
 #define BVVECS       "vecs"
 #define BVCONTIGUOUS "contiguous"
+#define BVMMAP       "mmap"
 
 /* Logging support */
 PETSC_EXTERN PetscClassId BV_CLASSID;
@@ -61,7 +62,8 @@ PETSC_EXTERN PetscClassId BV_CLASSID;
 .seealso: BVSetOrthogonalization(), BVGetOrthogonalization(), BVOrthogonalizeColumn(), BVOrthogRefineType
 E*/
 typedef enum { BV_ORTHOG_CGS,
-               BV_ORTHOG_MGS } BVOrthogType;
+               BV_ORTHOG_MGS,
+               BV_ORTHOG_CGS_LOWSYNC } BVOrthogType;
 PETSC_EXTERN const char *BVOrthogTypes[];
 
 /*E
@@ -87,9 +89,23 @@ PETSC_EXTERN const char *BVOrthogRefineTypes[];
 E*/
 typedef enum { BV_ORTHOG_BLOCK_GS,
                BV_ORTHOG_BLOCK_CHOL,
-               BV_ORTHOG_BLOCK_TSQR } BVOrthogBlockType;
+               BV_ORTHOG_BLOCK_TSQR,
+               BV_ORTHOG_BLOCK_CHOLQR2,
+               BV_ORTHOG_BLOCK_SCHOLQR3 } BVOrthogBlockType;
 PETSC_EXTERN const char *BVOrthogBlockTypes[];
 
+/*E
+    BVPrecision - Determines the floating-point precision used to store
+    the entries of the basis vectors
+
+    Level: advanced
+
+.seealso: BVSetPrecision(), BVGetPrecision()
+E*/
+typedef enum { BV_PRECISION_DEFAULT,
+               BV_PRECISION_SINGLE } BVPrecision;
+PETSC_EXTERN const char *BVPrecisions[];
+
 /*E
     BVMatMultType - Determines how to perform the BVMatMult() operation:
        BV_MATMULT_VECS: perform a matrix-vector multiply per each column;
@@ -187,6 +203,12 @@ PETSC_EXTERN PetscErrorCode BVOrthonormalizeColumn(BV,PetscInt,PetscBool,PetscRe
 PETSC_EXTERN PetscErrorCode BVOrthogonalizeSomeColumn(BV,PetscInt,PetscBool*,PetscScalar*,PetscReal*,PetscBool*);
 PETSC_EXTERN PetscErrorCode BVSetMatMultMethod(BV,BVMatMultType);
 PETSC_EXTERN PetscErrorCode BVGetMatMultMethod(BV,BVMatMultType*);
+PETSC_EXTERN PetscErrorCode BVSetPrecision(BV,BVPrecision);
+PETSC_EXTERN PetscErrorCode BVGetPrecision(BV,BVPrecision*);
+PETSC_EXTERN PetscErrorCode BVSetNumThreads(BV,PetscInt);
+PETSC_EXTERN PetscErrorCode BVGetNumThreads(BV,PetscInt*);
+PETSC_EXTERN PetscErrorCode BVSetMultBlockSize(BV,PetscInt);
+PETSC_EXTERN PetscErrorCode BVGetMultBlockSize(BV,PetscInt*);
 
 PETSC_EXTERN PetscErrorCode BVSetOptionsPrefix(BV,const char*);
 PETSC_EXTERN PetscErrorCode BVAppendOptionsPrefix(BV,const char*);
@@ -23,6 +23,7 @@
 #define __SLEPCDS_H
 #include <slepcsc.h>
 #include <slepcfn.h>
+#include <slepcrg.h>
 
 #define DS_MAX_SOLVE 6
 
@@ -62,6 +63,12 @@ PETSC_EXTERN PetscClassId DS_CLASSID;
 /*E
     DSStateType - Indicates in which state the direct solver is
 
+    Notes:
+    DS_STATE_ARROW is not a separate state but a hint for DSSetState(): the
+    matrix is raw, but the leading block l:k-1 is already in (quasi-)triangular
+    form and the only entries below the Hessenberg structure are those of
+    row k, as happens after a Krylov-Schur restart.
+
     Level: advanced
 
 .seealso: DSSetState()
@@ -69,9 +76,22 @@ E*/
 typedef enum { DS_STATE_RAW,
                DS_STATE_INTERMEDIATE,
                DS_STATE_CONDENSED,
-               DS_STATE_TRUNCATED } DSStateType;
+               DS_STATE_TRUNCATED,
+               DS_STATE_ARROW } DSStateType;
 PETSC_EXTERN const char *DSStateTypes[];
 
+/*E
+    DSParallelType - Indicates the parallel mode that the direct solver will use
+
+    Level: advanced
+
+.seealso: DSSetParallel()
+E*/
+typedef enum { DS_PARALLEL_REDUNDANT,
+               DS_PARALLEL_SYNCHRONIZED,
+               DS_PARALLEL_DISTRIBUTED } DSParallelType;
+PETSC_EXTERN const char *DSParallelTypes[];
+
 /*E
     DSMatType - Used to refer to one of the matrices stored internally in DS
 
@@ -154,6 +174,8 @@ PETSC_EXTERN PetscErrorCode DSTruncate(DS,PetscInt);
 PETSC_EXTERN PetscErrorCode DSSetIdentity(DS,DSMatType);
 PETSC_EXTERN PetscErrorCode DSSetMethod(DS,PetscInt);
 PETSC_EXTERN PetscErrorCode DSGetMethod(DS,PetscInt*);
+PETSC_EXTERN PetscErrorCode DSSetParallel(DS,DSParallelType);
+PETSC_EXTERN PetscErrorCode DSGetParallel(DS,DSParallelType*);
 PETSC_EXTERN PetscErrorCode DSSetCompact(DS,PetscBool);
 PETSC_EXTERN PetscErrorCode DSGetCompact(DS,PetscBool*);
 PETSC_EXTERN PetscErrorCode DSSetExtraRow(DS,PetscBool);
@@ -168,6 +190,7 @@ PETSC_EXTERN PetscErrorCode DSGetArrayReal(DS,DSMatType,PetscReal*[]);
 PETSC_EXTERN PetscErrorCode DSRestoreArrayReal(DS,DSMatType,PetscReal*[]);
 PETSC_EXTERN PetscErrorCode DSVectors(DS,DSMatType,PetscInt*,PetscReal*);
 PETSC_EXTERN PetscErrorCode DSSolve(DS,PetscScalar*,PetscScalar*);
+PETSC_EXTERN PetscErrorCode DSSolveBatch(PetscInt,DS[],PetscScalar*,PetscScalar*);
 PETSC_EXTERN PetscErrorCode DSSort(DS,PetscScalar*,PetscScalar*,PetscScalar*,PetscScalar*,PetscInt*);
 PETSC_EXTERN PetscErrorCode DSCopyMat(DS,DSMatType,PetscInt,PetscInt,Mat,PetscInt,PetscInt,PetscInt,PetscInt,PetscBool);
 PETSC_EXTERN PetscErrorCode DSSetSlepcSC(DS,SlepcSC);
@@ -187,6 +210,8 @@ PETSC_EXTERN PetscErrorCode DSPEPGetDegree(DS,PetscInt*);
 PETSC_EXTERN PetscErrorCode DSNEPSetFN(DS,PetscInt,FN*);
 PETSC_EXTERN PetscErrorCode DSNEPGetFN(DS,PetscInt,FN*);
 PETSC_EXTERN PetscErrorCode DSNEPGetNumFN(DS,PetscInt*);
+PETSC_EXTERN PetscErrorCode DSNEPSetRG(DS,RG);
+PETSC_EXTERN PetscErrorCode DSNEPGetRG(DS,RG*);
 
 PETSC_EXTERN PetscFunctionList DSList;
 PETSC_EXTERN PetscErrorCode DSRegister(const char[],PetscErrorCode(*)(DS));
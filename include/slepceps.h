@@ -318,6 +318,12 @@ PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetRestart(EPS,PetscReal);
 PETSC_EXTERN PetscErrorCode EPSKrylovSchurGetRestart(EPS,PetscReal*);
 PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetLocking(EPS,PetscBool);
 PETSC_EXTERN PetscErrorCode EPSKrylovSchurGetLocking(EPS,PetscBool*);
+PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetPipelined(EPS,PetscBool);
+PETSC_EXTERN PetscErrorCode EPSKrylovSchurGetPipelined(EPS,PetscBool*);
+PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetSStep(EPS,PetscInt);
+PETSC_EXTERN PetscErrorCode EPSKrylovSchurGetSStep(EPS,PetscInt*);
+PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetBlockSize(EPS,PetscInt);
+PETSC_EXTERN PetscErrorCode EPSKrylovSchurGetBlockSize(EPS,PetscInt*);
 PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetPartitions(EPS,PetscInt);
 PETSC_EXTERN PetscErrorCode EPSKrylovSchurGetPartitions(EPS,PetscInt*);
 PETSC_EXTERN PetscErrorCode EPSKrylovSchurSetDetectZeros(EPS,PetscBool);
@@ -77,11 +77,18 @@ PETSC_EXTERN PetscErrorCode FNDuplicate(FN,MPI_Comm,FN*);
 
 PETSC_EXTERN PetscErrorCode FNSetScale(FN,PetscScalar,PetscScalar);
 PETSC_EXTERN PetscErrorCode FNGetScale(FN,PetscScalar*,PetscScalar*);
+PETSC_EXTERN PetscErrorCode FNSetMethod(FN,PetscInt);
+PETSC_EXTERN PetscErrorCode FNGetMethod(FN,PetscInt*);
+PETSC_EXTERN PetscErrorCode FNSetSchurCache(FN,PetscBool);
+PETSC_EXTERN PetscErrorCode FNGetSchurCache(FN,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode FNEvaluateFunction(FN,PetscScalar,PetscScalar*);
 PETSC_EXTERN PetscErrorCode FNEvaluateDerivative(FN,PetscScalar,PetscScalar*);
+PETSC_EXTERN PetscErrorCode FNEvaluateFunctionArray(FN,PetscInt,PetscScalar*,PetscScalar*);
+PETSC_EXTERN PetscErrorCode FNEvaluateDerivativeArray(FN,PetscInt,PetscScalar*,PetscScalar*);
 PETSC_EXTERN PetscErrorCode FNEvaluateFunctionMat(FN,Mat,Mat);
 PETSC_EXTERN PetscErrorCode FNEvaluateFunctionMatVec(FN,Mat,Vec);
+PETSC_EXTERN PetscErrorCode FNEvaluateFunctionMatMultiple(PetscInt,FN*,Mat,Mat*);
 
 PETSC_EXTERN PetscFunctionList FNList;
 PETSC_EXTERN PetscErrorCode FNRegister(const char[],PetscErrorCode(*)(FN));
@@ -98,5 +105,7 @@ PETSC_EXTERN PetscErrorCode FNCombineGetChildren(FN,FNCombineType*,FN*,FN*);
 
 PETSC_EXTERN PetscErrorCode FNPhiSetIndex(FN,PetscInt);
 PETSC_EXTERN PetscErrorCode FNPhiGetIndex(FN,PetscInt*);
+PETSC_EXTERN PetscErrorCode FNPhiEvaluateFunctionMatAll(FN,Mat,Mat*);
+PETSC_EXTERN PetscErrorCode FNPhiEvaluateFunctionMatVecAll(FN,Mat,Vec*);
 
 #endif
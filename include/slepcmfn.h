@@ -47,6 +47,7 @@ J*/
 typedef const char* MFNType;
 #define MFNKRYLOV   "krylov"
 #define MFNEXPOKIT  "expokit"
+#define MFNTAYLOR   "taylor"
 
 /* Logging support */
 PETSC_EXTERN PetscClassId MFN_CLASSID;
@@ -147,6 +147,7 @@ typedef struct _dvdDashboard {
 
   Mat       H,G;               /* projected problem matrices */
   Mat       auxM;              /* auxiliary dense matrix */
+  PetscScalar *auxS;           /* auxiliary scalars, of size 2*ncv */
   PetscInt  size_MT;           /* rows in MT */
 
   PetscInt  V_tra_s;
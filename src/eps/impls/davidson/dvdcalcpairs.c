@@ -59,6 +59,7 @@ static PetscErrorCode dvd_calcpairs_qz_d(dvdDashboard *d)
   ierr = MatDestroy(&d->auxM);CHKERRQ(ierr);
   ierr = SlepcVecPoolDestroy(&d->auxV);CHKERRQ(ierr);
   ierr = PetscFree(d->nBds);CHKERRQ(ierr);
+  ierr = PetscFree(d->auxS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -209,17 +210,15 @@ PETSC_STATIC_INLINE PetscErrorCode dvd_calcpairs_updateBV0_gen(dvdDashboard *d,B
 {
   PetscErrorCode ierr;
   PetscInt       l,k,n;
-  Mat            auxM;
+  Mat            auxM = d->auxM;
 
   PetscFunctionBegin;
   ierr = BVGetActiveColumns(d->eps->V,&l,&k);CHKERRQ(ierr);
-  ierr = MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&auxM);CHKERRQ(ierr);
   ierr = MatZeroEntries(auxM);CHKERRQ(ierr);
   ierr = DSGetDimensions(d->eps->ds,&n,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
   if (k-l!=n) SETERRQ(PETSC_COMM_SELF,1, "Consistency broken");
   ierr = DSCopyMat(d->eps->ds,mat,0,0,auxM,l,l,n,d->V_tra_e,PETSC_TRUE);CHKERRQ(ierr);
   ierr = BVMultInPlace(bv,auxM,l,l+d->V_tra_e);CHKERRQ(ierr);
-  ierr = MatDestroy(&auxM);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -391,8 +390,8 @@ static PetscErrorCode dvd_calcpairs_selectPairs(dvdDashboard *d,PetscInt n)
   if (n <= 0) PetscFunctionReturn(0);
   /* Put the best n pairs at the beginning. Useful for restarting */
   if (d->eps->arbitrary || d->calcpairs_eig_backtrans) {
-    ierr = PetscMalloc1(nV,&rr);CHKERRQ(ierr);
-    ierr = PetscMalloc1(nV,&ri);CHKERRQ(ierr);
+    rr = d->auxS;
+    ri = d->auxS+d->eps->ncv;
     ierr = dvd_calcpairs_apply_arbitrary(d,0,nV,rr,ri);CHKERRQ(ierr);
   } else {
     rr = d->eigr;
@@ -414,10 +413,6 @@ static PetscErrorCode dvd_calcpairs_selectPairs(dvdDashboard *d,PetscInt n)
   if (d->calcpairs_eigs_trans) {
     ierr = d->calcpairs_eigs_trans(d);CHKERRQ(ierr);
   }
-  if (d->eps->arbitrary || d->calcpairs_eig_backtrans) {
-    ierr = PetscFree(rr);CHKERRQ(ierr);
-    ierr = PetscFree(ri);CHKERRQ(ierr);
-  }
   PetscFunctionReturn(0);
 }
 
@@ -589,6 +584,7 @@ PetscErrorCode dvd_calcpairs_qz(dvdDashboard *d,dvdBlackboard *b,PetscBool borth
       ierr = PetscMalloc1(d->eps->ncv,&d->nBds);CHKERRQ(ierr);
     } else d->nBds = NULL;
     ierr = MatCreateSeqDense(PETSC_COMM_SELF,d->eps->ncv,d->eps->ncv,NULL,&d->auxM);CHKERRQ(ierr);
+    ierr = PetscMalloc1(2*d->eps->ncv,&d->auxS);CHKERRQ(ierr);
 
     ierr = EPSDavidsonFLAdd(&d->startList,dvd_calcpairs_qz_start);CHKERRQ(ierr);
     ierr = EPSDavidsonFLAdd(&d->endList,EPSXDComputeDSConv);CHKERRQ(ierr);
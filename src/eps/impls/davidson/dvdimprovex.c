@@ -52,6 +52,7 @@ typedef struct {
   PetscInt     size_cX;            /* last value of d->size_cX */
   PetscInt     old_size_X;         /* last number of improved vectors */
   PetscBLASInt *iXKZPivots;        /* array of pivots */
+  PetscScalar  *h;                 /* workspace for the projectors */
 } dvdImprovex_jd;
 
 /*
@@ -68,7 +69,7 @@ static PetscErrorCode dvd_improvex_apply_proj(dvdDashboard *d,Vec *V,PetscInt cV
   PetscErrorCode ierr;
   dvdImprovex_jd *data = (dvdImprovex_jd*)d->improveX_data;
   PetscInt       i,ldh,k,l;
-  PetscScalar    *h;
+  PetscScalar    *h=data->h;
   PetscBLASInt   cV_,n,info,ld;
 #if defined(PETSC_USE_COMPLEX)
   PetscInt       j;
@@ -78,7 +79,6 @@ static PetscErrorCode dvd_improvex_apply_proj(dvdDashboard *d,Vec *V,PetscInt cV
   if (cV > 2) SETERRQ(PETSC_COMM_SELF,1,"Consistency broken");
 
   /* h <- X'*V */
-  ierr = PetscMalloc1(data->size_iXKZ*cV,&h);CHKERRQ(ierr);
   ldh = data->size_iXKZ;
   ierr = BVGetActiveColumns(data->U,&l,&k);CHKERRQ(ierr);
   if (ldh!=k) SETERRQ(PETSC_COMM_SELF,1,"Consistency broken");
@@ -107,7 +107,6 @@ static PetscErrorCode dvd_improvex_apply_proj(dvdDashboard *d,Vec *V,PetscInt cV
     ierr = BVMultVec(data->KZ,-1.0,1.0,V[i],&h[ldh*i]);CHKERRQ(ierr);
   }
   ierr = BVSetActiveColumns(data->KZ,l,k);CHKERRQ(ierr);
-  ierr = PetscFree(h);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 #endif
 }
@@ -127,7 +126,7 @@ static PetscErrorCode dvd_improvex_applytrans_proj(dvdDashboard *d,Vec *V,PetscI
   PetscErrorCode ierr;
   dvdImprovex_jd *data = (dvdImprovex_jd*)d->improveX_data;
   PetscInt       i,ldh,k,l;
-  PetscScalar    *h;
+  PetscScalar    *h=data->h;
   PetscBLASInt   cV_, n, info, ld;
 #if defined(PETSC_USE_COMPLEX)
   PetscInt       j;
@@ -137,7 +136,6 @@ static PetscErrorCode dvd_improvex_applytrans_proj(dvdDashboard *d,Vec *V,PetscI
   if (cV > 2) SETERRQ(PETSC_COMM_SELF,1,"Consistency broken");
 
   /* h <- KZ'*V */
-  ierr = PetscMalloc1(data->size_iXKZ*cV,&h);CHKERRQ(ierr);
   ldh = data->size_iXKZ;
   ierr = BVGetActiveColumns(data->U,&l,&k);CHKERRQ(ierr);
   if (ldh!=k) SETERRQ(PETSC_COMM_SELF,1,"Consistency broken");
@@ -166,7 +164,6 @@ static PetscErrorCode dvd_improvex_applytrans_proj(dvdDashboard *d,Vec *V,PetscI
     ierr = BVMultVec(data->U,-1.0,1.0,V[i],&h[ldh*i]);CHKERRQ(ierr);
   }
   ierr = BVSetActiveColumns(data->U,l,k);CHKERRQ(ierr);
-  ierr = PetscFree(h);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 #endif
 }
@@ -197,6 +194,7 @@ static PetscErrorCode dvd_improvex_jd_d(dvdDashboard *d)
   ierr = PetscFree(data->XKZ);CHKERRQ(ierr);
   ierr = PetscFree(data->iXKZ);CHKERRQ(ierr);
   ierr = PetscFree(data->iXKZPivots);CHKERRQ(ierr);
+  ierr = PetscFree(data->h);CHKERRQ(ierr);
   ierr = BVDestroy(&data->KZ);CHKERRQ(ierr);
   ierr = BVDestroy(&data->U);CHKERRQ(ierr);
   ierr = PetscFree(data);CHKERRQ(ierr);
@@ -834,6 +832,7 @@ PetscErrorCode dvd_improvex_jd(dvdDashboard *d,dvdBlackboard *b,KSP ksp,PetscInt
     ierr = PetscMalloc1(size_P*size_P,&data->XKZ);CHKERRQ(ierr);
     ierr = PetscMalloc1(size_P*size_P,&data->iXKZ);CHKERRQ(ierr);
     ierr = PetscMalloc1(size_P,&data->iXKZPivots);CHKERRQ(ierr);
+    ierr = PetscMalloc1(2*size_P,&data->h);CHKERRQ(ierr);
     data->ldXKZ = size_P;
     data->size_X = b->max_size_X;
     d->improveX_data = data;
@@ -73,6 +73,405 @@ PetscErrorCode EPSBasicArnoldi(EPS eps,PetscBool trans,PetscScalar *H,PetscInt l
   PetscFunctionReturn(0);
 }
 
+/*
+   EPSPipelinedArnoldi - This function is equivalent to EPSBasicArnoldi but
+   hides the latency of the global reductions. At step j, the reductions
+   needed to orthogonalize w = OP*v_j (a single classical Gram-Schmidt pass,
+   with the norm obtained from the Pythagorean identity) are started in
+   nonblocking mode, and the operator is applied to w while they are in
+   flight. The auxiliary vector OP*v_{j+1} is then recovered by the recurrence
+
+             OP*v_{j+1} = (OP*w - OP*V_j*h) / beta,   OP*V_j = V_{j+1}*H_j,
+
+   so that only one operator application per step is needed. If the
+   orthogonalization needs refinement (according to the BV settings), then
+   an additional non-overlapped pass is done for that step.
+
+   The columns of H before k must contain the Krylov relation obtained at
+   restart. Constraints (deflation space) are not supported.
+*/
+PetscErrorCode EPSPipelinedArnoldi(EPS eps,PetscScalar *H,PetscInt ldh,PetscInt k,PetscInt *M,PetscReal *beta,PetscBool *breakdown)
+{
+  PetscErrorCode     ierr;
+  PetscInt           i,j,r,rmax,m = *M;
+  PetscScalar        *h,*g,*h2;
+  PetscReal          nrm,beta2,eta;
+  PetscBool          lindep;
+  BVOrthogRefineType refine;
+  Vec                z,t,w,vj;
+  MPI_Comm           comm;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)eps->V,&comm);CHKERRQ(ierr);
+  ierr = BVGetOrthogonalization(eps->V,NULL,&refine,&eta,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(m+1,&g,m+1,&h2);CHKERRQ(ierr);
+  ierr = BVCreateVec(eps->V,&z);CHKERRQ(ierr);
+  ierr = BVCreateVec(eps->V,&t);CHKERRQ(ierr);
+  *breakdown = PETSC_FALSE;
+
+  /* z = OP*v_k, this is the only operator application not overlapped */
+  ierr = BVSetActiveColumns(eps->V,0,m);CHKERRQ(ierr);
+  ierr = BVGetColumn(eps->V,k,&vj);CHKERRQ(ierr);
+  ierr = STApply(eps->st,vj,z);CHKERRQ(ierr);
+  ierr = BVRestoreColumn(eps->V,k,&vj);CHKERRQ(ierr);
+
+  for (j=k;j<m;j++) {
+    h = H+ldh*j;
+    ierr = BVInsertVec(eps->V,j+1,z);CHKERRQ(ierr);
+    ierr = BVDotColumnBegin(eps->V,j+1,h);CHKERRQ(ierr);
+    ierr = BVNormColumnBegin(eps->V,j+1,NORM_2,&nrm);CHKERRQ(ierr);
+    ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+    if (j<m-1) {  /* t = OP*z, overlapped with the reductions */
+      ierr = STApply(eps->st,z,t);CHKERRQ(ierr);
+    }
+    ierr = BVDotColumnEnd(eps->V,j+1,h);CHKERRQ(ierr);
+    ierr = BVNormColumnEnd(eps->V,j+1,NORM_2,&nrm);CHKERRQ(ierr);
+
+    ierr = BVMultColumn(eps->V,-1.0,1.0,j+1,h);CHKERRQ(ierr);
+    beta2 = nrm*nrm;
+    for (i=0;i<=j;i++) beta2 -= PetscRealPart(h[i]*PetscConj(h[i]));
+    lindep = PETSC_FALSE;
+    if (refine==BV_ORTHOG_REFINE_ALWAYS || beta2<=0.0 || (refine==BV_ORTHOG_REFINE_IFNEEDED && beta2<eta*eta*nrm*nrm)) {
+      ierr = BVOrthogonalizeColumn(eps->V,j+1,h2,beta,&lindep);CHKERRQ(ierr);
+      for (i=0;i<=j;i++) h[i] += h2[i];
+    } else *beta = PetscSqrtReal(beta2);
+    h[j+1] = *beta;
+    if (lindep || *beta==0.0) {
+      *breakdown = PETSC_TRUE;
+      *M = j+1;
+      break;
+    }
+    ierr = BVScaleColumn(eps->V,j+1,1.0/(*beta));CHKERRQ(ierr);
+
+    if (j<m-1) {  /* recover z = OP*v_{j+1} */
+      for (r=0;r<=j;r++) g[r] = 0.0;
+      for (i=0;i<j;i++) {
+        rmax = PetscMin(j,PetscMax(i+1,k));
+        for (r=0;r<=rmax;r++) g[r] += H[r+ldh*i]*h[i];
+      }
+      ierr = VecAXPY(t,-h[j],z);CHKERRQ(ierr);
+      ierr = BVSetActiveColumns(eps->V,0,j+1);CHKERRQ(ierr);
+      ierr = BVMultVec(eps->V,-1.0,1.0,t,g);CHKERRQ(ierr);
+      ierr = BVSetActiveColumns(eps->V,0,m);CHKERRQ(ierr);
+      ierr = VecScale(t,1.0/(*beta));CHKERRQ(ierr);
+      w = z; z = t; t = w;
+    }
+  }
+
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&t);CHKERRQ(ierr);
+  ierr = PetscFree2(g,h2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   EPSBlockOrthonormalize_Private - Orthonormalizes columns j:j+bs-1 of V with
+   respect to V(:,0:j-1) and among themselves, with npass steps of block
+   classical Gram-Schmidt. In each step, the Gram matrix of the projected block
+   is obtained from the Pythagorean identity and factored with Cholesky, so that
+   only one global reduction is required. On exit, the input block W satisfies
+
+             W = V(:,0:j-1)*C + V(:,j:j+bs-1)*R,
+
+   with R upper triangular. If the Cholesky factorization breaks down, because
+   the block is numerically rank deficient, then fail is set and the block is
+   left in an intermediate state, with C and R consistent with it.
+*/
+static PetscErrorCode EPSBlockOrthonormalize_Private(EPS eps,PetscInt j,PetscInt bs,PetscInt npass,PetscScalar *C,PetscInt ldc,PetscScalar *R,PetscInt ldr,PetscBool *fail)
+{
+#if defined(PETSC_MISSING_LAPACK_POTRF) || defined(SLEPC_MISSING_LAPACK_TRTRI)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"POTRF/TRTRI - Lapack routines are unavailable");
+#else
+  PetscErrorCode ierr;
+  PetscInt       i,r,c,p,n = j+bs;
+  PetscScalar    *D,*G,*U,*q,sum;
+  PetscReal      *nrm;
+  PetscBLASInt   n_,info;
+  Mat            Q;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc4(n*bs,&D,bs*bs,&G,bs*bs,&U,bs,&nrm);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&Q);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(bs,&n_);CHKERRQ(ierr);
+  ierr = BVSetActiveColumns(eps->V,0,n);CHKERRQ(ierr);
+  for (c=0;c<bs;c++) {
+    for (i=0;i<j;i++) C[i+c*ldc] = 0.0;
+    for (r=0;r<bs;r++) R[r+c*ldr] = (r==c)? 1.0: 0.0;
+  }
+  *fail = PETSC_FALSE;
+
+  for (p=0;p<npass;p++) {
+    for (i=0;i<bs;i++) {
+      ierr = BVDotColumnBegin(eps->V,j+i,D+i*n);CHKERRQ(ierr);
+      ierr = BVNormColumnBegin(eps->V,j+i,NORM_2,nrm+i);CHKERRQ(ierr);
+    }
+    for (i=0;i<bs;i++) {
+      ierr = BVDotColumnEnd(eps->V,j+i,D+i*n);CHKERRQ(ierr);
+      ierr = BVNormColumnEnd(eps->V,j+i,NORM_2,nrm+i);CHKERRQ(ierr);
+    }
+    /* Gram matrix of the projected block, G = W'*W - D'*D */
+    ierr = PetscMemzero(G,bs*bs*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (c=0;c<bs;c++) {
+      for (r=0;r<=c;r++) {
+        sum = (r==c)? nrm[c]*nrm[c]: D[j+r+c*n];
+        for (i=0;i<j;i++) sum -= PetscConj(D[i+r*n])*D[i+c*n];
+        G[r+c*bs] = sum;
+      }
+    }
+    PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&n_,G,&n_,&info));
+    if (info) {
+      *fail = PETSC_TRUE;
+      break;
+    }
+    ierr = PetscMemcpy(U,G,bs*bs*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKtrtri",LAPACKtrtri_("U","N",&n_,U,&n_,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in xTRTRI, info=%D",(PetscInt)info);
+
+    /* new block = (W - V(:,0:j-1)*D)*inv(G) */
+    ierr = MatDenseGetArray(Q,&q);CHKERRQ(ierr);
+    for (c=0;c<bs;c++) {
+      for (i=0;i<j;i++) {
+        sum = 0.0;
+        for (r=0;r<=c;r++) sum -= D[i+r*n]*U[r+c*bs];
+        q[i+(j+c)*n] = sum;
+      }
+      for (r=0;r<bs;r++) q[j+r+(j+c)*n] = (r<=c)? U[r+c*bs]: 0.0;
+    }
+    ierr = MatDenseRestoreArray(Q,&q);CHKERRQ(ierr);
+    ierr = BVMultInPlace(eps->V,Q,j,n);CHKERRQ(ierr);
+
+    /* accumulate C = C + D*R and R = G*R */
+    for (c=0;c<bs;c++) {
+      for (i=0;i<j;i++) {
+        sum = 0.0;
+        for (r=0;r<=c;r++) sum += D[i+r*n]*R[r+c*ldr];
+        C[i+c*ldc] += sum;
+      }
+    }
+    for (c=bs-1;c>=0;c--) {
+      for (r=0;r<=c;r++) {
+        sum = 0.0;
+        for (i=r;i<=c;i++) sum += G[r+i*bs]*R[i+c*ldr];
+        R[r+c*ldr] = sum;
+      }
+    }
+    ierr = PetscLogFlops(2.0*j*bs*bs+4.0*bs*bs*bs/3.0);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&Q);CHKERRQ(ierr);
+  ierr = PetscFree4(D,G,U,nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   EPSSStepArnoldi - This function is equivalent to EPSBasicArnoldi but
+   generates s vectors at a time. Starting from v_j, the block is built with
+   a Newton polynomial basis
+
+             w_0 = v_j,   w_{i+1} = (OP - theta_i*I)*w_i/sigma,
+
+   so that OP*[w_0..w_{s-1}] = [w_0..w_s]*B with B bidiagonal. The block
+   [w_1..w_s] is then orthonormalized with EPSBlockOrthonormalize_Private(),
+   which requires a single global reduction (two if refinement is active).
+   Writing [w_0..w_s] = V*Rh, the Hessenberg columns are recovered from
+   OP*V(:,0:j-1) = V(:,0:j)*H as
+
+             H(:,j:j+s-1) = (Rh*B - H*X) * inv(U),
+
+   where X and U are the upper and middle parts of the first s columns of Rh.
+   If the block is numerically rank deficient, the factorization is completed
+   with EPSBasicArnoldi.
+
+   The columns of H before k must contain the Krylov relation obtained at
+   restart. Constraints (deflation space) are not supported.
+*/
+PetscErrorCode EPSSStepArnoldi(EPS eps,PetscInt s,PetscScalar *theta,PetscReal sigma,PetscScalar *H,PetscInt ldh,PetscInt k,PetscInt *M,PetscReal *beta,PetscBool *breakdown)
+{
+#if defined(SLEPC_MISSING_LAPACK_TRTRI)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"TRTRI - Lapack routine is unavailable");
+#else
+  PetscErrorCode     ierr;
+  PetscInt           i,j,r,c,p,bs,rmax,m = *M,ld = *M+1;
+  PetscScalar        *C,*R,*T,*U,*rh0,*rh1,sum;
+  PetscBLASInt       n_,ls_,info;
+  PetscBool          fail;
+  BVOrthogRefineType refine;
+  Vec                u,w;
+
+  PetscFunctionBegin;
+  ierr = BVGetOrthogonalization(eps->V,NULL,&refine,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc4(ld*s,&C,ld*s,&T,s*s,&R,s*s,&U);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(s,&ls_);CHKERRQ(ierr);
+  *breakdown = PETSC_FALSE;
+
+  j = k;
+  while (j<m) {
+    bs = PetscMin(s,m-j);
+    ierr = PetscBLASIntCast(bs,&n_);CHKERRQ(ierr);
+    ierr = BVSetActiveColumns(eps->V,0,j+bs+1);CHKERRQ(ierr);
+
+    /* generate the Newton basis */
+    for (i=0;i<bs;i++) {
+      ierr = BVGetColumn(eps->V,j+i,&u);CHKERRQ(ierr);
+      ierr = BVGetColumn(eps->V,j+i+1,&w);CHKERRQ(ierr);
+      ierr = STApply(eps->st,u,w);CHKERRQ(ierr);
+      ierr = VecAXPY(w,-theta[i],u);CHKERRQ(ierr);
+      ierr = VecScale(w,1.0/sigma);CHKERRQ(ierr);
+      ierr = BVRestoreColumn(eps->V,j+i,&u);CHKERRQ(ierr);
+      ierr = BVRestoreColumn(eps->V,j+i+1,&w);CHKERRQ(ierr);
+    }
+
+    /* block orthogonalization, [w_1..w_s] = V(:,0:j)*C + V(:,j+1:j+s)*R */
+    ierr = EPSBlockOrthonormalize_Private(eps,j+1,bs,(refine==BV_ORTHOG_REFINE_NEVER)?1:2,C,ld,R,s,&fail);CHKERRQ(ierr);
+    if (fail) {
+      ierr = PetscInfo1(eps,"Block of the s-step basis is numerically rank deficient, completing the factorization from column %D with standard Arnoldi\n",j);CHKERRQ(ierr);
+      ierr = EPSBasicArnoldi(eps,PETSC_FALSE,H,ldh,j,M,beta,breakdown);CHKERRQ(ierr);
+      break;
+    }
+
+    /* T = Rh*B - [H*X; 0], where column c of Rh is [C(:,c-1); R(:,c-1)] (e_j for c=0) */
+    for (c=0;c<bs;c++) {
+      for (i=0;i<=j+bs;i++) {
+        rh0 = (c==0)? NULL: (i<=j)? C+i+(c-1)*ld: (i-j-1<=c-1)? R+i-j-1+(c-1)*s: NULL;
+        rh1 = (i<=j)? C+i+c*ld: (i-j-1<=c)? R+i-j-1+c*s: NULL;
+        sum = sigma*(rh1? *rh1: 0.0);
+        if (c==0) { if (i==j) sum += theta[c]; }
+        else if (rh0) sum += theta[c]*(*rh0);
+        T[i+c*ld] = sum;
+      }
+      if (c>0) {
+        for (p=0;p<j;p++) {
+          rmax = PetscMin(j,PetscMax(p+1,k));
+          for (i=0;i<=rmax;i++) T[i+c*ld] -= H[i+p*ldh]*C[p+(c-1)*ld];
+        }
+      }
+    }
+    /* U is the block of Rh with rows j:j+bs-1, invert it */
+    ierr = PetscMemzero(U,s*s*sizeof(PetscScalar));CHKERRQ(ierr);
+    U[0] = 1.0;
+    for (c=1;c<bs;c++) {
+      U[c*s] = C[j+(c-1)*ld];
+      for (r=1;r<=c;r++) U[r+c*s] = R[r-1+(c-1)*s];
+    }
+    PetscStackCallBLAS("LAPACKtrtri",LAPACKtrtri_("U","N",&n_,U,&ls_,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in xTRTRI, info=%D",(PetscInt)info);
+
+    /* H(:,j:j+bs-1) = T*inv(U), which is upper Hessenberg */
+    for (c=0;c<bs;c++) {
+      for (i=0;i<=j+c+1;i++) {
+        sum = 0.0;
+        for (r=0;r<=c;r++) sum += T[i+r*ld]*U[r+c*s];
+        H[i+(j+c)*ldh] = sum;
+      }
+      for (i=j+c+2;i<=j+bs;i++) H[i+(j+c)*ldh] = 0.0;
+    }
+    ierr = PetscLogFlops(1.0*(j+bs)*bs*bs+2.0*j*(j+1)*bs);CHKERRQ(ierr);
+    *beta = PetscAbsScalar(H[j+bs+(j+bs-1)*ldh]);
+    H[j+bs+(j+bs-1)*ldh] = *beta;
+    j += bs;
+  }
+
+  ierr = BVSetActiveColumns(eps->V,0,m);CHKERRQ(ierr);
+  ierr = PetscFree4(C,T,R,U);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   EPSBlockArnoldi - Computes a block Arnoldi factorization with block size b.
+   Columns k:k+b-1 of V contain the current (orthonormal) block, and m-k must
+   be a multiple of b. On exit, the following relation is satisfied:
+
+             OP * V(:,0:m-1) - V(:,0:m-1) * H = V(:,m:m+b-1) * E * [0 .. 0 I],
+
+   where H is banded upper Hessenberg with b subdiagonals. The upper triangular
+   matrix E is stored in rows m:m+b-1 of H. If A is given, the operator is
+   applied to the whole block with BVMatMult(), using W as workspace; A must
+   be the matrix of a shift-type ST without balancing. Each new block is
+   orthonormalized with EPSBlockOrthonormalize_Private(), and if it is found
+   to be rank deficient, the orthogonalization proceeds column by column and
+   dependent columns are replaced by random vectors.
+*/
+PetscErrorCode EPSBlockArnoldi(EPS eps,PetscInt b,Mat A,BV W,PetscScalar *H,PetscInt ldh,PetscInt k,PetscInt m)
+{
+  PetscErrorCode     ierr;
+  PetscInt           i,j,r,c,col;
+  PetscScalar        *h,*C,*R,sum;
+  PetscReal          nrm;
+  PetscBool          fail,lindep;
+  BVOrthogRefineType refine;
+  Vec                u,w;
+
+  PetscFunctionBegin;
+  ierr = BVGetOrthogonalization(eps->V,NULL,&refine,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc3(m+b,&h,(m+b)*b,&C,b*b,&R);CHKERRQ(ierr);
+  for (j=k;j<m;j+=b) {
+    /* next block, OP*V(:,j:j+b-1) */
+    if (A) {
+      ierr = BVSetActiveColumns(eps->V,j,j+b);CHKERRQ(ierr);
+      ierr = BVSetActiveColumns(W,0,b);CHKERRQ(ierr);
+      ierr = BVMatMult(eps->V,A,W);CHKERRQ(ierr);
+      ierr = BVSetActiveColumns(eps->V,j+b,j+2*b);CHKERRQ(ierr);
+      ierr = BVCopy(W,eps->V);CHKERRQ(ierr);
+    } else {
+      for (i=0;i<b;i++) {
+        ierr = BVGetColumn(eps->V,j+i,&u);CHKERRQ(ierr);
+        ierr = BVGetColumn(eps->V,j+b+i,&w);CHKERRQ(ierr);
+        ierr = STApply(eps->st,u,w);CHKERRQ(ierr);
+        ierr = BVRestoreColumn(eps->V,j+i,&u);CHKERRQ(ierr);
+        ierr = BVRestoreColumn(eps->V,j+b+i,&w);CHKERRQ(ierr);
+      }
+    }
+
+    /* orthonormalize it, the coefficients go directly to H */
+    ierr = EPSBlockOrthonormalize_Private(eps,j+b,b,(refine==BV_ORTHOG_REFINE_NEVER)?1:2,H+j*ldh,ldh,H+j+b+j*ldh,ldh,&fail);CHKERRQ(ierr);
+    if (fail) {
+      ierr = PetscInfo1(eps,"Block Arnoldi: block starting at column %D is rank deficient\n",j+b);CHKERRQ(ierr);
+      ierr = BVSetActiveColumns(eps->V,0,j+2*b);CHKERRQ(ierr);
+      ierr = PetscMemzero(C,(m+b)*b*sizeof(PetscScalar));CHKERRQ(ierr);
+      ierr = PetscMemzero(R,b*b*sizeof(PetscScalar));CHKERRQ(ierr);
+      for (i=0;i<b;i++) {
+        col = j+b+i;
+        ierr = BVOrthogonalizeColumn(eps->V,col,h,&nrm,&lindep);CHKERRQ(ierr);
+        for (r=0;r<j+b;r++) C[r+i*(m+b)] = h[r];
+        for (r=0;r<i;r++) R[r+i*b] = h[j+b+r];
+        if (lindep || nrm==0.0) {
+          ierr = BVSetRandomColumn(eps->V,col);CHKERRQ(ierr);
+          ierr = BVOrthonormalizeColumn(eps->V,col,PETSC_TRUE,NULL,NULL);CHKERRQ(ierr);
+        } else {
+          ierr = BVScaleColumn(eps->V,col,1.0/nrm);CHKERRQ(ierr);
+          R[i+i*b] = nrm;
+        }
+      }
+      /* combine with the partial factorization, C = C + C2*R and R = R2*R */
+      for (c=0;c<b;c++) {
+        for (r=0;r<j+b;r++) {
+          sum = 0.0;
+          for (i=0;i<=c;i++) sum += C[r+i*(m+b)]*H[j+b+i+(j+c)*ldh];
+          H[r+(j+c)*ldh] += sum;
+        }
+      }
+      for (c=b-1;c>=0;c--) {
+        for (r=0;r<=c;r++) {
+          sum = 0.0;
+          for (i=r;i<=c;i++) sum += R[r+i*b]*H[j+b+i+(j+c)*ldh];
+          H[j+b+r+(j+c)*ldh] = sum;
+        }
+      }
+    }
+    /* zero out the part below the band */
+    for (c=0;c<b;c++) {
+      for (r=j+b+c+1;r<m+b;r++) H[r+(j+c)*ldh] = 0.0;
+    }
+  }
+  ierr = BVSetActiveColumns(eps->V,0,m);CHKERRQ(ierr);
+  ierr = PetscFree3(h,C,R);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    EPSDelayedArnoldi - This function is equivalent to EPSBasicArnoldi but
    performs the computation in a different way. The main idea is that
@@ -233,27 +632,16 @@ PetscErrorCode EPSDelayedArnoldi1(EPS eps,PetscScalar *H,PetscInt ldh,PetscInt k
 }
 
 /*
-   EPSKrylovConvergence - Implements the loop that checks for convergence
-   in Krylov methods.
-
-   Input Parameters:
-     eps   - the eigensolver; some error estimates are updated in eps->errest
-     getall - whether all residuals must be computed
-     kini  - initial value of k (the loop variable)
-     nits  - number of iterations of the loop
-     V     - set of basis vectors (used only if trueresidual is activated)
-     nv    - number of vectors to process (dimension of Q, columns of V)
-     beta  - norm of f (the residual vector of the Arnoldi/Lanczos factorization)
-     corrf - correction factor for residual estimates (only in harmonic KS)
-
-   Output Parameters:
-     kout  - the first index where the convergence test failed
+   EPSKrylovConvergence_Private - Implements the loop that checks for convergence
+   in Krylov methods. If E is given, the factorization is a block one with
+   residual block E (upper triangular, of size b), and the residual norm of
+   each Ritz pair is computed as ||E*X(n-b:n-1,k)|| instead of beta*|X(n-1,k)|.
 */
-PetscErrorCode EPSKrylovConvergence(EPS eps,PetscBool getall,PetscInt kini,PetscInt nits,PetscReal beta,PetscReal corrf,PetscInt *kout)
+static PetscErrorCode EPSKrylovConvergence_Private(EPS eps,PetscBool getall,PetscInt kini,PetscInt nits,PetscReal beta,PetscReal corrf,PetscInt b,PetscScalar *E,PetscInt lde,PetscInt *kout)
 {
   PetscErrorCode ierr;
-  PetscInt       k,newk,marker,ld,inside;
-  PetscScalar    re,im,*Zr,*Zi,*X;
+  PetscInt       k,newk,marker,ld,inside,n,i,c;
+  PetscScalar    re,im,*Zr,*Zi,*X,t;
   PetscReal      resnorm;
   PetscBool      isshift,refined,istrivial;
   Vec            x,y,w[3];
@@ -302,7 +690,23 @@ PetscErrorCode EPSKrylovConvergence(EPS eps,PetscBool getall,PetscInt kini,Petsc
       ierr = DSRestoreArray(eps->ds,DS_MAT_X,&X);CHKERRQ(ierr);
       ierr = EPSComputeResidualNorm_Private(eps,re,im,x,y,w,&resnorm);CHKERRQ(ierr);
     }
-    else if (!refined) resnorm *= beta*corrf;
+    else if (E) {
+      ierr = DSGetDimensions(eps->ds,&n,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+      ierr = DSGetArray(eps->ds,DS_MAT_X,&X);CHKERRQ(ierr);
+      resnorm = 0.0;
+      for (i=0;i<b;i++) {
+        t = 0.0;
+        for (c=i;c<b;c++) t += E[i+c*lde]*X[n-b+c+k*ld];
+        resnorm += PetscRealPart(t*PetscConj(t));
+        if (newk==k+1) {
+          t = 0.0;
+          for (c=i;c<b;c++) t += E[i+c*lde]*X[n-b+c+newk*ld];
+          resnorm += PetscRealPart(t*PetscConj(t));
+        }
+      }
+      resnorm = PetscSqrtReal(resnorm);
+      ierr = DSRestoreArray(eps->ds,DS_MAT_X,&X);CHKERRQ(ierr);
+    } else if (!refined) resnorm *= beta*corrf;
     /* error estimate */
     ierr = (*eps->converged)(eps,re,im,resnorm,&eps->errest[k],eps->convergedctx);CHKERRQ(ierr);
     if (marker==-1 && eps->errest[k] >= eps->tol) marker = k;
@@ -326,6 +730,46 @@ PetscErrorCode EPSKrylovConvergence(EPS eps,PetscBool getall,PetscInt kini,Petsc
   PetscFunctionReturn(0);
 }
 
+/*
+   EPSKrylovConvergence - Implements the loop that checks for convergence
+   in Krylov methods.
+
+   Input Parameters:
+     eps   - the eigensolver; some error estimates are updated in eps->errest
+     getall - whether all residuals must be computed
+     kini  - initial value of k (the loop variable)
+     nits  - number of iterations of the loop
+     V     - set of basis vectors (used only if trueresidual is activated)
+     nv    - number of vectors to process (dimension of Q, columns of V)
+     beta  - norm of f (the residual vector of the Arnoldi/Lanczos factorization)
+     corrf - correction factor for residual estimates (only in harmonic KS)
+
+   Output Parameters:
+     kout  - the first index where the convergence test failed
+*/
+PetscErrorCode EPSKrylovConvergence(EPS eps,PetscBool getall,PetscInt kini,PetscInt nits,PetscReal beta,PetscReal corrf,PetscInt *kout)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = EPSKrylovConvergence_Private(eps,getall,kini,nits,beta,corrf,1,NULL,0,kout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   EPSBlockKrylovConvergence - Same as EPSKrylovConvergence, for a block
+   Arnoldi factorization OP*V = V*H + F*E', where F has b columns and the
+   b x b upper triangular matrix E is stored with leading dimension lde.
+*/
+PetscErrorCode EPSBlockKrylovConvergence(EPS eps,PetscBool getall,PetscInt kini,PetscInt nits,PetscInt b,PetscScalar *E,PetscInt lde,PetscInt *kout)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = EPSKrylovConvergence_Private(eps,getall,kini,nits,1.0,1.0,b,E,lde,kout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    EPSFullLanczos - Computes an m-step Lanczos factorization with full
    reorthogonalization.  At each Lanczos step, the corresponding Lanczos
@@ -77,7 +77,7 @@ PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
   BVOrthogType      otype;
   BVOrthogBlockType obtype;
   EPS_KRYLOVSCHUR   *ctx = (EPS_KRYLOVSCHUR*)eps->data;
-  enum { EPS_KS_DEFAULT,EPS_KS_SYMM,EPS_KS_SLICE,EPS_KS_INDEF } variant;
+  enum { EPS_KS_DEFAULT,EPS_KS_SYMM,EPS_KS_SLICE,EPS_KS_INDEF,EPS_KS_BLOCK } variant;
 
   PetscFunctionBegin;
   /* spectrum slicing requires special treatment of default values */
@@ -99,10 +99,13 @@ PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
   } else if (eps->extraction!=EPS_RITZ && eps->extraction!=EPS_HARMONIC)
     SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Unsupported extraction type");
   if (eps->extraction==EPS_HARMONIC && ctx->lock) { ierr = PetscInfo(eps,"Locking was requested but will be deactivated since is not supported with harmonic extraction\n");CHKERRQ(ierr); }
+  if (ctx->pipelined && (eps->ishermitian || eps->extraction==EPS_HARMONIC || eps->nds)) { ierr = PetscInfo(eps,"Pipelined Arnoldi was requested but will be deactivated since is not supported in this case\n");CHKERRQ(ierr); }
+  if (ctx->sstep>1 && (eps->ishermitian || eps->extraction==EPS_HARMONIC || eps->nds)) { ierr = PetscInfo(eps,"The s-step variant was requested but will be deactivated since is not supported in this case\n");CHKERRQ(ierr); }
+  if (ctx->bs>1 && (eps->ishermitian || eps->extraction==EPS_HARMONIC || eps->nds)) { ierr = PetscInfo(eps,"The block variant was requested but will be deactivated since is not supported in this case\n");CHKERRQ(ierr); }
 
   if (!ctx->keep) ctx->keep = 0.5;
 
-  ierr = EPSAllocateSolution(eps,1);CHKERRQ(ierr);
+  ierr = EPSAllocateSolution(eps,(ctx->bs>1 && !eps->ishermitian)?ctx->bs:1);CHKERRQ(ierr);
   ierr = EPS_SetInnerProduct(eps);CHKERRQ(ierr);
   if (eps->arbitrary) {
     ierr = EPSSetWorkVecs(eps,2);CHKERRQ(ierr);
@@ -126,7 +129,7 @@ PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
     }
   } else {
     switch (eps->extraction) {
-      case EPS_RITZ:     variant = EPS_KS_DEFAULT; break;
+      case EPS_RITZ:     variant = (ctx->bs>1 && !eps->nds)? EPS_KS_BLOCK: EPS_KS_DEFAULT; break;
       case EPS_HARMONIC: variant = EPS_KS_DEFAULT; break;
       default: SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Unsupported extraction type");
     }
@@ -161,25 +164,70 @@ PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
       ierr = BVGetOrthogonalization(eps->V,&otype,NULL,&eta,&obtype);CHKERRQ(ierr);
       ierr = BVSetOrthogonalization(eps->V,otype,BV_ORTHOG_REFINE_ALWAYS,eta,obtype);CHKERRQ(ierr);
       break;
+    case EPS_KS_BLOCK:
+      if (eps->ncv<eps->nev+ctx->bs) SETERRQ(PetscObjectComm((PetscObject)eps),1,"The value of ncv must be at least nev+bs in the block variant");
+      if (eps->mpd<ctx->bs) SETERRQ(PetscObjectComm((PetscObject)eps),1,"The value of mpd must be at least bs in the block variant");
+      eps->ops->solve = EPSSolve_KrylovSchur_Block;
+      eps->ops->computevectors = EPSComputeVectors_Schur;
+      ierr = DSSetType(eps->ds,DSNHEP);CHKERRQ(ierr);
+      ierr = DSAllocate(eps->ds,eps->ncv+ctx->bs);CHKERRQ(ierr);
+      break;
     default: SETERRQ(PetscObjectComm((PetscObject)eps),1,"Unexpected error");
   }
   PetscFunctionReturn(0);
 }
 
+/*
+   Select the shifts for the Newton basis used in the s-step variant, as
+   the Leja ordering of the current Ritz values. In real arithmetic only the
+   real parts are used. Also estimate the spectral radius of the operator,
+   which is used to scale the basis vectors.
+*/
+static PetscErrorCode EPSKrylovSchurGetSStepShifts(EPS eps,PetscInt nv,PetscInt s,PetscScalar *theta,PetscReal *sigma)
+{
+  PetscInt  i,p,q,best;
+  PetscReal d,dist,maxd=0.0;
+
+  PetscFunctionBegin;
+  *sigma = 0.0;
+  for (p=0;p<nv;p++) *sigma = PetscMax(*sigma,SlepcAbsEigenvalue(eps->eigr[p],eps->eigi[p]));
+  if (*sigma==0.0) *sigma = 1.0;
+  for (i=0;i<s;i++) {
+    best = 0;
+    for (p=0;p<nv;p++) {
+      if (!i) dist = PetscAbsScalar(eps->eigr[p]);
+      else {
+        dist = 0.0;
+        for (q=0;q<i;q++) {
+          d = PetscAbsScalar(eps->eigr[p]-theta[q]);
+          if (d==0.0) { dist = -PETSC_MAX_REAL; break; }
+          dist += PetscLogReal(d);
+        }
+      }
+      if (!p || dist>maxd) { maxd = dist; best = p; }
+    }
+    theta[i] = eps->eigr[best];
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
 {
   PetscErrorCode  ierr;
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
   PetscInt        i,j,*pj,k,l,nv,ld,nconv;
   Mat             U;
-  PetscScalar     *S,*Q,*g;
-  PetscReal       beta,gamma=1.0;
-  PetscBool       breakdown,harmonic;
+  PetscScalar     *S,*Q,*g,*theta;
+  PetscReal       beta,gamma=1.0,sigma=1.0;
+  PetscBool       breakdown,harmonic,pipelined,sstep;
 
   PetscFunctionBegin;
   ierr = DSGetLeadingDimension(eps->ds,&ld);CHKERRQ(ierr);
   harmonic = (eps->extraction==EPS_HARMONIC || eps->extraction==EPS_REFINED_HARMONIC)?PETSC_TRUE:PETSC_FALSE;
+  sstep = (ctx->sstep>1 && !harmonic && !eps->nds)?PETSC_TRUE:PETSC_FALSE;
+  pipelined = (ctx->pipelined && !sstep && !harmonic && !eps->nds)?PETSC_TRUE:PETSC_FALSE;
   if (harmonic) { ierr = PetscMalloc1(ld,&g);CHKERRQ(ierr); }
+  if (sstep) { ierr = PetscMalloc1(ctx->sstep,&theta);CHKERRQ(ierr); }
   if (eps->arbitrary) pj = &j;
   else pj = NULL;
 
@@ -194,13 +242,19 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
     /* Compute an nv-step Arnoldi factorization */
     nv = PetscMin(eps->nconv+eps->mpd,eps->ncv);
     ierr = DSGetArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
-    ierr = EPSBasicArnoldi(eps,PETSC_FALSE,S,ld,eps->nconv+l,&nv,&beta,&breakdown);CHKERRQ(ierr);
+    if (sstep && eps->its>1) {  /* shifts are taken from the previous restart */
+      ierr = EPSSStepArnoldi(eps,ctx->sstep,theta,sigma,S,ld,eps->nconv+l,&nv,&beta,&breakdown);CHKERRQ(ierr);
+    } else if (pipelined) {
+      ierr = EPSPipelinedArnoldi(eps,S,ld,eps->nconv+l,&nv,&beta,&breakdown);CHKERRQ(ierr);
+    } else {
+      ierr = EPSBasicArnoldi(eps,PETSC_FALSE,S,ld,eps->nconv+l,&nv,&beta,&breakdown);CHKERRQ(ierr);
+    }
     ierr = DSRestoreArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
     ierr = DSSetDimensions(eps->ds,nv,0,eps->nconv,eps->nconv+l);CHKERRQ(ierr);
     if (l==0) {
       ierr = DSSetState(eps->ds,DS_STATE_INTERMEDIATE);CHKERRQ(ierr);
     } else {
-      ierr = DSSetState(eps->ds,DS_STATE_RAW);CHKERRQ(ierr);
+      ierr = DSSetState(eps->ds,DS_STATE_ARROW);CHKERRQ(ierr);
     }
     ierr = BVSetActiveColumns(eps->V,eps->nconv,nv);CHKERRQ(ierr);
 
@@ -216,6 +270,7 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
       j=1;
     }
     ierr = DSSort(eps->ds,eps->eigr,eps->eigi,eps->rr,eps->ri,pj);CHKERRQ(ierr);
+    if (sstep) { ierr = EPSKrylovSchurGetSStepShifts(eps,nv,ctx->sstep,theta,&sigma);CHKERRQ(ierr); }
 
     /* Check convergence */
     ierr = EPSKrylovConvergence(eps,PETSC_FALSE,eps->nconv,nv-eps->nconv,beta,gamma,&k);CHKERRQ(ierr);
@@ -280,6 +335,7 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
   }
 
   if (harmonic) { ierr = PetscFree(g);CHKERRQ(ierr); }
+  if (sstep) { ierr = PetscFree(theta);CHKERRQ(ierr); }
   /* truncate Schur decomposition and change the state to raw so that
      DSVectors() computes eigenvectors from scratch */
   ierr = DSSetDimensions(eps->ds,eps->nconv,0,0,0);CHKERRQ(ierr);
@@ -447,6 +503,287 @@ PetscErrorCode EPSKrylovSchurGetLocking(EPS eps,PetscBool *lock)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode EPSKrylovSchurSetPipelined_KrylovSchur(EPS eps,PetscBool pipelined)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  ctx->pipelined = pipelined;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   EPSKrylovSchurSetPipelined - Activates the pipelined variant of the
+   Arnoldi process in the Krylov-Schur method.
+
+   Logically Collective on EPS
+
+   Input Parameters:
++  eps       - the eigenproblem solver context
+-  pipelined - true if the pipelined variant must be used
+
+   Options Database Key:
+.  -eps_krylovschur_pipelined - Sets the pipelined flag
+
+   Notes:
+   In the pipelined variant, the global reductions required to orthogonalize
+   each new Arnoldi vector are started in nonblocking mode and overlapped with
+   the next operator application. A single classical Gram-Schmidt pass is
+   done, and the auxiliary vector is updated with a recurrence, so that the
+   number of operator applications is the same as in the default variant.
+   This may be beneficial when the global reductions are the bottleneck, e.g.,
+   with many processes. In order to fully avoid additional synchronizations,
+   refinement of the orthogonalization should be disabled with
+   -bv_orthog_refine never, at the cost of some loss of orthogonality.
+
+   The pipelined variant is only available in the non-symmetric solver with
+   Ritz extraction, and cannot be used together with a deflation space. In
+   other cases, the flag is ignored.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetPipelined(), BVSetOrthogonalization()
+@*/
+PetscErrorCode EPSKrylovSchurSetPipelined(EPS eps,PetscBool pipelined)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,pipelined,2);
+  ierr = PetscTryMethod(eps,"EPSKrylovSchurSetPipelined_C",(EPS,PetscBool),(eps,pipelined));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode EPSKrylovSchurGetPipelined_KrylovSchur(EPS eps,PetscBool *pipelined)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *pipelined = ctx->pipelined;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   EPSKrylovSchurGetPipelined - Gets the flag indicating whether the pipelined
+   variant of the Arnoldi process is used in the Krylov-Schur method.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  pipelined - the pipelined flag
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetPipelined()
+@*/
+PetscErrorCode EPSKrylovSchurGetPipelined(EPS eps,PetscBool *pipelined)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidPointer(pipelined,2);
+  ierr = PetscUseMethod(eps,"EPSKrylovSchurGetPipelined_C",(EPS,PetscBool*),(eps,pipelined));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode EPSKrylovSchurSetSStep_KrylovSchur(EPS eps,PetscInt s)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (s==PETSC_DEFAULT || s==PETSC_DECIDE) ctx->sstep = 1;
+  else {
+    if (s<1) SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The s argument must be > 0");
+    ctx->sstep = s;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   EPSKrylovSchurSetSStep - Sets the number of basis vectors that are generated
+   at a time in the s-step variant of the Krylov-Schur method.
+
+   Logically Collective on EPS
+
+   Input Parameters:
++  eps - the eigenproblem solver context
+-  s   - the number of vectors of each block
+
+   Options Database Key:
+.  -eps_krylovschur_sstep - Sets the value of s
+
+   Notes:
+   In the s-step (communication-avoiding) variant, the Krylov basis is extended
+   s vectors at a time with a Newton polynomial basis, whose shifts are the
+   Ritz values computed at the previous restart (in Leja order). Each block is
+   orthogonalized with a block Gram-Schmidt step based on a Cholesky
+   factorization, so the number of global reductions in the Arnoldi process
+   is reduced by a factor of approximately s. The Hessenberg matrix is then
+   recovered from the change of basis. The first restart is always done with
+   the standard Arnoldi process, since no Ritz values are available yet.
+
+   Large values of s may result in an ill-conditioned basis. When this is
+   detected, the factorization is completed with the standard Arnoldi process.
+   The default is s=1, which corresponds to the standard Krylov-Schur method.
+
+   The s-step variant is only available in the non-symmetric solver with
+   Ritz extraction, and cannot be used together with a deflation space. In
+   other cases, the value of s is ignored. It takes precedence over the
+   pipelined variant.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetSStep(), EPSKrylovSchurSetPipelined()
+@*/
+PetscErrorCode EPSKrylovSchurSetSStep(EPS eps,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,s,2);
+  ierr = PetscTryMethod(eps,"EPSKrylovSchurSetSStep_C",(EPS,PetscInt),(eps,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode EPSKrylovSchurGetSStep_KrylovSchur(EPS eps,PetscInt *s)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *s = ctx->sstep;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   EPSKrylovSchurGetSStep - Gets the number of basis vectors that are generated
+   at a time in the s-step variant of the Krylov-Schur method.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  s - the number of vectors of each block
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetSStep()
+@*/
+PetscErrorCode EPSKrylovSchurGetSStep(EPS eps,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(eps,"EPSKrylovSchurGetSStep_C",(EPS,PetscInt*),(eps,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode EPSKrylovSchurSetBlockSize_KrylovSchur(EPS eps,PetscInt bs)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (bs==PETSC_DEFAULT || bs==PETSC_DECIDE) ctx->bs = 1;
+  else {
+    if (bs<1) SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The block size must be > 0");
+    ctx->bs = bs;
+  }
+  eps->state = EPS_STATE_INITIAL;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   EPSKrylovSchurSetBlockSize - Sets the block size of the block Krylov-Schur
+   method.
+
+   Logically Collective on EPS
+
+   Input Parameters:
++  eps - the eigenproblem solver context
+-  bs  - the block size
+
+   Options Database Key:
+.  -eps_krylovschur_bsize - Sets the block size
+
+   Notes:
+   With a block size larger than one, the Krylov subspace is expanded with
+   bs vectors at a time. The operator is applied to the whole block at once,
+   which allows the use of a sparse matrix times dense matrix product when
+   the spectral transformation is a plain shift of a standard problem (no
+   balancing). Each new block is orthonormalized against the basis and within
+   itself with a block Gram-Schmidt scheme based on a Cholesky factorization.
+   The projected matrix is then a band Hessenberg matrix, with bs subdiagonals.
+   Block methods are more robust for computing clustered or multiple
+   eigenvalues, and can perform better on architectures where the cost
+   of a matrix-vector product is dominated by memory traffic.
+
+   The default is bs=1, which corresponds to the standard Krylov-Schur method.
+   The block variant is only available in the non-symmetric solver with Ritz
+   extraction, and cannot be used together with a deflation space. In other
+   cases, the block size is ignored. When active, it takes precedence over the
+   s-step and pipelined variants. The number of column vectors, ncv, must be
+   at least nev+bs.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetBlockSize()
+@*/
+PetscErrorCode EPSKrylovSchurSetBlockSize(EPS eps,PetscInt bs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,bs,2);
+  ierr = PetscTryMethod(eps,"EPSKrylovSchurSetBlockSize_C",(EPS,PetscInt),(eps,bs));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode EPSKrylovSchurGetBlockSize_KrylovSchur(EPS eps,PetscInt *bs)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *bs = ctx->bs;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   EPSKrylovSchurGetBlockSize - Gets the block size used in the block
+   Krylov-Schur method.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  bs - the block size
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetBlockSize()
+@*/
+PetscErrorCode EPSKrylovSchurGetBlockSize(EPS eps,PetscInt *bs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidIntPointer(bs,2);
+  ierr = PetscUseMethod(eps,"EPSKrylovSchurGetBlockSize_C",(EPS,PetscInt*),(eps,bs));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode EPSKrylovSchurSetPartitions_KrylovSchur(EPS eps,PetscInt npart)
 {
   PetscErrorCode  ierr;
@@ -1195,6 +1532,18 @@ PetscErrorCode EPSSetFromOptions_KrylovSchur(PetscOptionItems *PetscOptionsObjec
     ierr = PetscOptionsBool("-eps_krylovschur_locking","Choose between locking and non-locking variants","EPSKrylovSchurSetLocking",PETSC_TRUE,&lock,&flg);CHKERRQ(ierr);
     if (flg) { ierr = EPSKrylovSchurSetLocking(eps,lock);CHKERRQ(ierr); }
 
+    b = ctx->pipelined;
+    ierr = PetscOptionsBool("-eps_krylovschur_pipelined","Overlap global reductions with operator applications in the Arnoldi process","EPSKrylovSchurSetPipelined",ctx->pipelined,&b,&flg);CHKERRQ(ierr);
+    if (flg) { ierr = EPSKrylovSchurSetPipelined(eps,b);CHKERRQ(ierr); }
+
+    i = ctx->sstep;
+    ierr = PetscOptionsInt("-eps_krylovschur_sstep","Number of basis vectors generated at a time (s-step variant)","EPSKrylovSchurSetSStep",ctx->sstep,&i,&flg);CHKERRQ(ierr);
+    if (flg) { ierr = EPSKrylovSchurSetSStep(eps,i);CHKERRQ(ierr); }
+
+    i = ctx->bs;
+    ierr = PetscOptionsInt("-eps_krylovschur_bsize","Block size (block Krylov-Schur variant)","EPSKrylovSchurSetBlockSize",ctx->bs,&i,&flg);CHKERRQ(ierr);
+    if (flg) { ierr = EPSKrylovSchurSetBlockSize(eps,i);CHKERRQ(ierr); }
+
     i = ctx->npart;
     ierr = PetscOptionsInt("-eps_krylovschur_partitions","Number of partitions of the communicator for spectrum slicing","EPSKrylovSchurSetPartitions",ctx->npart,&i,&flg);CHKERRQ(ierr);
     if (flg) { ierr = EPSKrylovSchurSetPartitions(eps,i);CHKERRQ(ierr); }
@@ -1225,6 +1574,13 @@ PetscErrorCode EPSView_KrylovSchur(EPS eps,PetscViewer viewer)
   if (isascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  Krylov-Schur: %d%% of basis vectors kept after restart\n",(int)(100*ctx->keep));CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Krylov-Schur: using the %slocking variant\n",ctx->lock?"":"non-");CHKERRQ(ierr);
+    if (ctx->bs>1) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Krylov-Schur: using block Arnoldi with block size %D\n",ctx->bs);CHKERRQ(ierr);
+    } else if (ctx->sstep>1) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Krylov-Schur: using s-step Arnoldi with s=%D\n",ctx->sstep);CHKERRQ(ierr);
+    } else if (ctx->pipelined) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Krylov-Schur: using pipelined Arnoldi\n");CHKERRQ(ierr);
+    }
     if (eps->which==EPS_ALL) {
       ierr = PetscViewerASCIIPrintf(viewer,"  Krylov-Schur: doing spectrum slicing with nev=%D, ncv=%D, mpd=%D\n",ctx->nev,ctx->ncv,ctx->mpd);CHKERRQ(ierr);
       if (ctx->npart>1) {
@@ -1246,6 +1602,12 @@ PetscErrorCode EPSDestroy_KrylovSchur(EPS eps)
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetRestart_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetLocking_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetLocking_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetPipelined_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetPipelined_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetSStep_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetSStep_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetBlockSize_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetBlockSize_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetPartitions_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetPartitions_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDetectZeros_C",NULL);CHKERRQ(ierr);
@@ -1295,6 +1657,8 @@ PETSC_EXTERN PetscErrorCode EPSCreate_KrylovSchur(EPS eps)
   eps->data   = (void*)ctx;
   ctx->lock   = PETSC_TRUE;
   ctx->nev    = 1;
+  ctx->sstep  = 1;
+  ctx->bs     = 1;
   ctx->npart  = 1;
   ctx->detect = PETSC_FALSE;
   ctx->global = PETSC_TRUE;
@@ -1312,6 +1676,12 @@ PETSC_EXTERN PetscErrorCode EPSCreate_KrylovSchur(EPS eps)
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetRestart_C",EPSKrylovSchurGetRestart_KrylovSchur);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetLocking_C",EPSKrylovSchurSetLocking_KrylovSchur);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetLocking_C",EPSKrylovSchurGetLocking_KrylovSchur);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetPipelined_C",EPSKrylovSchurSetPipelined_KrylovSchur);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetPipelined_C",EPSKrylovSchurGetPipelined_KrylovSchur);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetSStep_C",EPSKrylovSchurSetSStep_KrylovSchur);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetSStep_C",EPSKrylovSchurGetSStep_KrylovSchur);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetBlockSize_C",EPSKrylovSchurSetBlockSize_KrylovSchur);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetBlockSize_C",EPSKrylovSchurGetBlockSize_KrylovSchur);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetPartitions_C",EPSKrylovSchurSetPartitions_KrylovSchur);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetPartitions_C",EPSKrylovSchurGetPartitions_KrylovSchur);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDetectZeros_C",EPSKrylovSchurSetDetectZeros_KrylovSchur);CHKERRQ(ierr);
@@ -30,6 +30,7 @@ PETSC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Symm(EPS);
 PETSC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Slice(EPS);
 PETSC_INTERN PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS);
 PETSC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Indefinite(EPS);
+PETSC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Block(EPS);
 PETSC_INTERN PetscErrorCode EPSGetArbitraryValues(EPS,PetscScalar*,PetscScalar*);
 
 /* Structure characterizing a shift in spectrum slicing */
@@ -80,6 +81,9 @@ typedef struct _n_SR *EPS_SR;
 typedef struct {
   PetscReal        keep;               /* restart parameter */
   PetscBool        lock;               /* locking/non-locking variant */
+  PetscBool        pipelined;          /* overlap reductions with operator applications */
+  PetscInt         sstep;              /* block size of the s-step basis generation */
+  PetscInt         bs;                 /* block size of the block Krylov-Schur variant */
   /* the following are used only in spectrum slicing */
   EPS_SR           sr;                 /* spectrum slicing context */
   PetscInt         nev;                /* number of eigenvalues to compute */
@@ -0,0 +1,157 @@
+/*
+
+   SLEPc eigensolver: "krylovschur"
+
+   Method: Block Krylov-Schur for non-symmetric problems
+
+   Algorithm:
+
+       Block version of the Krylov-Schur method. The Krylov subspace is
+       expanded bs vectors at a time, so that the projected matrix is a
+       band Hessenberg matrix with bs subdiagonals, and the residual of the
+       factorization is a block of bs vectors.
+
+   References:
+
+       [1] Y. Zhou and Y. Saad, "Block Krylov-Schur method for large symmetric
+           eigenvalue problems", Numer. Algorithms 47(4):341-359, 2008.
+
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+#include <slepc/private/epsimpl.h>
+#include "krylovschur.h"
+
+PetscErrorCode EPSSolve_KrylovSchur_Block(EPS eps)
+{
+  PetscErrorCode  ierr;
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt        i,j,r,c,*pj,k,l,nv,ld,nconv,nmat,b=ctx->bs;
+  Mat             U,A=NULL;
+  BV              W=NULL;
+  Vec             D;
+  PetscScalar     *S,*Q,*E,sum;
+  PetscBool       isshift;
+
+  PetscFunctionBegin;
+  ierr = DSGetLeadingDimension(eps->ds,&ld);CHKERRQ(ierr);
+  ierr = PetscMalloc1(b*b,&E);CHKERRQ(ierr);
+  if (eps->arbitrary) pj = &j;
+  else pj = NULL;
+
+  /* the operator can be applied to a whole block with a single sparse-dense
+     product only in standard problems with a shift-type ST */
+  ierr = PetscObjectTypeCompare((PetscObject)eps->st,STSHIFT,&isshift);CHKERRQ(ierr);
+  ierr = STGetNumMatrices(eps->st,&nmat);CHKERRQ(ierr);
+  ierr = STGetBalanceMatrix(eps->st,&D);CHKERRQ(ierr);
+  if (isshift && nmat==1 && !D) {
+    ierr = STGetTOperators(eps->st,0,&A);CHKERRQ(ierr);
+    ierr = BVDuplicateResize(eps->V,b,&W);CHKERRQ(ierr);
+  }
+
+  /* Get the starting block */
+  for (i=0;i<b;i++) {
+    ierr = EPSGetStartVector(eps,i,NULL);CHKERRQ(ierr);
+  }
+  l = 0;
+
+  /* Restart loop */
+  while (eps->reason == EPS_CONVERGED_ITERATING) {
+    eps->its++;
+
+    /* Compute a block Arnoldi factorization, the size of the expansion
+       must be a multiple of the block size */
+    nv = PetscMin(eps->nconv+eps->mpd,eps->ncv);
+    nv = eps->nconv+l+((nv-eps->nconv-l)/b)*b;
+    ierr = DSGetArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
+    ierr = EPSBlockArnoldi(eps,b,A,W,S,ld,eps->nconv+l,nv);CHKERRQ(ierr);
+    for (c=0;c<b;c++) {
+      for (r=0;r<b;r++) E[r+c*b] = S[nv+r+(nv-b+c)*ld];
+    }
+    ierr = DSRestoreArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
+    ierr = DSSetDimensions(eps->ds,nv,0,eps->nconv,eps->nconv+l);CHKERRQ(ierr);
+    ierr = DSSetState(eps->ds,DS_STATE_RAW);CHKERRQ(ierr);
+    ierr = BVSetActiveColumns(eps->V,eps->nconv,nv);CHKERRQ(ierr);
+
+    /* Solve projected problem */
+    ierr = DSSolve(eps->ds,eps->eigr,eps->eigi);CHKERRQ(ierr);
+    if (eps->arbitrary) {
+      ierr = EPSGetArbitraryValues(eps,eps->rr,eps->ri);CHKERRQ(ierr);
+      j=1;
+    }
+    ierr = DSSort(eps->ds,eps->eigr,eps->eigi,eps->rr,eps->ri,pj);CHKERRQ(ierr);
+
+    /* Check convergence */
+    ierr = EPSBlockKrylovConvergence(eps,PETSC_FALSE,eps->nconv,nv-eps->nconv,b,E,b,&k);CHKERRQ(ierr);
+    ierr = (*eps->stopping)(eps,eps->its,eps->max_it,k,eps->nev,&eps->reason,eps->stoppingctx);CHKERRQ(ierr);
+    nconv = k;
+
+    /* Update l, leaving room for the residual block */
+    if (eps->reason != EPS_CONVERGED_ITERATING) l = 0;
+    else {
+      l = PetscMax(1,(PetscInt)((nv-k)*ctx->keep));
+      l = PetscMax(0,PetscMin(l,nv-k-b));
+#if !defined(PETSC_USE_COMPLEX)
+      ierr = DSGetArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
+      if (l>0 && S[k+l+(k+l-1)*ld] != 0.0) {
+        if (k+l<nv-b) l = l+1;
+        else l = l-1;
+      }
+      ierr = DSRestoreArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
+#endif
+    }
+    if (!ctx->lock && l>0) { l += k; k = 0; } /* non-locking variant: reset no. of converged pairs */
+
+    if (eps->reason == EPS_CONVERGED_ITERATING) {
+      /* Prepare the Rayleigh quotient for restart, the coupling with the
+         residual block is E*Q(nv-b:nv-1,k:k+l-1) */
+      ierr = DSGetArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
+      ierr = DSGetArray(eps->ds,DS_MAT_Q,&Q);CHKERRQ(ierr);
+      for (i=k;i<k+l;i++) {
+        for (r=0;r<b;r++) {
+          sum = 0.0;
+          for (c=r;c<b;c++) sum += E[r+c*b]*Q[nv-b+c+i*ld];
+          S[k+l+r+i*ld] = sum;
+        }
+      }
+      ierr = DSRestoreArray(eps->ds,DS_MAT_A,&S);CHKERRQ(ierr);
+      ierr = DSRestoreArray(eps->ds,DS_MAT_Q,&Q);CHKERRQ(ierr);
+    }
+    /* Update the corresponding vectors V(:,idx) = V*Q(:,idx) */
+    ierr = DSGetMat(eps->ds,DS_MAT_Q,&U);CHKERRQ(ierr);
+    ierr = BVMultInPlace(eps->V,U,eps->nconv,k+l);CHKERRQ(ierr);
+    ierr = MatDestroy(&U);CHKERRQ(ierr);
+
+    if (eps->reason == EPS_CONVERGED_ITERATING) {
+      for (i=0;i<b;i++) {
+        ierr = BVCopyColumn(eps->V,nv+i,k+l+i);CHKERRQ(ierr);
+      }
+    }
+    eps->nconv = k;
+    ierr = EPSMonitor(eps,eps->its,nconv,eps->eigr,eps->eigi,eps->errest,nv);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree(E);CHKERRQ(ierr);
+  ierr = BVDestroy(&W);CHKERRQ(ierr);
+  /* truncate Schur decomposition and change the state to raw so that
+     DSVectors() computes eigenvectors from scratch */
+  ierr = DSSetDimensions(eps->ds,eps->nconv,0,0,0);CHKERRQ(ierr);
+  ierr = DSSetState(eps->ds,DS_STATE_RAW);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
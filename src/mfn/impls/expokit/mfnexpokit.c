@@ -36,10 +36,16 @@
 
 #include <slepc/private/mfnimpl.h>
 
+typedef struct {
+  PetscScalar *work;     /* workspace for the projected matrices, kept between solves */
+  PetscInt    lwork;
+} MFN_EXPOKIT;
+
 PetscErrorCode MFNSetUp_Expokit(MFN mfn)
 {
   PetscErrorCode ierr;
-  PetscInt       N;
+  MFN_EXPOKIT    *ctx = (MFN_EXPOKIT*)mfn->data;
+  PetscInt       N,ld,lwork;
   PetscBool      isexp;
 
   PetscFunctionBegin;
@@ -50,12 +56,22 @@ PetscErrorCode MFNSetUp_Expokit(MFN mfn)
 
   ierr = PetscObjectTypeCompare((PetscObject)mfn->fn,FNEXP,&isexp);CHKERRQ(ierr);
   if (!isexp) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This solver only supports the exponential function");
+
+  ld = mfn->ncv+2;
+  lwork = mfn->ncv+1+2*ld*ld;
+  if (lwork>ctx->lwork) {
+    ierr = PetscFree(ctx->work);CHKERRQ(ierr);
+    ierr = PetscMalloc1(lwork,&ctx->work);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)mfn,(lwork-ctx->lwork)*sizeof(PetscScalar));CHKERRQ(ierr);
+    ctx->lwork = lwork;
+  }
   PetscFunctionReturn(0);
 }
 
 PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
 {
   PetscErrorCode ierr;
+  MFN_EXPOKIT    *ctx = (MFN_EXPOKIT*)mfn->data;
   PetscInt       mxstep,mxrej,m,mb,ld,i,j,ireject,mx,k1;
   Vec            v,r;
   Mat            M=NULL,K=NULL;
@@ -94,7 +110,10 @@ PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
 
   ierr = VecCopy(b,x);CHKERRQ(ierr);
   ld = m+2;
-  ierr = PetscCalloc3(m+1,&betaF,ld*ld,&H,ld*ld,&B);CHKERRQ(ierr);
+  betaF = ctx->work;
+  H     = ctx->work+m+1;
+  B     = ctx->work+m+1+ld*ld;
+  ierr = PetscMemzero(ctx->work,(m+1+2*ld*ld)*sizeof(PetscScalar));CHKERRQ(ierr);
 
   while (mfn->reason == MFN_CONVERGED_ITERATING) {
     mfn->its++;
@@ -187,14 +206,44 @@ PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
   ierr = MatDestroy(&M);CHKERRQ(ierr);
   ierr = MatDestroy(&K);CHKERRQ(ierr);
   ierr = FNDestroy(&fn);CHKERRQ(ierr);
-  ierr = PetscFree3(betaF,H,B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MFNReset_Expokit(MFN mfn)
+{
+  PetscErrorCode ierr;
+  MFN_EXPOKIT    *ctx = (MFN_EXPOKIT*)mfn->data;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(ctx->work);CHKERRQ(ierr);
+  ctx->lwork = 0;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MFNDestroy_Expokit(MFN mfn)
+{
+  PetscErrorCode ierr;
+  MFN_EXPOKIT    *ctx = (MFN_EXPOKIT*)mfn->data;
+
+  PetscFunctionBegin;
+  /* MFNSetType() calls destroy without reset, so the workspace may still be there */
+  ierr = PetscFree(ctx->work);CHKERRQ(ierr);
+  ierr = PetscFree(mfn->data);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 PETSC_EXTERN PetscErrorCode MFNCreate_Expokit(MFN mfn)
 {
+  PetscErrorCode ierr;
+  MFN_EXPOKIT    *ctx;
+
   PetscFunctionBegin;
+  ierr = PetscNewLog(mfn,&ctx);CHKERRQ(ierr);
+  mfn->data = (void*)ctx;
+
   mfn->ops->solve          = MFNSolve_Expokit;
   mfn->ops->setup          = MFNSetUp_Expokit;
+  mfn->ops->reset          = MFNReset_Expokit;
+  mfn->ops->destroy        = MFNDestroy_Expokit;
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,94 @@
+/*
+
+   SLEPc matrix function solver: "taylor"
+
+   Method: Truncated Taylor series with scaling for the matrix exponential
+
+   Algorithm:
+
+       Computes exp(t*A)*b as s steps of the form x = T_m(t/s*A)*x, where
+       T_m is the Taylor polynomial of degree m, with m and s chosen from
+       the 1-norm of t*A. Only matrix-vector products with A are required.
+
+   References:
+
+       [1] A. H. Al-Mohy and N. J. Higham, "Computing the action of the
+           matrix exponential, with an application to exponential
+           integrators", SIAM J. Sci. Comput. 33(2):488-511, 2011.
+
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+#include <slepc/private/mfnimpl.h>
+#include <slepc/private/fnimpl.h>
+
+PetscErrorCode MFNSetUp_Taylor(MFN mfn)
+{
+  PetscErrorCode ierr;
+  PetscBool      isexp;
+  Vec            t;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)mfn->fn,FNEXP,&isexp);CHKERRQ(ierr);
+  if (!isexp) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This solver only supports the exponential function");
+  if (!mfn->max_it) mfn->max_it = 1000;
+
+  /* the basis is not used, only two work vectors */
+  if (!mfn->work) {
+    ierr = MatCreateVecs(mfn->A,&t,NULL);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(t,2,&mfn->work);CHKERRQ(ierr);
+    ierr = PetscLogObjectParents(mfn,2,mfn->work);CHKERRQ(ierr);
+    ierr = VecDestroy(&t);CHKERRQ(ierr);
+    mfn->nwork = 2;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MFNSolve_Taylor(MFN mfn,Vec b,Vec x)
+{
+  PetscErrorCode ierr;
+  PetscInt       m,s;
+  PetscScalar    t,sfactor;
+  PetscReal      nrm,err;
+
+  PetscFunctionBegin;
+  ierr = FNGetScale(mfn->fn,&t,&sfactor);CHKERRQ(ierr);
+  ierr = MatNorm(mfn->A,NORM_1,&nrm);CHKERRQ(ierr);
+  ierr = FNExpTaylorParameters_Private(PetscAbsScalar(t)*nrm,&m,&s);CHKERRQ(ierr);
+
+  ierr = VecCopy(b,x);CHKERRQ(ierr);
+  while (mfn->reason == MFN_CONVERGED_ITERATING) {
+    mfn->its++;
+    ierr = FNExpTaylorStep_Private(t/(PetscReal)s,m,mfn->A,x,mfn->work,&err);CHKERRQ(ierr);
+    if (mfn->its==s) mfn->reason = MFN_CONVERGED_TOL;
+    else if (mfn->its==mfn->max_it) mfn->reason = MFN_DIVERGED_ITS;
+    ierr = MFNMonitor(mfn,mfn->its,err);CHKERRQ(ierr);
+  }
+  ierr = VecScale(x,sfactor);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MFNCreate_Taylor(MFN mfn)
+{
+  PetscFunctionBegin;
+  mfn->ops->solve          = MFNSolve_Taylor;
+  mfn->ops->setup          = MFNSetUp_Taylor;
+  PetscFunctionReturn(0);
+}
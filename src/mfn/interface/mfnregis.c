@@ -23,6 +23,7 @@
 
 PETSC_EXTERN PetscErrorCode MFNCreate_Krylov(MFN);
 PETSC_EXTERN PetscErrorCode MFNCreate_Expokit(MFN);
+PETSC_EXTERN PetscErrorCode MFNCreate_Taylor(MFN);
 
 /*@C
   MFNRegisterAll - Registers all the matrix functions in the MFN package.
@@ -42,6 +43,7 @@ PetscErrorCode MFNRegisterAll(void)
   MFNRegisterAllCalled = PETSC_TRUE;
   ierr = MFNRegister(MFNKRYLOV,MFNCreate_Krylov);CHKERRQ(ierr);
   ierr = MFNRegister(MFNEXPOKIT,MFNCreate_Expokit);CHKERRQ(ierr);
+  ierr = MFNRegister(MFNTAYLOR,MFNCreate_Taylor);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
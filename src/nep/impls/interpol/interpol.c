@@ -134,9 +134,7 @@ PetscErrorCode NEPSolve_Interpol(NEP nep)
   ierr = RGIntervalGetEndpoints(nep->rg,&a,&b,NULL,NULL);CHKERRQ(ierr);
   ierr = ChebyshevNodes(deg,a,b,x,cs);CHKERRQ(ierr);
   for (j=0;j<nep->nt;j++) {
-    for (i=0;i<=deg;i++) {
-      ierr = FNEvaluateFunction(nep->f[j],x[i],&fx[i+j*(deg+1)]);CHKERRQ(ierr);
-    }
+    ierr = FNEvaluateFunctionArray(nep->f[j],deg+1,x,fx+j*(deg+1));CHKERRQ(ierr);
   }
 
   /* Polynomial coefficients */
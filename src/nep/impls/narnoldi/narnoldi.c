@@ -56,6 +56,7 @@ PetscErrorCode NEPSetUp_NArnoldi(NEP nep)
 {
   PetscErrorCode ierr;
   PetscBool      istrivial;
+  PetscInt       meth;
 
   PetscFunctionBegin;
   ierr = NEPSetDimensions_Default(nep,nep->nev,&nep->ncv,&nep->mpd);CHKERRQ(ierr);
@@ -67,7 +68,8 @@ PetscErrorCode NEPSetUp_NArnoldi(NEP nep)
   if (nep->fui!=NEP_USER_INTERFACE_SPLIT) SETERRQ(PetscObjectComm((PetscObject)nep),PETSC_ERR_SUP,"NARNOLDI only available for split operator");
 
   ierr = RGIsTrivial(nep->rg,&istrivial);CHKERRQ(ierr);
-  if (!istrivial) SETERRQ(PetscObjectComm((PetscObject)nep),PETSC_ERR_SUP,"This solver does not support region filtering");
+  ierr = DSGetMethod(nep->ds,&meth);CHKERRQ(ierr);
+  if (!istrivial && !meth) SETERRQ(PetscObjectComm((PetscObject)nep),PETSC_ERR_SUP,"Region filtering requires a DS method other than the default, see DSSetMethod()");
 
   ierr = NEPAllocateSolution(nep,0);CHKERRQ(ierr);
   ierr = NEPSetWorkVecs(nep,3);CHKERRQ(ierr);
@@ -75,6 +77,7 @@ PetscErrorCode NEPSetUp_NArnoldi(NEP nep)
   /* set-up DS and transfer split operator functions */
   ierr = DSSetType(nep->ds,DSNEP);CHKERRQ(ierr);
   ierr = DSNEPSetFN(nep->ds,nep->nt,nep->f);CHKERRQ(ierr);
+  ierr = DSNEPSetRG(nep->ds,nep->rg);CHKERRQ(ierr);
   ierr = DSAllocate(nep->ds,nep->ncv);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -87,13 +90,14 @@ PetscErrorCode NEPSolve_NArnoldi(NEP nep)
   Vec                f,r=nep->work[0],x=nep->work[1],w=nep->work[2];
   PetscScalar        *X,lambda;
   PetscReal          beta,resnorm=0.0,nrm;
-  PetscInt           n;
+  PetscInt           n,meth;
   PetscBool          breakdown;
   KSPConvergedReason kspreason;
 
   PetscFunctionBegin;
   /* get initial space and shift */
   ierr = NEPGetDefaultShift(nep,&lambda);CHKERRQ(ierr);
+  ierr = DSGetMethod(nep->ds,&meth);CHKERRQ(ierr);
   if (!nep->nini) {
     ierr = BVSetRandomColumn(nep->V,0);CHKERRQ(ierr);
     ierr = BVNormColumn(nep->V,0,NORM_2,&nrm);CHKERRQ(ierr);
@@ -119,6 +123,9 @@ PetscErrorCode NEPSolve_NArnoldi(NEP nep)
     ierr = DSSetDimensions(nep->ds,n,0,0,0);CHKERRQ(ierr);
     ierr = DSSetState(nep->ds,DS_STATE_RAW);CHKERRQ(ierr);
     ierr = DSSolve(nep->ds,nep->eigr,NULL);CHKERRQ(ierr);
+    if (meth) {  /* the contour and Newton methods may return several eigenvalues */
+      ierr = DSSort(nep->ds,nep->eigr,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+    }
     lambda = nep->eigr[0];
 
     /* compute Ritz vector, x = V*s */
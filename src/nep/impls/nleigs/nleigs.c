@@ -39,6 +39,7 @@
 
 #define  LBPOINTS  100   /* default value of the maximum number of Leja-Bagby points */
 #define  NDPOINTS  1e4   /* number of discretization points */
+#define  DDCHUNK   16    /* initial number of points sampled at once in the divided differences */
 
 typedef struct {
   PetscInt       nmat;      /* number of interpolation points */
@@ -399,28 +400,40 @@ static PetscErrorCode NEPNLEIGSDividedDifferences_split(NEP nep)
 {
   PetscErrorCode ierr;
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
-  PetscInt       k,j,i,maxnmat;
+  PetscInt       k,j,i,maxnmat,nev,nc;
   PetscReal      norm0,norm,max;
-  PetscScalar    *s=ctx->s,*beta=ctx->beta,*b,alpha,*coeffs;
+  PetscScalar    *s=ctx->s,*beta=ctx->beta,*b,alpha,*coeffs,*fs;
   Mat            T,Ts;
   PetscBool      shell;
 
   PetscFunctionBegin;
   ierr = PetscMalloc1(nep->nt*ctx->ddmaxit,&ctx->coeffD);CHKERRQ(ierr);
-  ierr = PetscMalloc2(ctx->ddmaxit+1,&b,ctx->ddmaxit+1,&coeffs);CHKERRQ(ierr);
+  ierr = PetscMalloc3(ctx->ddmaxit+1,&b,ctx->ddmaxit+1,&coeffs,nep->nt*ctx->ddmaxit,&fs);CHKERRQ(ierr);
+  /* sample each function on a chunk of Leja-Bagby points with a single call, the
+     following chunks (of doubling size) are sampled only if the tolerance is not reached */
+  nev = PetscMin(DDCHUNK,ctx->ddmaxit);
+  for (j=0;j<nep->nt;j++) {
+    ierr = FNEvaluateFunctionArray(nep->f[j],nev,s,fs+j*ctx->ddmaxit);CHKERRQ(ierr);
+  }
   max = 0.0;
   for (j=0;j<nep->nt;j++) {
-    ierr = FNEvaluateFunction(nep->f[j],s[0],ctx->coeffD+j);CHKERRQ(ierr);
-    ctx->coeffD[j] /= beta[0];
+    ctx->coeffD[j] = fs[j*ctx->ddmaxit]/beta[0];
     max = PetscMax(PetscAbsScalar(ctx->coeffD[j]),max);
   }
   norm0 = max;
   ctx->nmat = ctx->ddmaxit;
   for (k=1;k<ctx->ddmaxit;k++) {
+    if (k==nev) {
+      nc = PetscMin(nev,ctx->ddmaxit-nev);
+      for (j=0;j<nep->nt;j++) {
+        ierr = FNEvaluateFunctionArray(nep->f[j],nc,s+nev,fs+nev+j*ctx->ddmaxit);CHKERRQ(ierr);
+      }
+      nev += nc;
+    }
     ierr = NEPNLEIGSEvalNRTFunct(nep,k,s[k],b);CHKERRQ(ierr);
     max = 0.0;
     for (i=0;i<nep->nt;i++) {
-      ierr = FNEvaluateFunction(nep->f[i],s[k],ctx->coeffD+k*nep->nt+i);CHKERRQ(ierr);
+      ctx->coeffD[k*nep->nt+i] = fs[k+i*ctx->ddmaxit];
       for (j=0;j<k;j++) {
         ctx->coeffD[k*nep->nt+i] -= b[j]*ctx->coeffD[i+nep->nt*j];
       }
@@ -461,7 +474,7 @@ static PetscErrorCode NEPNLEIGSDividedDifferences_split(NEP nep)
     ierr = KSPSetUp(ctx->ksp[i]);CHKERRQ(ierr);
     ierr = MatDestroy(&T);CHKERRQ(ierr);
   }
-  ierr = PetscFree2(b,coeffs);CHKERRQ(ierr);
+  ierr = PetscFree3(b,coeffs,fs);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -723,21 +736,20 @@ static PetscErrorCode NEPTOAROrth2(NEP nep,PetscScalar *S,PetscInt ld,PetscInt d
     - t: new vector extending the TOAR basis
     - r: temporally coefficients to compute the TOAR coefficients
          for the new Arnoldi vector
-  Workspace: t_ (two vectors)
+  Workspace: t_ (two vectors), work (nmat-1 scalars)
 */
-static PetscErrorCode NEPTOARExtendBasis(NEP nep,PetscInt idxrktg,PetscScalar *S,PetscInt ls,PetscInt nv,BV W,BV V,Vec t,PetscScalar *r,PetscInt lr,Vec *t_)
+static PetscErrorCode NEPTOARExtendBasis(NEP nep,PetscInt idxrktg,PetscScalar *S,PetscInt ls,PetscInt nv,BV W,BV V,Vec t,PetscScalar *r,PetscInt lr,PetscScalar *work,Vec *t_)
 {
   PetscErrorCode ierr;
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
   PetscInt       deg=ctx->nmat-1,k,j;
   Vec            v=t_[0],q=t_[1],w;
-  PetscScalar    *beta=ctx->beta,*s=ctx->s,*xi=ctx->xi,*coeffs,sigma;
+  PetscScalar    *beta=ctx->beta,*s=ctx->s,*xi=ctx->xi,*coeffs=work,sigma;
 
   PetscFunctionBegin;
   if (!ctx->ksp) { ierr = NEPNLEIGSGetKSPs(nep,&ctx->ksp);CHKERRQ(ierr); }
   sigma = ctx->shifts[idxrktg];
   ierr = BVSetActiveColumns(nep->V,0,nv);CHKERRQ(ierr);
-  ierr = PetscMalloc1(ctx->nmat-1,&coeffs);CHKERRQ(ierr);
   if (PetscAbsScalar(s[deg-2]-sigma)<100*PETSC_MACHINE_EPSILON) SETERRQ(PETSC_COMM_SELF,1,"Breakdown in NLEIGS");
   /* i-part stored in (i-1) position */
   for (j=0;j<nv;j++) {
@@ -778,7 +790,6 @@ static PetscErrorCode NEPTOARExtendBasis(NEP nep,PetscInt idxrktg,PetscScalar *S
     ierr = KSPSolve(ctx->ksp[idxrktg],q,t);CHKERRQ(ierr);
     ierr = VecScale(t,-1.0);CHKERRQ(ierr);
   }
-  ierr = PetscFree(coeffs);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -856,29 +867,37 @@ static PetscErrorCode NEPNLEIGS_RKcontinuation(NEP nep,PetscInt ini,PetscInt end
 
 /*
   Compute a run of Arnoldi iterations
+  Workspace: work (2*ld+lds+deg+(m+1)*(m+6) scalars), provided by the caller
+  so that it is not allocated again at every restart
 */
-static PetscErrorCode NEPNLEIGSTOARrun(NEP nep,PetscInt *nq,PetscScalar *S,PetscInt ld,PetscScalar *K,PetscScalar *H,PetscInt ldh,BV W,BV V,PetscInt k,PetscInt *M,PetscBool *breakdown,Vec *t_)
+static PetscErrorCode NEPNLEIGSTOARrun(NEP nep,PetscInt *nq,PetscScalar *S,PetscInt ld,PetscScalar *K,PetscScalar *H,PetscInt ldh,BV W,BV V,PetscInt k,PetscInt *M,PetscBool *breakdown,PetscScalar *work,Vec *t_)
 {
   PetscErrorCode ierr;
   NEP_NLEIGS     *ctx = (NEP_NLEIGS*)nep->data;
-  PetscInt       i,j,p,m=*M,lwa,deg=ctx->nmat-1,lds=ld*deg,nqt=*nq;
+  PetscInt       i,j,p,m=*M,deg=ctx->nmat-1,lds=ld*deg,nqt=*nq,nwu=0;
   Vec            t=t_[0];
   PetscReal      norm;
-  PetscScalar    *x,*work,*tt,sigma,*cont;
+  PetscScalar    *x,*tt,sigma,*cont,*coeffs;
   PetscBool      lindep;
 
   PetscFunctionBegin;
-  lwa = PetscMax(ld,deg)+(m+1)*(m+1)+4*(m+1);
-  ierr = PetscMalloc4(ld,&x,lwa,&work,m+1,&tt,lds,&cont);CHKERRQ(ierr);
+  x = work+nwu;
+  nwu += ld;
+  tt = work+nwu;
+  nwu += m+1;
+  cont = work+nwu;
+  nwu += lds;
+  coeffs = work+nwu;
+  nwu += deg;
   for (j=k;j<m;j++) {
     sigma = ctx->shifts[(++(ctx->idxrk))%ctx->nshiftsw];
 
     /* Continuation vector */
-    ierr = NEPNLEIGS_RKcontinuation(nep,0,j,K,H,ldh,sigma,S,lds,cont,tt,work);CHKERRQ(ierr);
+    ierr = NEPNLEIGS_RKcontinuation(nep,0,j,K,H,ldh,sigma,S,lds,cont,tt,work+nwu);CHKERRQ(ierr);
 
     /* apply operator */
     ierr = BVGetColumn(nep->V,nqt,&t);CHKERRQ(ierr);
-    ierr = NEPTOARExtendBasis(nep,(ctx->idxrk)%ctx->nshiftsw,cont,ld,nqt,W,V,t,S+(j+1)*lds,ld,t_+1);CHKERRQ(ierr);
+    ierr = NEPTOARExtendBasis(nep,(ctx->idxrk)%ctx->nshiftsw,cont,ld,nqt,W,V,t,S+(j+1)*lds,ld,coeffs,t_+1);CHKERRQ(ierr);
     ierr = BVRestoreColumn(nep->V,nqt,&t);CHKERRQ(ierr);
 
     /* orthogonalize */
@@ -889,10 +908,10 @@ static PetscErrorCode NEPNLEIGSTOARrun(NEP nep,PetscInt *nq,PetscScalar *S,Petsc
       nqt++;
     } else x[nqt] = 0.0;
 
-    ierr = NEPTOARCoefficients(nep,sigma,*nq,cont,ld,S+(j+1)*lds,ld,x,work);CHKERRQ(ierr);
+    ierr = NEPTOARCoefficients(nep,sigma,*nq,cont,ld,S+(j+1)*lds,ld,x,work+nwu);CHKERRQ(ierr);
 
     /* Level-2 orthogonalization */
-    ierr = NEPTOAROrth2(nep,S,ld,deg,j+1,H+j*ldh,&norm,breakdown,work);CHKERRQ(ierr);
+    ierr = NEPTOAROrth2(nep,S,ld,deg,j+1,H+j*ldh,&norm,breakdown,work+nwu);CHKERRQ(ierr);
     H[j+1+ldh*j] = norm;
     if (ctx->nshifts) {
       for (i=0;i<=j;i++) K[i+ldh*j] = sigma*H[i+ldh*j] + tt[i];
@@ -909,7 +928,6 @@ static PetscErrorCode NEPNLEIGSTOARrun(NEP nep,PetscInt *nq,PetscScalar *S,Petsc
       }
     }
   }
-  ierr = PetscFree4(x,work,tt,cont);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1057,7 +1075,7 @@ PetscErrorCode NEPSolve_NLEIGS(NEP nep)
     nv = PetscMin(nep->nconv+nep->mpd,nep->ncv);
     if (ctx->nshifts) { ierr = DSGetArray(nep->ds,DS_MAT_A,&K);CHKERRQ(ierr); }
     ierr = DSGetArray(nep->ds,ctx->nshifts?DS_MAT_B:DS_MAT_A,&H);CHKERRQ(ierr);
-    ierr = NEPNLEIGSTOARrun(nep,&nq,S,ld,K,H,ldds,W,nep->V,nep->nconv+l,&nv,&breakdown,nep->work);CHKERRQ(ierr);
+    ierr = NEPNLEIGSTOARrun(nep,&nq,S,ld,K,H,ldds,W,nep->V,nep->nconv+l,&nv,&breakdown,work,nep->work);CHKERRQ(ierr);
     betah = PetscAbsScalar(H[(nv-1)*ldds+nv]);
     ierr = DSRestoreArray(nep->ds,ctx->nshifts?DS_MAT_B:DS_MAT_A,&H);CHKERRQ(ierr);
     if (ctx->nshifts) {
@@ -285,7 +285,7 @@ PetscErrorCode PEPSolve_QArnoldi(PEP pep)
     if (l==0) {
       ierr = DSSetState(pep->ds,DS_STATE_INTERMEDIATE);CHKERRQ(ierr);
     } else {
-      ierr = DSSetState(pep->ds,DS_STATE_RAW);CHKERRQ(ierr);
+      ierr = DSSetState(pep->ds,DS_STATE_ARROW);CHKERRQ(ierr);
     }
     ierr = BVSetActiveColumns(pep->V,pep->nconv,nv);CHKERRQ(ierr);
 
@@ -800,7 +800,7 @@ PetscErrorCode PEPSolve_TOAR(PEP pep)
     if (l==0) {
       ierr = DSSetState(pep->ds,DS_STATE_INTERMEDIATE);CHKERRQ(ierr);
     } else {
-      ierr = DSSetState(pep->ds,DS_STATE_RAW);CHKERRQ(ierr);
+      ierr = DSSetState(pep->ds,DS_STATE_ARROW);CHKERRQ(ierr);
     }
 
     /* solve projected problem */
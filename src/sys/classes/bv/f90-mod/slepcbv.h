@@ -28,9 +28,11 @@
 
       PetscEnum BV_ORTHOG_CGS
       PetscEnum BV_ORTHOG_MGS
+      PetscEnum BV_ORTHOG_CGS_LOWSYNC
 
       parameter (BV_ORTHOG_CGS             =  0)
       parameter (BV_ORTHOG_MGS             =  1)
+      parameter (BV_ORTHOG_CGS_LOWSYNC     =  2)
 
       PetscEnum BV_ORTHOG_REFINE_IFNEEDED
       PetscEnum BV_ORTHOG_REFINE_NEVER
@@ -43,10 +45,14 @@
       PetscEnum BV_ORTHOG_BLOCK_GS
       PetscEnum BV_ORTHOG_BLOCK_CHOL
       PetscEnum BV_ORTHOG_BLOCK_TSQR
+      PetscEnum BV_ORTHOG_BLOCK_CHOLQR2
+      PetscEnum BV_ORTHOG_BLOCK_SCHOLQR3
 
       parameter (BV_ORTHOG_BLOCK_GS        =  0)
       parameter (BV_ORTHOG_BLOCK_CHOL      =  1)
       parameter (BV_ORTHOG_BLOCK_TSQR      =  2)
+      parameter (BV_ORTHOG_BLOCK_CHOLQR2   =  3)
+      parameter (BV_ORTHOG_BLOCK_SCHOLQR3  =  4)
 
       PetscEnum BV_MATMULT_VECS
       PetscEnum BV_MATMULT_MAT
@@ -56,6 +62,12 @@
       parameter (BV_MATMULT_MAT            =  1)
       parameter (BV_MATMULT_MAT_SAVE       =  2)
 
+      PetscEnum BV_PRECISION_DEFAULT
+      PetscEnum BV_PRECISION_SINGLE
+
+      parameter (BV_PRECISION_DEFAULT      =  0)
+      parameter (BV_PRECISION_SINGLE       =  1)
+
 !
 !  End of Fortran include file for the BV package in SLEPc
 !
@@ -0,0 +1,573 @@
+/*
+   BV implemented as an array of Vecs sharing a contiguous array that is
+   mapped from a scratch file, so that the basis can be larger than memory
+
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepcblaslapack.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define BLOCKSIZE 64
+
+typedef struct {
+  Vec         *V;
+  PetscScalar *array;
+  size_t      len;        /* length in bytes of the mapped region */
+  size_t      pagesize;
+  PetscBool   mpi;
+  PetscInt    window;     /* memory (in MB) used by a panel of rows in block kernels */
+  PetscInt    panel;      /* number of rows of a panel, if set it overrides window */
+  char        dir[PETSC_MAX_PATH_LEN];
+} BV_MMAP;
+
+/*
+   Create the mapping of a scratch file of m columns. The file is unlinked
+   right away so that it disappears when the mapping is released.
+*/
+static PetscErrorCode BVMMapAllocate_Private(BV bv,PetscInt m,PetscScalar **array,size_t *len)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  char           fname[PETSC_MAX_PATH_LEN];
+  int            fd;
+  void           *p;
+
+  PetscFunctionBegin;
+  *len = (size_t)PetscMax(m*bv->n,1)*sizeof(PetscScalar);
+  ierr = PetscSNPrintf(fname,PETSC_MAX_PATH_LEN,"%s/slepc-bv-XXXXXX",ctx->dir);CHKERRQ(ierr);
+  fd = mkstemp(fname);
+  if (fd<0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to create scratch file %s",fname);
+  unlink(fname);
+  if (ftruncate(fd,(off_t)*len)) {
+    close(fd);
+    SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Unable to allocate %D bytes in scratch file",(PetscInt)*len);
+  }
+  p = mmap(NULL,*len,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+  close(fd);
+  if (p==MAP_FAILED) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to map scratch file");
+  /* columns are mostly traversed sequentially, ask for aggressive read-ahead */
+  madvise(p,*len,MADV_SEQUENTIAL);
+  *array = (PetscScalar*)p;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode BVMMapFree_Private(PetscScalar **array,size_t len)
+{
+  PetscFunctionBegin;
+  if (*array && munmap((void*)*array,len)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to unmap scratch file");
+  *array = NULL;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Number of rows of a panel of ncols columns that fits in the window, or the
+   value given with -bv_mmap_panel (mainly for testing the multi-panel code)
+*/
+PETSC_STATIC_INLINE PetscInt BVMMapPanelRows(BV bv,PetscInt ncols)
+{
+  BV_MMAP  *ctx = (BV_MMAP*)bv->data;
+  PetscInt rows;
+
+  if (ctx->panel>0) rows = ctx->panel;
+  else {
+    rows = (PetscInt)((ctx->window*1048576.0)/(PetscMax(ncols,1)*sizeof(PetscScalar)));
+    rows = PetscMax(rows,BLOCKSIZE);
+  }
+  return PetscMin(rows,PetscMax(bv->n,1));
+}
+
+/*
+   Request that rows r:r+rb-1 of nc consecutive columns starting at A be
+   brought into memory, so that the next panel is read while computing
+*/
+PETSC_STATIC_INLINE void BVMMapPrefetch(BV bv,PetscScalar *A,PetscInt nc,PetscInt r,PetscInt rb)
+{
+  BV_MMAP   *ctx = (BV_MMAP*)bv->data;
+  PetscInt  c;
+  size_t    start,end;
+
+  for (c=0;c<nc;c++) {
+    start = (size_t)(A+c*bv->n+r) & ~(ctx->pagesize-1);
+    end   = (size_t)(A+c*bv->n+r+rb);
+    madvise((void*)start,end-start,MADV_WILLNEED);
+  }
+}
+
+PetscErrorCode BVMult_MMap(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *y = (BV_MMAP*)Y->data,*x = (BV_MMAP*)X->data;
+  PetscScalar    *q,*px,*py;
+  PetscInt       r,rb,rows,ldq,nx=X->k-X->l,ny=Y->k-Y->l;
+  PetscBLASInt   m_,n_,k_,ld_,ldq_;
+
+  PetscFunctionBegin;
+  px = x->array+(X->nc+X->l)*X->n;
+  py = y->array+(Y->nc+Y->l)*Y->n;
+  if (Q) {
+    ierr = MatGetSize(Q,&ldq,NULL);CHKERRQ(ierr);
+    ierr = MatDenseGetArray(Q,&q);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(ny,&n_);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(nx,&k_);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(Y->n,&ld_);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(ldq,&ldq_);CHKERRQ(ierr);
+    rows = BVMMapPanelRows(Y,nx+ny);
+    for (r=0;r<Y->n;r+=rows) {
+      rb = PetscMin(rows,Y->n-r);
+      if (r+rb<Y->n) {
+        BVMMapPrefetch(X,px,nx,r+rb,PetscMin(rows,Y->n-r-rb));
+        BVMMapPrefetch(Y,py,ny,r+rb,PetscMin(rows,Y->n-r-rb));
+      }
+      ierr = PetscBLASIntCast(rb,&m_);CHKERRQ(ierr);
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&m_,&n_,&k_,&alpha,px+r,&ld_,q+Y->l*ldq+X->l,&ldq_,&beta,py+r,&ld_));
+    }
+    ierr = PetscLogFlops(2.0*Y->n*nx*ny);CHKERRQ(ierr);
+    ierr = MatDenseRestoreArray(Q,&q);CHKERRQ(ierr);
+  } else {
+    ierr = BVAXPY_BLAS_Private(Y,Y->n,ny,alpha,px,beta,py);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVMultVec_MMap(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *x = (BV_MMAP*)X->data;
+  PetscScalar    *py,*qq=q;
+
+  PetscFunctionBegin;
+  ierr = VecGetArray(y,&py);CHKERRQ(ierr);
+  if (!q) { ierr = VecGetArray(X->buffer,&qq);CHKERRQ(ierr); }
+  ierr = BVMultVec_BLAS_Private(X,X->n,X->k-X->l,alpha,x->array+(X->nc+X->l)*X->n,qq,beta,py);CHKERRQ(ierr);
+  if (!q) { ierr = VecRestoreArray(X->buffer,&qq);CHKERRQ(ierr); }
+  ierr = VecRestoreArray(y,&py);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   V(:,s:e-1) = V(:,l:k-1)*Q, processed by panels of rows that are computed
+   in a work buffer and then written back
+*/
+static PetscErrorCode BVMultInPlace_MMap_Private(BV V,Mat Q,PetscInt s,PetscInt e,PetscBool trans)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)V->data;
+  PetscScalar    *q,*pq,*pv,zero=0.0,one=1.0;
+  PetscInt       r,rb,j,rows,ldq,nk=V->k-V->l,ne=e-s;
+  PetscBLASInt   m_,n_,k_,ld_,ldq_;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(Q,&ldq,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ne,&n_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(nk,&k_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(V->n,&ld_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldq,&ldq_);CHKERRQ(ierr);
+  rows = BVMMapPanelRows(V,nk+ne);
+  ierr = BVAllocateWork_Private(V,rows*ne);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(Q,&q);CHKERRQ(ierr);
+  pq = trans? q+V->l*ldq+s: q+s*ldq+V->l;
+  pv = ctx->array+(V->nc+V->l)*V->n;
+  for (r=0;r<V->n;r+=rows) {
+    rb = PetscMin(rows,V->n-r);
+    if (r+rb<V->n) BVMMapPrefetch(V,pv,nk,r+rb,PetscMin(rows,V->n-r-rb));
+    ierr = PetscBLASIntCast(rb,&m_);CHKERRQ(ierr);
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N",trans?"C":"N",&m_,&n_,&k_,&one,pv+r,&ld_,pq,&ldq_,&zero,V->work,&m_));
+    for (j=0;j<ne;j++) {
+      ierr = PetscMemcpy(ctx->array+(V->nc+s+j)*V->n+r,V->work+j*rb,rb*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+  }
+  ierr = MatDenseRestoreArray(Q,&q);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*V->n*ne*nk);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVMultInPlace_MMap(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = BVMultInPlace_MMap_Private(V,Q,s,e,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVMultInPlaceTranspose_MMap(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = BVMultInPlace_MMap_Private(V,Q,s,e,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   M = Y'*X, the local products of all panels are accumulated before the
+   reduction so that there is a single global communication
+*/
+PetscErrorCode BVDot_MMap(BV X,BV Y,Mat M)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *x = (BV_MMAP*)X->data,*y = (BV_MMAP*)Y->data;
+  PetscScalar    *m,*px,*py,*C,*CC,zero=0.0,one=1.0;
+  PetscReal      rzero=0.0,rone=1.0;
+  PetscInt       r,rb,j,rows,ldm,nx=X->k-X->l,ny=Y->k-Y->l;
+  PetscBLASInt   m_,n_,k_,ld_;
+  PetscMPIInt    len;
+  PetscBool      same;
+
+  PetscFunctionBegin;
+  same = (X==Y)? PETSC_TRUE: PETSC_FALSE;
+  ierr = PetscBLASIntCast(ny,&m_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(nx,&n_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(X->n,&ld_);CHKERRQ(ierr);
+  ierr = BVAllocateWork_Private(X,2*nx*ny+nx);CHKERRQ(ierr);
+  C  = X->work;
+  CC = X->work+nx*ny;
+  ierr = PetscMemzero(C,nx*ny*sizeof(PetscScalar));CHKERRQ(ierr);
+  px = x->array+(X->nc+X->l)*X->n;
+  py = y->array+(Y->nc+Y->l)*Y->n;
+  rows = BVMMapPanelRows(X,nx+ny);
+  for (r=0;r<X->n;r+=rows) {
+    rb = PetscMin(rows,X->n-r);
+    if (r+rb<X->n) {
+      BVMMapPrefetch(X,px,nx,r+rb,PetscMin(rows,X->n-r-rb));
+      if (!same) BVMMapPrefetch(Y,py,ny,r+rb,PetscMin(rows,X->n-r-rb));
+    }
+    ierr = PetscBLASIntCast(rb,&k_);CHKERRQ(ierr);
+    if (same) PetscStackCallBLAS("BLASsyrk",BLASsyrk_("U","C",&n_,&k_,&rone,px+r,&ld_,r?&rone:&rzero,C,&n_));
+    else PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&m_,&n_,&k_,&one,py+r,&ld_,px+r,&ld_,r?&one:&zero,C,&m_));
+  }
+  ierr = MatGetSize(M,&ldm,NULL);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(M,&m);CHKERRQ(ierr);
+  if (same) {
+    /* Gram matrix: only the upper triangle is computed and reduced */
+    ierr = PetscLogFlops(1.0*X->n*nx*(nx+1));CHKERRQ(ierr);
+    ierr = BVDotHermitianReduce_Private(X,nx,C,CC,m+X->l*ldm+X->l,ldm,x->mpi);CHKERRQ(ierr);
+  } else {
+    ierr = PetscLogFlops(2.0*X->n*nx*ny);CHKERRQ(ierr);
+    if (x->mpi) {
+      ierr = PetscMPIIntCast(nx*ny,&len);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(C,CC,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)X));CHKERRQ(ierr);
+    } else CC = C;
+    for (j=0;j<nx;j++) {
+      ierr = PetscMemcpy(m+(X->l+j)*ldm+Y->l,CC+j*ny,ny*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+  }
+  ierr = MatDenseRestoreArray(M,&m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDotVec_MMap(BV X,Vec y,PetscScalar *q)
+{
+  PetscErrorCode    ierr;
+  BV_MMAP           *x = (BV_MMAP*)X->data;
+  const PetscScalar *py;
+  PetscScalar       *qq=q;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (X->matrix) {
+    ierr = BV_IPMatMult(X,y);CHKERRQ(ierr);
+    z = X->Bx;
+  }
+  ierr = VecGetArrayRead(z,&py);CHKERRQ(ierr);
+  if (!q) { ierr = VecGetArray(X->buffer,&qq);CHKERRQ(ierr); }
+  ierr = BVDotVec_BLAS_Private(X,X->n,X->k-X->l,x->array+(X->nc+X->l)*X->n,py,qq,x->mpi);CHKERRQ(ierr);
+  if (!q) { ierr = VecRestoreArray(X->buffer,&qq);CHKERRQ(ierr); }
+  ierr = VecRestoreArrayRead(z,&py);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDotVec_Local_MMap(BV X,Vec y,PetscScalar *m)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *x = (BV_MMAP*)X->data;
+  PetscScalar    *py;
+  Vec            z = y;
+
+  PetscFunctionBegin;
+  if (X->matrix) {
+    ierr = BV_IPMatMult(X,y);CHKERRQ(ierr);
+    z = X->Bx;
+  }
+  ierr = VecGetArray(z,&py);CHKERRQ(ierr);
+  ierr = BVDotVec_BLAS_Private(X,X->n,X->k-X->l,x->array+(X->nc+X->l)*X->n,py,m,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = VecRestoreArray(z,&py);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVScale_MMap(BV bv,PetscInt j,PetscScalar alpha)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (j<0) {
+    ierr = BVScale_BLAS_Private(bv,(bv->k-bv->l)*bv->n,ctx->array+(bv->nc+bv->l)*bv->n,alpha);CHKERRQ(ierr);
+  } else {
+    ierr = BVScale_BLAS_Private(bv,bv->n,ctx->array+(bv->nc+j)*bv->n,alpha);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVNorm_MMap(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (j<0) {
+    ierr = BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,ctx->array+(bv->nc+bv->l)*bv->n,type,val,ctx->mpi);CHKERRQ(ierr);
+  } else {
+    ierr = BVNorm_LAPACK_Private(bv,bv->n,1,ctx->array+(bv->nc+j)*bv->n,type,val,ctx->mpi);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVNorm_Local_MMap(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (j<0) {
+    ierr = BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,ctx->array+(bv->nc+bv->l)*bv->n,type,val,PETSC_FALSE);CHKERRQ(ierr);
+  } else {
+    ierr = BVNorm_LAPACK_Private(bv,bv->n,1,ctx->array+(bv->nc+j)*bv->n,type,val,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The product is done column by column, since a single matrix-matrix product
+   would require the whole block to be resident in memory
+*/
+PetscErrorCode BVMatMult_MMap(BV V,Mat A,BV W)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *v = (BV_MMAP*)V->data,*w = (BV_MMAP*)W->data;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  for (j=0;j<V->k-V->l;j++) {
+    ierr = MatMult(A,v->V[V->nc+V->l+j],w->V[W->nc+W->l+j]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVCopy_MMap(BV V,BV W)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *v = (BV_MMAP*)V->data,*w = (BV_MMAP*)W->data;
+  PetscScalar    *pvc,*pwc;
+
+  PetscFunctionBegin;
+  pvc = v->array+(V->nc+V->l)*V->n;
+  pwc = w->array+(W->nc+W->l)*W->n;
+  ierr = PetscMemcpy(pwc,pvc,(V->k-V->l)*V->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode BVMMapCreateVecs_Private(BV bv,PetscInt m,PetscScalar *array,Vec **V)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  PetscInt       j,bs;
+  char           str[50];
+
+  PetscFunctionBegin;
+  ierr = VecGetBlockSize(bv->t,&bs);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m,V);CHKERRQ(ierr);
+  for (j=0;j<m;j++) {
+    if (ctx->mpi) {
+      ierr = VecCreateMPIWithArray(PetscObjectComm((PetscObject)bv->t),bs,bv->n,PETSC_DECIDE,array+j*bv->n,*V+j);CHKERRQ(ierr);
+    } else {
+      ierr = VecCreateSeqWithArray(PetscObjectComm((PetscObject)bv->t),bs,bv->n,array+j*bv->n,*V+j);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscLogObjectParents(bv,m,*V);CHKERRQ(ierr);
+  if (((PetscObject)bv)->name) {
+    for (j=0;j<m;j++) {
+      ierr = PetscSNPrintf(str,50,"%s_%d",((PetscObject)bv)->name,(int)j);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject)(*V)[j],str);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVResize_MMap(BV bv,PetscInt m,PetscBool copy)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  PetscScalar    *newarray;
+  size_t         newlen;
+  Vec            *newV;
+
+  PetscFunctionBegin;
+  ierr = BVMMapAllocate_Private(bv,m,&newarray,&newlen);CHKERRQ(ierr);
+  ierr = BVMMapCreateVecs_Private(bv,m,newarray,&newV);CHKERRQ(ierr);
+  if (copy) {
+    ierr = PetscMemcpy(newarray,ctx->array,PetscMin(m,bv->m)*bv->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  ierr = VecDestroyVecs(bv->m,&ctx->V);CHKERRQ(ierr);
+  ctx->V = newV;
+  ierr = BVMMapFree_Private(&ctx->array,ctx->len);CHKERRQ(ierr);
+  ctx->array = newarray;
+  ctx->len   = newlen;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVGetColumn_MMap(BV bv,PetscInt j,Vec *v)
+{
+  BV_MMAP  *ctx = (BV_MMAP*)bv->data;
+  PetscInt l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  bv->cv[l] = ctx->V[bv->nc+j];
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVGetArray_MMap(BV bv,PetscScalar **a)
+{
+  BV_MMAP *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  *a = ctx->array;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVGetArrayRead_MMap(BV bv,const PetscScalar **a)
+{
+  BV_MMAP *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  *a = ctx->array;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVSetFromOptions_MMap(PetscOptionItems *PetscOptionsObject,BV bv)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"BV MMap Options");CHKERRQ(ierr);
+
+    ierr = PetscOptionsString("-bv_mmap_dir","Directory where the scratch files are created","",ctx->dir,ctx->dir,PETSC_MAX_PATH_LEN,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsInt("-bv_mmap_window","Memory (in MB) used by a panel of rows in block operations","",ctx->window,&ctx->window,NULL);CHKERRQ(ierr);
+    if (ctx->window<1) SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"The window size must be positive");
+    ierr = PetscOptionsInt("-bv_mmap_panel","Number of rows of a panel in block operations (overrides the window)","",ctx->panel,&ctx->panel,NULL);CHKERRQ(ierr);
+
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDestroy_MMap(BV bv)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  ierr = VecDestroyVecs(bv->nc+bv->m,&ctx->V);CHKERRQ(ierr);
+  ierr = BVMMapFree_Private(&ctx->array,ctx->len);CHKERRQ(ierr);
+  ierr = PetscFree(bv->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDuplicate_MMap(BV V,BV *W)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *v = (BV_MMAP*)V->data,*w = (BV_MMAP*)(*W)->data;
+
+  PetscFunctionBegin;
+  ierr = PetscStrcpy(w->dir,v->dir);CHKERRQ(ierr);
+  w->window = v->window;
+  w->panel  = v->panel;
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode BVCreate_MMap(BV bv)
+{
+  PetscErrorCode ierr;
+  BV_MMAP        *ctx;
+  PetscBool      seq;
+  PetscScalar    *aa;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(bv,&ctx);CHKERRQ(ierr);
+  bv->data = (void*)ctx;
+
+  ierr = PetscObjectTypeCompare((PetscObject)bv->t,VECMPI,&ctx->mpi);CHKERRQ(ierr);
+  if (!ctx->mpi) {
+    ierr = PetscObjectTypeCompare((PetscObject)bv->t,VECSEQ,&seq);CHKERRQ(ierr);
+    if (!seq) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot create a mmap BV from a non-standard template vector");
+  }
+
+  ctx->pagesize = (size_t)sysconf(_SC_PAGESIZE);
+  ctx->window   = 64;
+  ierr = PetscGetTmp(PetscObjectComm((PetscObject)bv),ctx->dir,PETSC_MAX_PATH_LEN);CHKERRQ(ierr);
+  /* global values are also used for BV objects created internally, without options prefix */
+  ierr = PetscOptionsGetString(NULL,NULL,"-bv_mmap_dir",ctx->dir,PETSC_MAX_PATH_LEN,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bv_mmap_window",&ctx->window,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bv_mmap_panel",&ctx->panel,NULL);CHKERRQ(ierr);
+
+  /* Deferred call to setfromoptions */
+  if (bv->defersfo) {
+    ierr = PetscObjectOptionsBegin((PetscObject)bv);CHKERRQ(ierr);
+    ierr = BVSetFromOptions_MMap(PetscOptionsObject,bv);CHKERRQ(ierr);
+    ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  }
+
+  ierr = BVMMapAllocate_Private(bv,bv->m,&ctx->array,&ctx->len);CHKERRQ(ierr);
+  ierr = BVMMapCreateVecs_Private(bv,bv->m,ctx->array,&ctx->V);CHKERRQ(ierr);
+
+  if (bv->Acreate) {
+    ierr = MatDenseGetArray(bv->Acreate,&aa);CHKERRQ(ierr);
+    ierr = PetscMemcpy(ctx->array,aa,bv->m*bv->n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = MatDenseRestoreArray(bv->Acreate,&aa);CHKERRQ(ierr);
+    ierr = MatDestroy(&bv->Acreate);CHKERRQ(ierr);
+  }
+
+  bv->ops->mult             = BVMult_MMap;
+  bv->ops->multvec          = BVMultVec_MMap;
+  bv->ops->multinplace      = BVMultInPlace_MMap;
+  bv->ops->multinplacetrans = BVMultInPlaceTranspose_MMap;
+  bv->ops->dot              = BVDot_MMap;
+  bv->ops->dotvec           = BVDotVec_MMap;
+  bv->ops->dotvec_local     = BVDotVec_Local_MMap;
+  bv->ops->scale            = BVScale_MMap;
+  bv->ops->norm             = BVNorm_MMap;
+  bv->ops->norm_local       = BVNorm_Local_MMap;
+  bv->ops->matmult          = BVMatMult_MMap;
+  bv->ops->copy             = BVCopy_MMap;
+  bv->ops->resize           = BVResize_MMap;
+  bv->ops->getcolumn        = BVGetColumn_MMap;
+  bv->ops->getarray         = BVGetArray_MMap;
+  bv->ops->getarrayread     = BVGetArrayRead_MMap;
+  bv->ops->destroy          = BVDestroy_MMap;
+  bv->ops->duplicate        = BVDuplicate_MMap;
+  bv->ops->setfromoptions   = BVSetFromOptions_MMap;
+  PetscFunctionReturn(0);
+}
+
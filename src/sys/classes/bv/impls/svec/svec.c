@@ -433,6 +433,16 @@ PETSC_EXTERN PetscErrorCode BVCreate_Svec(BV bv)
   ierr = PetscObjectTypeCompare((PetscObject)bv->t,VECSEQ,&seq);CHKERRQ(ierr);
   if (!seq && !ctx->mpi && !ctx->cuda) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"BVSVEC does not support the type of the provided template vector");
 
+  if (bv->precision==BV_PRECISION_SINGLE) {
+#if defined(PETSC_USE_REAL_DOUBLE)
+    if (!ctx->cuda) {
+      ierr = BVCreate_Svec_Single(bv);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+#endif
+    ierr = PetscInfo(bv,"Single precision storage is not available in this case, entries are stored in the working precision\n");CHKERRQ(ierr);
+  }
+
   ierr = VecGetLocalSize(bv->t,&nloc);CHKERRQ(ierr);
   ierr = VecGetBlockSize(bv->t,&bs);CHKERRQ(ierr);
 
@@ -23,9 +23,13 @@
 #define __SVECIMPL_H
 
 typedef struct {
-  Vec       v;
-  PetscBool mpi;    /* true if either VECMPI or VECMPICUSP */
-  PetscBool cuda;   /* true if either VECSEQCUDA or VECMPICUDA */
+  Vec         v;
+  PetscBool   mpi;    /* true if either VECMPI or VECMPICUSP */
+  PetscBool   cuda;   /* true if either VECSEQCUDA or VECMPICUDA */
+  float       *s;     /* storage in single precision, used instead of v */
+  PetscScalar *a;     /* working precision copy of s, for BVGetArray() */
+  PetscInt    na;     /* allocated length of a */
+  Vec         z;      /* work vector in the working precision, for BVMatMult() */
 } BV_SVEC;
 
 PETSC_INTERN PetscErrorCode BVMult_Svec_CUDA(BV,PetscScalar,PetscScalar,BV,Mat);
@@ -42,5 +46,8 @@ PETSC_INTERN PetscErrorCode BVResize_Svec_CUDA(BV,PetscInt,PetscBool);
 PETSC_INTERN PetscErrorCode BVGetColumn_Svec_CUDA(BV,PetscInt,Vec*);
 PETSC_INTERN PetscErrorCode BVRestoreColumn_Svec_CUDA(BV,PetscInt,Vec*);
 
+#if defined(PETSC_USE_REAL_DOUBLE)
+PETSC_INTERN PetscErrorCode BVCreate_Svec_Single(BV);
 #endif
 
+#endif
@@ -0,0 +1,683 @@
+/*
+   BV implemented as a single array of single precision entries
+
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepcblaslapack.h>
+#include "./svecimpl.h"
+
+#if defined(PETSC_USE_REAL_DOUBLE)
+
+/*
+   The entries are stored column-wise as in BVSVEC, but in single precision
+   (real and imaginary parts interleaved in complex scalars). All kernels
+   proceed by blocks of BLOCKSIZE rows that are converted to the working
+   precision, so that BLAS operates in double precision on small buffers and
+   the basis is read from memory in single precision only once.
+*/
+
+#define BLOCKSIZE 64
+
+#if defined(PETSC_USE_COMPLEX)
+#define NF 2   /* floats per scalar */
+#else
+#define NF 1
+#endif
+
+/* pointer to the first entry of column j (which may be a constraint) */
+#define BVSingleColumn(bv,s,j) ((s)+((bv)->nc+(j))*(bv)->n*NF)
+
+#define BVCheckSingle(bv,arg) \
+  do { \
+    if (!((BV_SVEC*)(bv)->data)->s) SETERRQ1(PetscObjectComm((PetscObject)(bv)),PETSC_ERR_ARG_INCOMP,"Mixing BV objects with different precision, argument # %d",arg); \
+  } while (0)
+
+PETSC_STATIC_INLINE void BVSingleToScalar(PetscInt n,const float *s,PetscScalar *a)
+{
+  PetscInt i;
+
+#if defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) a[i] = (PetscReal)s[2*i] + PETSC_i*(PetscReal)s[2*i+1];
+#else
+  for (i=0;i<n;i++) a[i] = (PetscScalar)s[i];
+#endif
+}
+
+PETSC_STATIC_INLINE void BVScalarToSingle(PetscInt n,const PetscScalar *a,float *s)
+{
+  PetscInt i;
+
+#if defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) {
+    s[2*i]   = (float)PetscRealPart(a[i]);
+    s[2*i+1] = (float)PetscImaginaryPart(a[i]);
+  }
+#else
+  for (i=0;i<n;i++) s[i] = (float)a[i];
+#endif
+}
+
+/*
+   Copy rows r:r+rb-1 of columns j:j+nc-1 to buffer a (ld=rb), and vice versa
+*/
+PETSC_STATIC_INLINE void BVSingleGetBlock(BV bv,const float *s,PetscInt j,PetscInt nc,PetscInt r,PetscInt rb,PetscScalar *a)
+{
+  PetscInt c;
+
+  for (c=0;c<nc;c++) BVSingleToScalar(rb,BVSingleColumn(bv,s,j+c)+r*NF,a+c*rb);
+}
+
+PETSC_STATIC_INLINE void BVSingleSetBlock(BV bv,float *s,PetscInt j,PetscInt nc,PetscInt r,PetscInt rb,const PetscScalar *a)
+{
+  PetscInt c;
+
+  for (c=0;c<nc;c++) BVScalarToSingle(rb,a+c*rb,BVSingleColumn(bv,s,j+c)+r*NF);
+}
+
+PetscErrorCode BVMult_Svec_Single(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *y = (BV_SVEC*)Y->data,*x = (BV_SVEC*)X->data;
+  PetscScalar    *q=NULL,*A,*C;
+  PetscInt       r,rb,ldq,nx=X->k-X->l,ny=Y->k-Y->l;
+
+  PetscFunctionBegin;
+  BVCheckSingle(X,4);
+  ierr = BVAllocateWork_Private(Y,BLOCKSIZE*(nx+ny));CHKERRQ(ierr);
+  A = Y->work;
+  C = Y->work+BLOCKSIZE*nx;
+  if (Q) {
+    ierr = MatGetSize(Q,&ldq,NULL);CHKERRQ(ierr);
+    ierr = MatDenseGetArray(Q,&q);CHKERRQ(ierr);
+  }
+  for (r=0;r<Y->n;r+=BLOCKSIZE) {
+    rb = PetscMin(BLOCKSIZE,Y->n-r);
+    BVSingleGetBlock(X,x->s,X->l,nx,r,rb,A);
+    if (beta!=(PetscScalar)0.0) BVSingleGetBlock(Y,y->s,Y->l,ny,r,rb,C);
+    else { ierr = PetscMemzero(C,rb*ny*sizeof(PetscScalar));CHKERRQ(ierr); }
+    if (Q) {
+      ierr = BVMult_BLAS_Private(Y,rb,ny,nx,ldq,alpha,A,q+Y->l*ldq+X->l,beta,C);CHKERRQ(ierr);
+    } else {
+      ierr = BVAXPY_BLAS_Private(Y,rb,ny,alpha,A,beta,C);CHKERRQ(ierr);
+    }
+    BVSingleSetBlock(Y,y->s,Y->l,ny,r,rb,C);
+  }
+  if (Q) { ierr = MatDenseRestoreArray(Q,&q);CHKERRQ(ierr); }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVMultVec_Svec_Single(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *x = (BV_SVEC*)X->data;
+  PetscScalar    *py,*qq=q,*A;
+  PetscInt       r,rb,nx=X->k-X->l;
+
+  PetscFunctionBegin;
+  ierr = BVAllocateWork_Private(X,BLOCKSIZE*nx);CHKERRQ(ierr);
+  A = X->work;
+  ierr = VecGetArray(y,&py);CHKERRQ(ierr);
+  if (!q) { ierr = VecGetArray(X->buffer,&qq);CHKERRQ(ierr); }
+  for (r=0;r<X->n;r+=BLOCKSIZE) {
+    rb = PetscMin(BLOCKSIZE,X->n-r);
+    BVSingleGetBlock(X,x->s,X->l,nx,r,rb,A);
+    ierr = BVMultVec_BLAS_Private(X,rb,nx,alpha,A,qq,beta,py+r);CHKERRQ(ierr);
+  }
+  if (!q) { ierr = VecRestoreArray(X->buffer,&qq);CHKERRQ(ierr); }
+  ierr = VecRestoreArray(y,&py);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode BVMultInPlace_Single_Private(BV V,Mat Q,PetscInt s,PetscInt e,PetscBool trans)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)V->data;
+  PetscScalar    *q,*pq,*A,*C,zero=0.0,one=1.0;
+  PetscInt       r,bs,ldq,nk=V->k-V->l,ne=e-s;
+  PetscBLASInt   rb_,n_,k_,ldq_;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(Q,&ldq,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ne,&n_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(nk,&k_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldq,&ldq_);CHKERRQ(ierr);
+  bs = BVMultInPlaceRows_Private(V,V->n,nk,ne);
+  ierr = BVAllocateWork_Private(V,bs*(nk+ne));CHKERRQ(ierr);
+  A = V->work;
+  C = V->work+bs*nk;
+  ierr = MatDenseGetArray(Q,&q);CHKERRQ(ierr);
+  pq = trans? q+V->l*ldq+s: q+s*ldq+V->l;
+  for (r=0;r<V->n;r+=bs) {
+    ierr = PetscBLASIntCast(PetscMin(bs,V->n-r),&rb_);CHKERRQ(ierr);
+    BVSingleGetBlock(V,ctx->s,V->l,nk,r,rb_,A);
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N",trans?"C":"N",&rb_,&n_,&k_,&one,A,&rb_,pq,&ldq_,&zero,C,&rb_));
+    BVSingleSetBlock(V,ctx->s,s,ne,r,rb_,C);
+  }
+  ierr = MatDenseRestoreArray(Q,&q);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*V->n*ne*nk);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVMultInPlace_Svec_Single(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = BVMultInPlace_Single_Private(V,Q,s,e,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVMultInPlaceTranspose_Svec_Single(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = BVMultInPlace_Single_Private(V,Q,s,e,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDot_Svec_Single(BV X,BV Y,Mat M)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *x = (BV_SVEC*)X->data,*y = (BV_SVEC*)Y->data;
+  PetscScalar    *m,*A,*B,*C,*CC,one=1.0;
+  PetscReal      rone=1.0;
+  PetscInt       r,j,ldm,nx=X->k-X->l,ny=Y->k-Y->l;
+  PetscBLASInt   rb_,m_,n_;
+  PetscMPIInt    len;
+  PetscBool      same;
+
+  PetscFunctionBegin;
+  BVCheckSingle(Y,2);
+  same = (X==Y)? PETSC_TRUE: PETSC_FALSE;
+  ierr = PetscBLASIntCast(ny,&m_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(nx,&n_);CHKERRQ(ierr);
+  ierr = BVAllocateWork_Private(X,BLOCKSIZE*(nx+ny)+2*nx*ny+nx);CHKERRQ(ierr);
+  B  = X->work;
+  A  = same? B: X->work+BLOCKSIZE*nx;
+  C  = X->work+BLOCKSIZE*(nx+ny);
+  CC = C+nx*ny;
+  ierr = PetscMemzero(C,nx*ny*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (r=0;r<X->n;r+=BLOCKSIZE) {
+    ierr = PetscBLASIntCast(PetscMin(BLOCKSIZE,X->n-r),&rb_);CHKERRQ(ierr);
+    BVSingleGetBlock(X,x->s,X->l,nx,r,rb_,B);
+    if (same) PetscStackCallBLAS("BLASsyrk",BLASsyrk_("U","C",&n_,&rb_,&rone,B,&rb_,&rone,C,&n_));
+    else {
+      BVSingleGetBlock(Y,y->s,Y->l,ny,r,rb_,A);
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&m_,&n_,&rb_,&one,A,&rb_,B,&rb_,&one,C,&m_));
+    }
+  }
+  ierr = MatGetSize(M,&ldm,NULL);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(M,&m);CHKERRQ(ierr);
+  if (same) {
+    /* Gram matrix: only the upper triangle is computed and reduced */
+    ierr = PetscLogFlops(1.0*X->n*nx*(nx+1));CHKERRQ(ierr);
+    ierr = BVDotHermitianReduce_Private(X,nx,C,CC,m+X->l*ldm+X->l,ldm,x->mpi);CHKERRQ(ierr);
+  } else {
+    ierr = PetscLogFlops(2.0*X->n*nx*ny);CHKERRQ(ierr);
+    if (x->mpi) {
+      ierr = PetscMPIIntCast(nx*ny,&len);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(C,CC,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)X));CHKERRQ(ierr);
+    } else CC = C;
+    for (j=0;j<nx;j++) {
+      ierr = PetscMemcpy(m+(X->l+j)*ldm+Y->l,CC+j*ny,ny*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+  }
+  ierr = MatDenseRestoreArray(M,&m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   q = X'*z on the local part, where z=B*y if there is an inner product matrix
+*/
+static PetscErrorCode BVDotVec_Single_Private(BV X,Vec y,PetscScalar *q)
+{
+  PetscErrorCode    ierr;
+  BV_SVEC           *x = (BV_SVEC*)X->data;
+  const PetscScalar *py;
+  PetscScalar       *A,one=1.0;
+  PetscInt          r,nx=X->k-X->l;
+  PetscBLASInt      rb_,n_,inc=1;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (X->matrix) {
+    ierr = BV_IPMatMult(X,y);CHKERRQ(ierr);
+    z = X->Bx;
+  }
+  ierr = PetscBLASIntCast(nx,&n_);CHKERRQ(ierr);
+  ierr = BVAllocateWork_Private(X,BLOCKSIZE*nx);CHKERRQ(ierr);
+  A = X->work;
+  ierr = PetscMemzero(q,nx*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecGetArrayRead(z,&py);CHKERRQ(ierr);
+  for (r=0;r<X->n;r+=BLOCKSIZE) {
+    ierr = PetscBLASIntCast(PetscMin(BLOCKSIZE,X->n-r),&rb_);CHKERRQ(ierr);
+    BVSingleGetBlock(X,x->s,X->l,nx,r,rb_,A);
+    PetscStackCallBLAS("BLASgemv",BLASgemv_("C",&rb_,&n_,&one,A,&rb_,(PetscScalar*)py+r,&inc,&one,q,&inc));
+  }
+  ierr = VecRestoreArrayRead(z,&py);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*X->n*nx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDotVec_Svec_Single(BV X,Vec y,PetscScalar *q)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *x = (BV_SVEC*)X->data;
+  PetscScalar    *qq=q,*lq;
+  PetscInt       nx=X->k-X->l;
+  PetscMPIInt    len;
+
+  PetscFunctionBegin;
+  if (!q) { ierr = VecGetArray(X->buffer,&qq);CHKERRQ(ierr); }
+  if (x->mpi) {
+    ierr = PetscMalloc1(nx,&lq);CHKERRQ(ierr);
+    ierr = BVDotVec_Single_Private(X,y,lq);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(nx,&len);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(lq,qq,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)X));CHKERRQ(ierr);
+    ierr = PetscFree(lq);CHKERRQ(ierr);
+  } else {
+    ierr = BVDotVec_Single_Private(X,y,qq);CHKERRQ(ierr);
+  }
+  if (!q) { ierr = VecRestoreArray(X->buffer,&qq);CHKERRQ(ierr); }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDotVec_Local_Svec_Single(BV X,Vec y,PetscScalar *m)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = BVDotVec_Single_Private(X,y,m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVScale_Svec_Single(BV bv,PetscInt j,PetscScalar alpha)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *A;
+  float          *s;
+  PetscInt       i,n;
+
+  PetscFunctionBegin;
+  if (j<0) {
+    s = BVSingleColumn(bv,ctx->s,bv->l);
+    n = (bv->k-bv->l)*bv->n;
+  } else {
+    s = BVSingleColumn(bv,ctx->s,j);
+    n = bv->n;
+  }
+  if (alpha == (PetscScalar)0.0) {
+    ierr = PetscMemzero(s,n*NF*sizeof(float));CHKERRQ(ierr);
+  } else if (alpha!=(PetscScalar)1.0) {
+    ierr = BVAllocateWork_Private(bv,BLOCKSIZE);CHKERRQ(ierr);
+    A = bv->work;
+    for (;n>0;n-=BLOCKSIZE,s+=BLOCKSIZE*NF) {
+      BVSingleToScalar(PetscMin(BLOCKSIZE,n),s,A);
+      for (i=0;i<PetscMin(BLOCKSIZE,n);i++) A[i] *= alpha;
+      BVScalarToSingle(PetscMin(BLOCKSIZE,n),A,s);
+    }
+    ierr = PetscLogFlops(1.0*(j<0?(bv->k-bv->l)*bv->n:bv->n));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Norm of columns j:j+nc-1, the sums are accumulated in the working precision
+*/
+static PetscErrorCode BVNorm_Single_Private(BV bv,PetscInt j,PetscInt nc,NormType type,PetscReal *nrm,PetscBool mpi)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *A;
+  PetscReal      lnrm=0.0,*rsum,*rsum2,t;
+  PetscInt       i,c,r,rb;
+  PetscMPIInt    len;
+
+  PetscFunctionBegin;
+  ierr = BVAllocateWork_Private(bv,BLOCKSIZE+2*nc+bv->n);CHKERRQ(ierr);
+  A = bv->work;
+  rsum = (PetscReal*)(bv->work+BLOCKSIZE);   /* column sums (NORM_1) or row sums (NORM_INFINITY) */
+  rsum2 = rsum+PetscMax(nc,bv->n);
+  ierr = PetscMemzero(rsum,PetscMax(nc,bv->n)*sizeof(PetscReal));CHKERRQ(ierr);
+  for (c=0;c<nc;c++) {
+    for (r=0;r<bv->n;r+=BLOCKSIZE) {
+      rb = PetscMin(BLOCKSIZE,bv->n-r);
+      BVSingleToScalar(rb,BVSingleColumn(bv,ctx->s,j+c)+r*NF,A);
+      for (i=0;i<rb;i++) {
+        t = PetscAbsScalar(A[i]);
+        if (type==NORM_FROBENIUS || type==NORM_2) lnrm += t*t;
+        else if (type==NORM_1) rsum[c] += t;
+        else if (type==NORM_INFINITY) rsum[r+i] += t;
+      }
+    }
+  }
+  if (type==NORM_FROBENIUS || type==NORM_2) {
+    if (mpi) {
+      ierr = MPI_Allreduce(&lnrm,nrm,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+      *nrm = PetscSqrtReal(*nrm);
+    } else *nrm = PetscSqrtReal(lnrm);
+  } else if (type==NORM_1) {
+    if (mpi) {
+      ierr = PetscMPIIntCast(nc,&len);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(rsum,rsum2,len,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+    } else rsum2 = rsum;
+    *nrm = 0.0;
+    for (c=0;c<nc;c++) if (rsum2[c] > *nrm) *nrm = rsum2[c];
+  } else if (type==NORM_INFINITY) {
+    for (i=0;i<bv->n;i++) if (rsum[i] > lnrm) lnrm = rsum[i];
+    if (mpi) {
+      ierr = MPI_Allreduce(&lnrm,nrm,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+    } else *nrm = lnrm;
+  }
+  ierr = PetscLogFlops(2.0*bv->n*nc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVNorm_Svec_Single(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+
+  PetscFunctionBegin;
+  if (j<0) {
+    ierr = BVNorm_Single_Private(bv,bv->l,bv->k-bv->l,type,val,ctx->mpi);CHKERRQ(ierr);
+  } else {
+    ierr = BVNorm_Single_Private(bv,j,1,type,val,ctx->mpi);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVNorm_Local_Svec_Single(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (j<0) {
+    ierr = BVNorm_Single_Private(bv,bv->l,bv->k-bv->l,type,val,PETSC_FALSE);CHKERRQ(ierr);
+  } else {
+    ierr = BVNorm_Single_Private(bv,j,1,type,val,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The operator is applied column by column, since a dense matrix in single
+   precision cannot be passed to MatMatMult()
+*/
+PetscErrorCode BVMatMult_Svec_Single(BV V,Mat A,BV W)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *v = (BV_SVEC*)V->data,*w = (BV_SVEC*)W->data;
+  PetscScalar    *pv;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  BVCheckSingle(W,3);
+  if (!v->z) {
+    ierr = VecDuplicate(V->t,&v->z);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)V,(PetscObject)v->z);CHKERRQ(ierr);
+  }
+  if (!w->z) {
+    ierr = VecDuplicate(W->t,&w->z);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)W,(PetscObject)w->z);CHKERRQ(ierr);
+  }
+  for (j=0;j<V->k-V->l;j++) {
+    ierr = VecGetArray(v->z,&pv);CHKERRQ(ierr);
+    BVSingleToScalar(V->n,BVSingleColumn(V,v->s,V->l+j),pv);
+    ierr = VecRestoreArray(v->z,&pv);CHKERRQ(ierr);
+    ierr = MatMult(A,v->z,w->z);CHKERRQ(ierr);
+    ierr = VecGetArray(w->z,&pv);CHKERRQ(ierr);
+    BVScalarToSingle(W->n,pv,BVSingleColumn(W,w->s,W->l+j));
+    ierr = VecRestoreArray(w->z,&pv);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVCopy_Svec_Single(BV V,BV W)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *v = (BV_SVEC*)V->data,*w = (BV_SVEC*)W->data;
+
+  PetscFunctionBegin;
+  BVCheckSingle(W,2);
+  ierr = PetscMemcpy(BVSingleColumn(W,w->s,W->l),BVSingleColumn(V,v->s,V->l),(V->k-V->l)*V->n*NF*sizeof(float));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVResize_Svec_Single(BV bv,PetscInt m,PetscBool copy)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  float          *snew;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(m*bv->n*NF,&snew);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)bv,(m-bv->m)*bv->n*NF*sizeof(float));CHKERRQ(ierr);
+  if (copy) {
+    ierr = PetscMemcpy(snew,ctx->s,PetscMin(m,bv->m)*bv->n*NF*sizeof(float));CHKERRQ(ierr);
+  }
+  ierr = PetscFree(ctx->s);CHKERRQ(ierr);
+  ctx->s = snew;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The column is copied to a vector in the working precision, and copied back
+   at restore if it has been modified
+*/
+PetscErrorCode BVGetColumn_Svec_Single(BV bv,PetscInt j,Vec *v)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *pv;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  ierr = VecGetArray(bv->cv[l],&pv);CHKERRQ(ierr);
+  BVSingleToScalar(bv->n,BVSingleColumn(bv,ctx->s,j),pv);
+  ierr = VecRestoreArray(bv->cv[l],&pv);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVRestoreColumn_Svec_Single(BV bv,PetscInt j,Vec *v)
+{
+  PetscErrorCode    ierr;
+  BV_SVEC           *ctx = (BV_SVEC*)bv->data;
+  const PetscScalar *pv;
+  PetscObjectState  st;
+  PetscInt          l;
+
+  PetscFunctionBegin;
+  l = (j==bv->ci[0])? 0: 1;
+  ierr = PetscObjectStateGet((PetscObject)bv->cv[l],&st);CHKERRQ(ierr);
+  if (st!=bv->st[l]) {
+    ierr = VecGetArrayRead(bv->cv[l],&pv);CHKERRQ(ierr);
+    BVScalarToSingle(bv->n,pv,BVSingleColumn(bv,ctx->s,j));
+    ierr = VecRestoreArrayRead(bv->cv[l],&pv);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The array includes the constraint columns, and the copy in the working
+   precision is kept in a buffer that is reused in subsequent calls
+*/
+static PetscErrorCode BVSingleGetArray_Private(BV bv)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscInt       len = (bv->nc+bv->m)*bv->n;
+
+  PetscFunctionBegin;
+  if (ctx->na<len) {
+    ierr = PetscFree(ctx->a);CHKERRQ(ierr);
+    ierr = PetscMalloc1(len,&ctx->a);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)bv,(len-ctx->na)*sizeof(PetscScalar));CHKERRQ(ierr);
+    ctx->na = len;
+  }
+  BVSingleToScalar(len,ctx->s,ctx->a);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVGetArray_Svec_Single(BV bv,PetscScalar **a)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+
+  PetscFunctionBegin;
+  ierr = BVSingleGetArray_Private(bv);CHKERRQ(ierr);
+  *a = ctx->a;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVRestoreArray_Svec_Single(BV bv,PetscScalar **a)
+{
+  BV_SVEC *ctx = (BV_SVEC*)bv->data;
+
+  PetscFunctionBegin;
+  BVScalarToSingle((bv->nc+bv->m)*bv->n,ctx->a,ctx->s);
+  if (a) *a = NULL;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVGetArrayRead_Svec_Single(BV bv,const PetscScalar **a)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+
+  PetscFunctionBegin;
+  ierr = BVSingleGetArray_Private(bv);CHKERRQ(ierr);
+  *a = ctx->a;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVRestoreArrayRead_Svec_Single(BV bv,const PetscScalar **a)
+{
+  PetscFunctionBegin;
+  if (a) *a = NULL;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVView_Svec_Single(BV bv,PetscViewer viewer)
+{
+  PetscErrorCode    ierr;
+  BV_SVEC           *ctx = (BV_SVEC*)bv->data;
+  PetscViewerFormat format;
+  PetscBool         isascii;
+  PetscScalar       *pv;
+  Vec               v;
+  char              str[50];
+  const char        *bvname,*name;
+
+  PetscFunctionBegin;
+  ierr = VecCreateSeq(PETSC_COMM_SELF,(bv->nc+bv->m)*bv->n,&v);CHKERRQ(ierr);
+  if (((PetscObject)bv)->name) {
+    ierr = PetscSNPrintf(str,50,"%s_0",((PetscObject)bv)->name);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject)v,str);CHKERRQ(ierr);
+  }
+  ierr = VecGetArray(v,&pv);CHKERRQ(ierr);
+  BVSingleToScalar((bv->nc+bv->m)*bv->n,ctx->s,pv);
+  ierr = VecRestoreArray(v,&pv);CHKERRQ(ierr);
+  ierr = VecView(v,viewer);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (isascii) {
+    ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+    if (format == PETSC_VIEWER_ASCII_MATLAB) {
+      ierr = PetscObjectGetName((PetscObject)bv,&bvname);CHKERRQ(ierr);
+      ierr = PetscObjectGetName((PetscObject)v,&name);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"%s=reshape(%s,%D,%D);clear %s\n",bvname,name,bv->N,bv->nc+bv->m,name);CHKERRQ(ierr);
+      if (bv->nc) {
+        ierr = PetscViewerASCIIPrintf(viewer,"%s=%s(:,%D:end);\n",bvname,bvname,bv->nc+1);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode BVDestroy_Svec_Single(BV bv)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(ctx->s);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->a);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->z);CHKERRQ(ierr);
+  ierr = VecDestroy(&bv->cv[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&bv->cv[1]);CHKERRQ(ierr);
+  ierr = PetscFree(bv->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Called from BVCreate_Svec() when single precision storage is requested,
+   once the context has been allocated
+*/
+PetscErrorCode BVCreate_Svec_Single(BV bv)
+{
+  PetscErrorCode ierr;
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *aa;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(bv->m*bv->n*NF,&ctx->s);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)bv,bv->m*bv->n*NF*sizeof(float));CHKERRQ(ierr);
+
+  if (bv->Acreate) {
+    ierr = MatDenseGetArray(bv->Acreate,&aa);CHKERRQ(ierr);
+    BVScalarToSingle(bv->m*bv->n,aa,ctx->s);
+    ierr = MatDenseRestoreArray(bv->Acreate,&aa);CHKERRQ(ierr);
+    ierr = MatDestroy(&bv->Acreate);CHKERRQ(ierr);
+  }
+
+  ierr = VecDuplicate(bv->t,&bv->cv[0]);CHKERRQ(ierr);
+  ierr = VecDuplicate(bv->t,&bv->cv[1]);CHKERRQ(ierr);
+
+  bv->ops->mult             = BVMult_Svec_Single;
+  bv->ops->multvec          = BVMultVec_Svec_Single;
+  bv->ops->multinplace      = BVMultInPlace_Svec_Single;
+  bv->ops->multinplacetrans = BVMultInPlaceTranspose_Svec_Single;
+  bv->ops->dot              = BVDot_Svec_Single;
+  bv->ops->dotvec           = BVDotVec_Svec_Single;
+  bv->ops->dotvec_local     = BVDotVec_Local_Svec_Single;
+  bv->ops->scale            = BVScale_Svec_Single;
+  bv->ops->norm             = BVNorm_Svec_Single;
+  bv->ops->norm_local       = BVNorm_Local_Svec_Single;
+  bv->ops->matmult          = BVMatMult_Svec_Single;
+  bv->ops->copy             = BVCopy_Svec_Single;
+  bv->ops->resize           = BVResize_Svec_Single;
+  bv->ops->getcolumn        = BVGetColumn_Svec_Single;
+  bv->ops->restorecolumn    = BVRestoreColumn_Svec_Single;
+  bv->ops->getarray         = BVGetArray_Svec_Single;
+  bv->ops->restorearray     = BVRestoreArray_Svec_Single;
+  bv->ops->getarrayread     = BVGetArrayRead_Svec_Single;
+  bv->ops->restorearrayread = BVRestoreArrayRead_Svec_Single;
+  bv->ops->destroy          = BVDestroy_Svec_Single;
+  if (!ctx->mpi) bv->ops->view = BVView_Svec_Single;
+  PetscFunctionReturn(0);
+}
+
+#endif
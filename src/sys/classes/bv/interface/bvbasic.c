@@ -292,6 +292,7 @@ PetscErrorCode BVSetNumConstraints(BV V,PetscInt nc)
   V->l = 0;
   V->m = total-nc;
   V->k = V->m;
+  V->gramk = 0;
   ierr = PetscObjectStateIncrease((PetscObject)V);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -358,6 +359,8 @@ PetscErrorCode BVResize(BV bv,PetscInt m,PetscBool copy)
   ierr = VecDestroy(&bv->buffer);CHKERRQ(ierr);
   ierr = BVDestroy(&bv->cached);CHKERRQ(ierr);
   ierr = PetscFree2(bv->h,bv->c);CHKERRQ(ierr);
+  ierr = PetscFree(bv->gram);CHKERRQ(ierr);
+  bv->gramk = 0;
   if (bv->omega) {
     ierr = PetscMalloc1(m,&omega);CHKERRQ(ierr);
     ierr = PetscLogObjectMemory((PetscObject)bv,m*sizeof(PetscReal));CHKERRQ(ierr);
@@ -904,7 +907,9 @@ PetscErrorCode BVSetFromOptions(BV bv)
   PetscErrorCode     ierr;
   char               type[256];
   PetscBool          flg1,flg2,flg3,flg4;
+  PetscInt           nt;
   PetscReal          r;
+  BVPrecision        prec;
   BVOrthogType       otype;
   BVOrthogRefineType orefine;
   BVOrthogBlockType  oblock;
@@ -913,6 +918,11 @@ PetscErrorCode BVSetFromOptions(BV bv)
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
   ierr = BVRegisterAll();CHKERRQ(ierr);
   ierr = PetscObjectOptionsBegin((PetscObject)bv);CHKERRQ(ierr);
+    /* precision must be known before the storage is allocated */
+    prec = bv->precision;
+    ierr = PetscOptionsEnum("-bv_precision","Precision of the stored entries","BVSetPrecision",BVPrecisions,(PetscEnum)prec,(PetscEnum*)&prec,&flg1);CHKERRQ(ierr);
+    if (flg1) { ierr = BVSetPrecision(bv,prec);CHKERRQ(ierr); }
+
     ierr = PetscOptionsFList("-bv_type","Basis Vectors type","BVSetType",BVList,(char*)(((PetscObject)bv)->type_name?((PetscObject)bv)->type_name:BVSVEC),type,256,&flg1);CHKERRQ(ierr);
     if (flg1) {
       ierr = BVSetType(bv,type);CHKERRQ(ierr);
@@ -932,6 +942,14 @@ PetscErrorCode BVSetFromOptions(BV bv)
 
     ierr = PetscOptionsEnum("-bv_matmult","Method for BVMatMult","BVSetMatMultMethod",BVMatMultTypes,(PetscEnum)bv->vmm,(PetscEnum*)&bv->vmm,NULL);CHKERRQ(ierr);
 
+    nt = bv->nthreads;
+    ierr = PetscOptionsInt("-bv_threads","Number of threads used in local kernels","BVSetNumThreads",nt,&nt,&flg1);CHKERRQ(ierr);
+    if (flg1) { ierr = BVSetNumThreads(bv,nt);CHKERRQ(ierr); }
+
+    nt = bv->mipbs;
+    ierr = PetscOptionsInt("-bv_mult_blocksize","Number of rows of the panels in BVMultInPlace","BVSetMultBlockSize",nt,&nt,&flg1);CHKERRQ(ierr);
+    if (flg1) { ierr = BVSetMultBlockSize(bv,nt);CHKERRQ(ierr); }
+
     /* undocumented option to generate random vectors that are independent of the number of processes */
     ierr = PetscOptionsGetBool(NULL,NULL,"-bv_reproducible_random",&bv->rrandom,NULL);CHKERRQ(ierr);
 
@@ -964,7 +982,8 @@ PetscErrorCode BVSetFromOptions(BV bv)
 
    Options Database Keys:
 +  -bv_orthog_type <type> - Where <type> is cgs for Classical Gram-Schmidt orthogonalization
-                         (default) or mgs for Modified Gram-Schmidt orthogonalization
+                         (default), mgs for Modified Gram-Schmidt orthogonalization, or cgs_lowsync
+                         for Classical Gram-Schmidt with a single global reduction per vector
 .  -bv_orthog_refine <ref> - Where <ref> is one of never, ifneeded (default) or always
 .  -bv_orthog_eta <eta> -  For setting the value of eta
 -  -bv_orthog_block <block> - Where <block> is the block-orthogonalization method
@@ -977,8 +996,22 @@ PetscErrorCode BVSetFromOptions(BV bv)
 
    When using several processors, MGS is likely to result in bad scalability.
 
+   The low-synchronization variant of CGS (BV_ORTHOG_CGS_LOWSYNC) performs
+   a single global reduction per orthogonalized column, that computes the
+   projection coefficients, the norm and the inner products of the previous
+   column against the rest. The latter are kept in a Gram matrix that is used
+   to apply the refinement without additional communication. It is only
+   different from CGS when orthogonalizing columns of the BV with a standard
+   inner product. If refinement is "never", the Gram matrix is not computed.
+
    If the method set for block orthogonalization is GS, then the computation
-   is done column by column with the vector orthogonalization.
+   is done column by column with the vector orthogonalization. CHOL computes
+   the Cholesky factor of the Gram matrix of the block, which needs a single
+   global reduction but loses orthogonality if the block is ill-conditioned.
+   CHOLQR2 repeats this step twice, giving a result as accurate as TSQR provided
+   that the condition number of the block is below about 1/sqrt(epsilon), and
+   SCHOLQR3 adds a previous step in which the Gram matrix is shifted, so that
+   the Cholesky factorization does not break down for ill-conditioned blocks.
 
    Level: advanced
 
@@ -995,6 +1028,7 @@ PetscErrorCode BVSetOrthogonalization(BV bv,BVOrthogType type,BVOrthogRefineType
   switch (type) {
     case BV_ORTHOG_CGS:
     case BV_ORTHOG_MGS:
+    case BV_ORTHOG_CGS_LOWSYNC:
       bv->orthog_type = type;
       break;
     default:
@@ -1019,6 +1053,8 @@ PetscErrorCode BVSetOrthogonalization(BV bv,BVOrthogType type,BVOrthogRefineType
     case BV_ORTHOG_BLOCK_GS:
     case BV_ORTHOG_BLOCK_CHOL:
     case BV_ORTHOG_BLOCK_TSQR:
+    case BV_ORTHOG_BLOCK_CHOLQR2:
+    case BV_ORTHOG_BLOCK_SCHOLQR3:
       bv->orthog_block = block;
       break;
     default:
@@ -1120,6 +1156,234 @@ PetscErrorCode BVGetMatMultMethod(BV bv,BVMatMultType *method)
   PetscFunctionReturn(0);
 }
 
+/*@
+   BVSetPrecision - Specifies the floating-point precision used to store the
+   entries of the basis vectors.
+
+   Logically Collective on BV
+
+   Input Parameters:
++  bv   - the basis vectors context
+-  prec - the precision
+
+   Options Database Keys:
+.  -bv_precision <prec> - choose one of default, single
+
+   Notes:
+   With BV_PRECISION_SINGLE, the columns are stored in single precision while
+   all operations (BVDot(), BVMult(), BVMultInPlace(), BVNorm(), etc.) are
+   carried out in the working precision, so that the accumulation of sums is
+   done in double precision. This halves the memory required by the basis and
+   the memory traffic of the BV kernels, which are usually bandwidth-bound.
+   Vectors obtained with BVGetColumn() or BVGetArray() are temporary copies
+   in the working precision, which are stored back when restored.
+
+   The price is that every stored entry is rounded to single precision, so
+   orthogonality of the basis and the attainable residual are limited to about
+   1e-7 relative to the norm of the matrix. It is therefore only useful if the
+   requested tolerance is above this level, or if the result is refined
+   afterwards (e.g., with a few iterations in the working precision).
+
+   Single precision storage is currently available only in BVSVEC with real
+   or complex double precision scalars and non-CUDA vectors; in other cases
+   the setting is ignored. If the storage had already been allocated, it is
+   allocated again and the previous contents are lost.
+
+   Level: advanced
+
+.seealso: BVGetPrecision(), BVPrecision
+@*/
+PetscErrorCode BVSetPrecision(BV bv,BVPrecision prec)
+{
+  PetscErrorCode ierr,(*r)(BV);
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(bv,prec,2);
+  switch (prec) {
+    case BV_PRECISION_DEFAULT:
+    case BV_PRECISION_SINGLE:
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONG,"Unknown precision");
+  }
+  if (prec==bv->precision) PetscFunctionReturn(0);
+  bv->precision = prec;
+  if (((PetscObject)bv)->type_name && !bv->ops->create) {  /* storage already allocated */
+    ierr = PetscFunctionListFind(BVList,((PetscObject)bv)->type_name,&r);CHKERRQ(ierr);
+    if (bv->ops->destroy) { ierr = (*bv->ops->destroy)(bv);CHKERRQ(ierr); }
+    ierr = PetscMemzero(bv->ops,sizeof(struct _BVOps));CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(BV_Create,bv,0,0,0);CHKERRQ(ierr);
+    ierr = (*r)(bv);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(BV_Create,bv,0,0,0);CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject)bv);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   BVGetPrecision - Gets the floating-point precision used to store the
+   entries of the basis vectors.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - basis vectors context
+
+   Output Parameter:
+.  prec - the precision
+
+   Level: advanced
+
+.seealso: BVSetPrecision(), BVPrecision
+@*/
+PetscErrorCode BVGetPrecision(BV bv,BVPrecision *prec)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidPointer(prec,2);
+  *prec = bv->precision;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   BVSetNumThreads - Sets the number of threads used in the local kernels
+   of the basis vectors.
+
+   Logically Collective on BV
+
+   Input Parameters:
++  bv - the basis vectors context
+-  nt - the number of threads
+
+   Options Database Keys:
+.  -bv_threads <nt> - the number of threads
+
+   Notes:
+   The dense kernels operating on the local part of the basis (BVMult(),
+   BVMultInPlace(), BVDot(), BVNorm() and their variants) are usually
+   delegated to a single call to the BLAS, so their performance depends on
+   the threading capabilities of the BLAS library. With nt>1, the rows of
+   the local part are split in nt chunks that are processed by separate
+   OpenMP threads, each one with a sequential BLAS call. Partial results of
+   reductions are summed in a fixed order, so the result does not depend on
+   the scheduling of threads. This is intended for hybrid runs with fewer
+   MPI processes per node, linked with a sequential BLAS.
+
+   Threads are used only if SLEPc is configured with OpenMP support, and
+   only for local sizes large enough. The setting applies to the storage
+   types that rely on the common BLAS kernels (svec, mat, contiguous).
+
+   Use PETSC_DEFAULT or PETSC_DECIDE to set the default value, 1.
+
+   Level: advanced
+
+.seealso: BVGetNumThreads()
+@*/
+PetscErrorCode BVSetNumThreads(BV bv,PetscInt nt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveInt(bv,nt,2);
+  if (nt==PETSC_DEFAULT || nt==PETSC_DECIDE) bv->nthreads = 1;
+  else {
+    if (nt<1) SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads must be > 0");
+    bv->nthreads = nt;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   BVGetNumThreads - Gets the number of threads used in the local kernels
+   of the basis vectors.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - the basis vectors context
+
+   Output Parameter:
+.  nt - the number of threads
+
+   Level: advanced
+
+.seealso: BVSetNumThreads()
+@*/
+PetscErrorCode BVGetNumThreads(BV bv,PetscInt *nt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidIntPointer(nt,2);
+  *nt = bv->nthreads;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   BVSetMultBlockSize - Sets the number of rows of the panels in which the
+   local part of the basis is processed in BVMultInPlace().
+
+   Logically Collective on BV
+
+   Input Parameters:
++  bv - the basis vectors context
+-  bs - the number of rows
+
+   Options Database Keys:
+.  -bv_mult_blocksize <bs> - the number of rows of the panels
+
+   Notes:
+   BVMultInPlace() computes V(:,s:e-1) = V*Q(:,s:e-1) panel by panel, each
+   panel being a set of consecutive rows, so that the workspace is bs*(e-s)
+   independently of the local length of the vectors. By default, the panel
+   height is chosen so that the input and output panels fit in a typical L2
+   cache, taking into account the number of active columns. A larger value
+   may perform better in processors with larger caches, as the cost of the
+   update is dominated by the BLAS call on each panel.
+
+   Use PETSC_DEFAULT or PETSC_DECIDE to restore the automatic choice.
+
+   Level: advanced
+
+.seealso: BVGetMultBlockSize(), BVMultInPlace()
+@*/
+PetscErrorCode BVSetMultBlockSize(BV bv,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveInt(bv,bs,2);
+  if (bs==PETSC_DEFAULT || bs==PETSC_DECIDE) bv->mipbs = 0;
+  else {
+    if (bs<1) SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Block size must be > 0");
+    bv->mipbs = bs;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   BVGetMultBlockSize - Gets the number of rows of the panels used in
+   BVMultInPlace().
+
+   Not Collective
+
+   Input Parameter:
+.  bv - the basis vectors context
+
+   Output Parameter:
+.  bs - the number of rows (0 if it is determined automatically)
+
+   Level: advanced
+
+.seealso: BVSetMultBlockSize()
+@*/
+PetscErrorCode BVGetMultBlockSize(BV bv,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidIntPointer(bs,2);
+  *bs = bv->mipbs;
+  PetscFunctionReturn(0);
+}
+
 /*@
    BVGetColumn - Returns a Vec object that contains the entries of the
    requested column of the basis vectors object.
@@ -1212,6 +1476,7 @@ PetscErrorCode BVRestoreColumn(BV bv,PetscInt j,Vec *v)
   ierr = PetscObjectStateGet((PetscObject)*v,&st);CHKERRQ(ierr);
   if (st!=bv->st[l]) {
     ierr = PetscObjectStateIncrease((PetscObject)bv);CHKERRQ(ierr);
+    BV_DiscardGram(bv,j);
   }
   if (bv->ops->restorecolumn) {
     ierr = (*bv->ops->restorecolumn)(bv,j,v);CHKERRQ(ierr);
@@ -1289,6 +1554,7 @@ PetscErrorCode BVRestoreArray(BV bv,PetscScalar **a)
   }
   if (a) *a = NULL;
   ierr = PetscObjectStateIncrease((PetscObject)bv);CHKERRQ(ierr);
+  BV_DiscardGram(bv,-bv->nc);
   PetscFunctionReturn(0);
 }
 
@@ -1435,12 +1701,15 @@ PETSC_STATIC_INLINE PetscErrorCode BVDuplicate_Private(BV V,PetscInt m,BV *W)
 
   PetscFunctionBegin;
   ierr = BVCreate(PetscObjectComm((PetscObject)V),W);CHKERRQ(ierr);
+  (*W)->precision = V->precision;
   ierr = BVSetSizesFromVec(*W,V->t,m);CHKERRQ(ierr);
   ierr = BVSetType(*W,((PetscObject)V)->type_name);CHKERRQ(ierr);
   ierr = BVSetMatrix(*W,V->matrix,V->indef);CHKERRQ(ierr);
   ierr = BVSetOrthogonalization(*W,V->orthog_type,V->orthog_ref,V->orthog_eta,V->orthog_block);CHKERRQ(ierr);
-  (*W)->vmm     = V->vmm;
-  (*W)->rrandom = V->rrandom;
+  (*W)->vmm      = V->vmm;
+  (*W)->nthreads = V->nthreads;
+  (*W)->mipbs    = V->mipbs;
+  (*W)->rrandom  = V->rrandom;
   if (V->ops->duplicate) { ierr = (*V->ops->duplicate)(V,W);CHKERRQ(ierr); }
   ierr = PetscObjectStateIncrease((PetscObject)*W);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1562,6 +1831,7 @@ PetscErrorCode BVCopy(BV V,BV W)
     ierr = PetscMemcpy(W->omega+W->nc+W->l,V->omega+V->nc+V->l,(V->k-V->l)*sizeof(PetscReal));CHKERRQ(ierr);
   }
   ierr = (*V->ops->copy)(V,W);CHKERRQ(ierr);
+  BV_DiscardGram(W,W->l);
   ierr = PetscLogEventEnd(BV_Copy,V,W,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
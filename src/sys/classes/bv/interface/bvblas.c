@@ -25,6 +25,63 @@
 #include <slepcblaslapack.h>
 
 #define BLOCKSIZE 64
+#define CACHESIZE 524288   /* bytes, a typical size of the L2 cache */
+
+/*
+    Number of rows of the panels used in BVMultInPlace when updating n columns
+    from k columns: the value set by the user or, by default, the largest
+    multiple of BLOCKSIZE such that the input and output panels fit in cache
+*/
+PetscInt BVMultInPlaceRows_Private(BV bv,PetscInt m,PetscInt k,PetscInt n)
+{
+  PetscInt bs;
+
+  if (bv->mipbs>0) bs = bv->mipbs;
+  else {
+    bs = CACHESIZE/(sizeof(PetscScalar)*PetscMax(k+n,1));
+    bs = PetscMax(BLOCKSIZE,(bs/BLOCKSIZE)*BLOCKSIZE);
+  }
+  return PetscMax(1,PetscMin(bs,m));
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+/*
+    Number of threads to be used in a kernel that operates on m local rows,
+    so that each thread gets at least BLOCKSIZE rows (1 means sequential)
+*/
+PETSC_STATIC_INLINE PetscBLASInt BVThreads_Private(BV bv,PetscBLASInt m)
+{
+  PetscInt nt = PetscMin(bv->nthreads,m/BLOCKSIZE);
+  return (PetscBLASInt)PetscMax(nt,1);
+}
+
+/*
+    First row r0 and number of rows rb of the t-th chunk when splitting m rows
+    among nt threads
+*/
+PETSC_STATIC_INLINE void BVThreadChunk_Private(PetscBLASInt m,PetscBLASInt nt,PetscBLASInt t,PetscBLASInt *r0,PetscBLASInt *rb)
+{
+  PetscBLASInt q=m/nt,r=m%nt;
+
+  *rb = q+((t<r)?1:0);
+  *r0 = t*q+PetscMin(t,r);
+}
+
+/*
+    Add up the nt partial results of length len stored consecutively in P,
+    always in the same order so that the result is reproducible; the sum
+    is left in the first one
+*/
+PETSC_STATIC_INLINE void BVThreadSum_Private(PetscBLASInt nt,PetscInt len,PetscScalar *P)
+{
+  PetscBLASInt t;
+  PetscInt     i;
+
+  for (t=1;t<nt;t++) {
+    for (i=0;i<len;i++) P[i] += P[i+t*len];
+  }
+}
+#endif
 
 /*
     C := alpha*A*B + beta*C
@@ -38,12 +95,29 @@ PetscErrorCode BVMult_BLAS_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,Pet
 #if defined(PETSC_HAVE_FBLASLAPACK) || defined(PETSC_HAVE_F2CBLASLAPACK)
   PetscBLASInt   l,bs=BLOCKSIZE;
 #endif
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
 
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(m_,&m);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(ldb_,&ldb);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,m);
+  if (nt>1) {
+    /* each thread updates a chunk of rows of C (BLAS called directly, PetscStackCallBLAS is not thread-safe) */
+#pragma omp parallel for num_threads(nt) schedule(static)
+    for (t=0;t<nt;t++) {
+      PetscBLASInt r0,rb;
+      BVThreadChunk_Private(m,nt,t,&r0,&rb);
+      BLASgemm_("N","N",&rb,&n,&k,&alpha,(PetscScalar*)A+r0,&m,(PetscScalar*)B,&ldb,&beta,C+r0,&m);
+    }
+    ierr = PetscLogFlops(2.0*m*n*k);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
 #if defined(PETSC_HAVE_FBLASLAPACK) || defined(PETSC_HAVE_F2CBLASLAPACK)
   l = m % bs;
   if (l) PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&l,&n,&k,&alpha,(PetscScalar*)A,&m,(PetscScalar*)B,&ldb,&beta,C,&m));
@@ -66,10 +140,26 @@ PetscErrorCode BVMultVec_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscScalar
 {
   PetscErrorCode ierr;
   PetscBLASInt   n,k,one=1;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
 
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,n);
+  if (nt>1) {
+#pragma omp parallel for num_threads(nt) schedule(static)
+    for (t=0;t<nt;t++) {
+      PetscBLASInt r0,rb;
+      BVThreadChunk_Private(n,nt,t,&r0,&rb);
+      BLASgemv_("N",&rb,&k,&alpha,(PetscScalar*)A+r0,&n,(PetscScalar*)x,&one,&beta,y+r0,&one);
+    }
+    ierr = PetscLogFlops(2.0*n*k);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (n) PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n,&k,&alpha,A,&n,x,&one,&beta,y,&one));
   ierr = PetscLogFlops(2.0*n*k);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -79,21 +169,26 @@ PetscErrorCode BVMultVec_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscScalar
     A(:,s:e-1) := A*B(:,s:e-1)
 
     A is mxk (ld=m), B is kxn (ld=ldb)  n=e-s
+
+    Processed by panels of bs rows, so the workspace is bs*n
 */
 PetscErrorCode BVMultInPlace_BLAS_Private(BV bv,PetscInt m_,PetscInt k_,PetscInt ldb_,PetscInt s,PetscInt e,PetscScalar *A,const PetscScalar *B,PetscBool btrans)
 {
   PetscErrorCode ierr;
   PetscScalar    *pb,zero=0.0,one=1.0;
-  PetscBLASInt   m,n,k,l,ldb,bs=BLOCKSIZE;
+  PetscBLASInt   m,n,k,l,ldb,bs;
   PetscInt       j,n_=e-s;
   const char     *bt;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
 
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(m_,&m);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(ldb_,&ldb);CHKERRQ(ierr);
-  ierr = BVAllocateWork_Private(bv,BLOCKSIZE*n_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(BVMultInPlaceRows_Private(bv,m_,k_,n_),&bs);CHKERRQ(ierr);
   if (btrans) {
     pb = (PetscScalar*)B+s;
     bt = "C";
@@ -101,6 +196,29 @@ PetscErrorCode BVMultInPlace_BLAS_Private(BV bv,PetscInt m_,PetscInt k_,PetscInt
     pb = (PetscScalar*)B+s*ldb;
     bt = "N";
   }
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,m);
+  if (nt>1) {
+    /* each thread processes its chunk of rows by blocks, with a private buffer */
+    ierr = BVAllocateWork_Private(bv,nt*bs*n_);CHKERRQ(ierr);
+#pragma omp parallel for num_threads(nt) schedule(static)
+    for (t=0;t<nt;t++) {
+      PetscBLASInt r0,rb,r,lb,i,jj;
+      PetscScalar  *W = bv->work+t*bs*n;
+      BVThreadChunk_Private(m,nt,t,&r0,&rb);
+      for (r=r0;r<r0+rb;r+=lb) {
+        lb = PetscMin(bs,r0+rb-r);
+        BLASgemm_("N",bt,&lb,&n,&k,&one,A+r,&m,pb,&ldb,&zero,W,&lb);
+        for (jj=0;jj<n;jj++) {
+          for (i=0;i<lb;i++) A[r+i+(s+jj)*m] = W[i+jj*lb];
+        }
+      }
+    }
+    ierr = PetscLogFlops(2.0*m*n*k);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = BVAllocateWork_Private(bv,bs*n_);CHKERRQ(ierr);
   l = m % bs;
   if (l) {
     PetscStackCallBLAS("BLASgemm",BLASgemm_("N",bt,&l,&n,&k,&one,A,&m,pb,&ldb,&zero,bv->work,&l));
@@ -128,7 +246,7 @@ PetscErrorCode BVMultInPlace_Vecs_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt
   PetscErrorCode    ierr;
   PetscScalar       zero=0.0,one=1.0,*out,*pout;
   const PetscScalar *pin;
-  PetscBLASInt      m,n,k,l,bs=BLOCKSIZE;
+  PetscBLASInt      m,n,k,l,bs;
   PetscInt          j;
   const char        *bt;
 
@@ -136,8 +254,9 @@ PetscErrorCode BVMultInPlace_Vecs_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt
   ierr = PetscBLASIntCast(m_,&m);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
-  ierr = BVAllocateWork_Private(bv,2*BLOCKSIZE*n_);CHKERRQ(ierr);
-  out = bv->work+BLOCKSIZE*n_;
+  ierr = PetscBLASIntCast(BVMultInPlaceRows_Private(bv,m_,k_,n_),&bs);CHKERRQ(ierr);
+  ierr = BVAllocateWork_Private(bv,2*bs*n_);CHKERRQ(ierr);
+  out = bv->work+bs*n_;
   if (btrans) bt = "C";
   else bt = "N";
   l = m % bs;
@@ -192,6 +311,90 @@ PetscErrorCode BVAXPY_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscScalar alp
   PetscFunctionReturn(0);
 }
 
+/*
+    Sum across processes the local contributions to a Hermitian nxn matrix,
+    of which only the upper triangle is available in C (ld=n). Only the
+    n*(n+1)/2 entries of the packed triangle are communicated. The full
+    matrix is stored in D (ld=ldd), filling the lower triangle by conjugation.
+
+    W is a work array of length n*(n+1), not referenced if mpi=PETSC_FALSE,
+    in which case C may coincide with D (and then has ld=ldd)
+*/
+PetscErrorCode BVDotHermitianReduce_Private(BV bv,PetscInt n,const PetscScalar *C,PetscScalar *W,PetscScalar *D,PetscInt ldd,PetscBool mpi)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,q,p=n*(n+1)/2;
+  PetscMPIInt    len;
+
+  PetscFunctionBegin;
+  if (mpi) {
+    for (j=0,q=0;j<n;j++) {
+      for (i=0;i<=j;i++) W[q++] = C[i+j*n];
+    }
+    ierr = PetscMPIIntCast(p,&len);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(W,W+p,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+    for (j=0,q=p;j<n;j++) {
+      for (i=0;i<=j;i++) D[i+j*ldd] = W[q++];
+    }
+  } else if (C!=D) {
+    for (j=0;j<n;j++) {
+      ierr = PetscMemcpy(D+j*ldd,C+j*n,(j+1)*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+  }
+  for (j=0;j<n;j++) {
+    for (i=j+1;i<n;i++) D[i+j*ldd] = PetscConj(D[j+i*ldd]);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+    C := A'*A, Hermitian Gram matrix computed with a rank-k update
+
+    A is kxn (ld=k), C is nxn (ld=ldc)
+*/
+static PetscErrorCode BVDotHermitian_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscInt ldc_,const PetscScalar *A,PetscScalar *C,PetscBool mpi)
+{
+  PetscErrorCode ierr;
+  PetscReal      rzero=0.0,rone=1.0;
+  PetscBLASInt   n,k,ldc;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldc_,&ldc);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,k);
+  if (nt>1) {
+    /* partial Gram matrices of each chunk of rows, added up in a fixed order */
+    ierr = BVAllocateWork_Private(bv,nt*n*n+n*(n+1));CHKERRQ(ierr);
+#pragma omp parallel for num_threads(nt) schedule(static)
+    for (t=0;t<nt;t++) {
+      PetscBLASInt r0,rb;
+      BVThreadChunk_Private(k,nt,t,&r0,&rb);
+      BLASsyrk_("U","C",&n,&rb,&rone,(PetscScalar*)A+r0,&k,&rzero,bv->work+t*n*n,&n);
+    }
+    BVThreadSum_Private(nt,n*n,bv->work);
+    ierr = BVDotHermitianReduce_Private(bv,n,bv->work,bv->work+nt*n*n,C,ldc,mpi);CHKERRQ(ierr);
+    ierr = PetscLogFlops(1.0*n*(n+1)*k);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  if (mpi) {
+    ierr = BVAllocateWork_Private(bv,n*n+n*(n+1));CHKERRQ(ierr);
+    if (k) PetscStackCallBLAS("BLASsyrk",BLASsyrk_("U","C",&n,&k,&rone,(PetscScalar*)A,&k,&rzero,bv->work,&n));
+    else { ierr = PetscMemzero(bv->work,n*n*sizeof(PetscScalar));CHKERRQ(ierr); }
+    ierr = BVDotHermitianReduce_Private(bv,n,bv->work,bv->work+n*n,C,ldc,mpi);CHKERRQ(ierr);
+  } else if (k) {
+    PetscStackCallBLAS("BLASsyrk",BLASsyrk_("U","C",&n,&k,&rone,(PetscScalar*)A,&k,&rzero,C,&ldc));
+    ierr = BVDotHermitianReduce_Private(bv,n,C,NULL,C,ldc,mpi);CHKERRQ(ierr);
+  }
+  ierr = PetscLogFlops(1.0*n*(n+1)*k);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     C := A'*B
 
@@ -203,12 +406,44 @@ PetscErrorCode BVDot_BLAS_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,Pets
   PetscScalar    zero=0.0,one=1.0,*CC;
   PetscBLASInt   m,n,k,ldc,j;
   PetscMPIInt    len;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
 
   PetscFunctionBegin;
+  if (A==B && m_==n_) {  /* Gram matrix, compute only one triangle */
+    ierr = BVDotHermitian_BLAS_Private(bv,n_,k_,ldc_,A,C,mpi);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscBLASIntCast(m_,&m);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(ldc_,&ldc);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,k);
+  if (nt>1) {
+    /* partial products of each chunk of rows, added up in a fixed order */
+    ierr = BVAllocateWork_Private(bv,nt*m*n);CHKERRQ(ierr);
+#pragma omp parallel for num_threads(nt) schedule(static)
+    for (t=0;t<nt;t++) {
+      PetscBLASInt r0,rb;
+      BVThreadChunk_Private(k,nt,t,&r0,&rb);
+      BLASgemm_("C","N",&m,&n,&rb,&one,(PetscScalar*)A+r0,&k,(PetscScalar*)B+r0,&k,&zero,bv->work+t*m*n,&m);
+    }
+    BVThreadSum_Private(nt,m*n,bv->work);
+    CC = bv->work;
+    if (mpi) {
+      CC = bv->work+m*n;
+      ierr = PetscMPIIntCast(m*n,&len);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(bv->work,CC,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+    }
+    for (j=0;j<n;j++) {
+      ierr = PetscMemcpy(C+j*ldc,CC+j*m,m*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    ierr = PetscLogFlops(2.0*m*n*k);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (mpi) {
     if (ldc==m) {
       ierr = BVAllocateWork_Private(bv,m*n);CHKERRQ(ierr);
@@ -245,10 +480,34 @@ PetscErrorCode BVDotVec_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,const PetscSc
   PetscScalar    zero=0.0,done=1.0;
   PetscBLASInt   n,k,one=1;
   PetscMPIInt    len;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
 
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(k_,&k);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,n);
+  if (nt>1) {
+    ierr = BVAllocateWork_Private(bv,nt*k);CHKERRQ(ierr);
+#pragma omp parallel for num_threads(nt) schedule(static)
+    for (t=0;t<nt;t++) {
+      PetscBLASInt r0,rb;
+      BVThreadChunk_Private(n,nt,t,&r0,&rb);
+      BLASgemv_("C",&rb,&k,&done,(PetscScalar*)A+r0,&n,(PetscScalar*)x+r0,&one,&zero,bv->work+t*k,&one);
+    }
+    BVThreadSum_Private(nt,k,bv->work);
+    if (mpi) {
+      ierr = PetscMPIIntCast(k,&len);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(bv->work,y,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+    } else {
+      ierr = PetscMemcpy(y,bv->work,k*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    ierr = PetscLogFlops(2.0*n*k);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (mpi) {
     ierr = BVAllocateWork_Private(bv,k);CHKERRQ(ierr);
     if (n) {
@@ -293,11 +552,74 @@ PetscErrorCode BVNorm_LAPACK_Private(BV bv,PetscInt m_,PetscInt n_,const PetscSc
   PetscBLASInt   m,n,i,j;
   PetscMPIInt    len;
   PetscReal      lnrm,*rwork=NULL,*rwork2=NULL;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   t,nt;
+#endif
 
   PetscFunctionBegin;
   ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(m_,&m);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(n_,&n);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BVThreads_Private(bv,m);
+  if (nt>1) {
+    /* per-thread partial norms of each chunk of rows, combined in a fixed order */
+    ierr = BVAllocateWork_Private(bv,nt*n_+m_+n_);CHKERRQ(ierr);
+    rwork = (PetscReal*)bv->work;
+    if (type==NORM_FROBENIUS || type==NORM_2) {
+#pragma omp parallel for num_threads(nt) schedule(static)
+      for (t=0;t<nt;t++) {
+        PetscBLASInt r0,rb;
+        BVThreadChunk_Private(m,nt,t,&r0,&rb);
+        rwork[t] = LAPACKlange_("F",&rb,&n,(PetscScalar*)A+r0,&m,NULL);
+      }
+      lnrm = 0.0;
+      for (t=0;t<nt;t++) lnrm += rwork[t]*rwork[t];
+      if (mpi) {
+        ierr = MPI_Allreduce(&lnrm,nrm,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+        *nrm = PetscSqrtReal(*nrm);
+      } else *nrm = PetscSqrtReal(lnrm);
+      ierr = PetscLogFlops(2.0*m*n);CHKERRQ(ierr);
+    } else if (type==NORM_1) {
+#pragma omp parallel for num_threads(nt) schedule(static)
+      for (t=0;t<nt;t++) {
+        PetscBLASInt r0,rb,ii,jj;
+        BVThreadChunk_Private(m,nt,t,&r0,&rb);
+        for (jj=0;jj<n;jj++) {
+          rwork[jj+t*n] = 0.0;
+          for (ii=r0;ii<r0+rb;ii++) rwork[jj+t*n] += PetscAbsScalar(A[ii+jj*m]);
+        }
+      }
+      for (t=1;t<nt;t++) {
+        for (j=0;j<n;j++) rwork[j] += rwork[j+t*n];
+      }
+      rwork2 = rwork+nt*n;
+      if (mpi) {
+        ierr = PetscMPIIntCast(n_,&len);CHKERRQ(ierr);
+        ierr = MPI_Allreduce(rwork,rwork2,len,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+      } else rwork2 = rwork;
+      *nrm = 0.0;
+      for (j=0;j<n_;j++) if (rwork2[j] > *nrm) *nrm = rwork2[j];
+      ierr = PetscLogFlops(1.0*m*n);CHKERRQ(ierr);
+    } else if (type==NORM_INFINITY) {
+      rwork2 = rwork+nt;
+#pragma omp parallel for num_threads(nt) schedule(static)
+      for (t=0;t<nt;t++) {
+        PetscBLASInt r0,rb;
+        BVThreadChunk_Private(m,nt,t,&r0,&rb);
+        rwork[t] = LAPACKlange_("I",&rb,&n,(PetscScalar*)A+r0,&m,rwork2+r0);
+      }
+      lnrm = 0.0;
+      for (t=0;t<nt;t++) lnrm = PetscMax(lnrm,rwork[t]);
+      if (mpi) {
+        ierr = MPI_Allreduce(&lnrm,nrm,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)bv));CHKERRQ(ierr);
+      } else *nrm = lnrm;
+      ierr = PetscLogFlops(1.0*m*n);CHKERRQ(ierr);
+    }
+    ierr = PetscFPTrapPop();CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (type==NORM_FROBENIUS || type==NORM_2) {
     lnrm = LAPACKlange_("F",&m,&n,(PetscScalar*)A,&m,rwork);
     if (mpi) {
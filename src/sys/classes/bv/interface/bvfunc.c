@@ -24,13 +24,14 @@
 #include <slepc/private/bvimpl.h>            /*I "slepcbv.h" I*/
 
 PetscClassId     BV_CLASSID = 0;
-PetscLogEvent    BV_Create = 0,BV_Copy = 0,BV_Mult = 0,BV_MultVec = 0,BV_MultInPlace = 0,BV_Dot = 0,BV_DotVec = 0,BV_Orthogonalize = 0,BV_OrthogonalizeVec = 0,BV_Scale = 0,BV_Norm = 0,BV_NormVec = 0,BV_SetRandom = 0,BV_MatMult = 0,BV_MatMultVec = 0,BV_MatProject = 0;
+PetscLogEvent    BV_Create = 0,BV_Copy = 0,BV_Mult = 0,BV_MultVec = 0,BV_MultInPlace = 0,BV_Dot = 0,BV_DotVec = 0,BV_Orthogonalize = 0,BV_OrthogonalizeVec = 0,BV_Scale = 0,BV_Norm = 0,BV_NormVec = 0,BV_SetRandom = 0,BV_MatMult = 0,BV_MatMultVec = 0,BV_MatProject = 0,BV_AllocateWork = 0;
 static PetscBool BVPackageInitialized = PETSC_FALSE;
 
-const char *BVOrthogTypes[] = {"CGS","MGS","BVOrthogType","BV_ORTHOG_",0};
+const char *BVOrthogTypes[] = {"CGS","MGS","CGS_LOWSYNC","BVOrthogType","BV_ORTHOG_",0};
 const char *BVOrthogRefineTypes[] = {"IFNEEDED","NEVER","ALWAYS","BVOrthogRefineType","BV_ORTHOG_REFINE_",0};
-const char *BVOrthogBlockTypes[] = {"GS","CHOL","TSQR","BVOrthogBlockType","BV_ORTHOG_BLOCK_",0};
+const char *BVOrthogBlockTypes[] = {"GS","CHOL","TSQR","CHOLQR2","SCHOLQR3","BVOrthogBlockType","BV_ORTHOG_BLOCK_",0};
 const char *BVMatMultTypes[] = {"VECS","MAT","MAT_SAVE","BVMatMultType","BV_MATMULT_",0};
+const char *BVPrecisions[] = {"DEFAULT","SINGLE","BVPrecision","BV_PRECISION_",0};
 
 /*@C
    BVFinalizePackage - This function destroys everything in the Slepc interface
@@ -91,6 +92,8 @@ PetscErrorCode BVInitializePackage(void)
   ierr = PetscLogEventRegister("BVMatMult",BV_CLASSID,&BV_MatMult);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("BVMatMultVec",BV_CLASSID,&BV_MatMultVec);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("BVMatProject",BV_CLASSID,&BV_MatProject);CHKERRQ(ierr);
+  /* one event per reallocation of the BV work array (temporary allocations elsewhere are not included) */
+  ierr = PetscLogEventRegister("BVAllocateWork",BV_CLASSID,&BV_AllocateWork);CHKERRQ(ierr);
   /* Process info exclusions */
   ierr = PetscOptionsGetString(NULL,NULL,"-info_exclude",logList,256,&opt);CHKERRQ(ierr);
   if (opt) {
@@ -140,6 +143,7 @@ PetscErrorCode BVDestroy(BV *bv)
   ierr = PetscFree((*bv)->work);CHKERRQ(ierr);
   ierr = PetscFree2((*bv)->h,(*bv)->c);CHKERRQ(ierr);
   ierr = PetscFree((*bv)->omega);CHKERRQ(ierr);
+  ierr = PetscFree((*bv)->gram);CHKERRQ(ierr);
   ierr = MatDestroy(&(*bv)->B);CHKERRQ(ierr);
   ierr = MatDestroy(&(*bv)->C);CHKERRQ(ierr);
   ierr = MatDestroy(&(*bv)->Acreate);CHKERRQ(ierr);
@@ -188,6 +192,9 @@ PetscErrorCode BVCreate(MPI_Comm comm,BV *newbv)
   bv->matrix       = NULL;
   bv->indef        = PETSC_FALSE;
   bv->vmm          = BV_MATMULT_MAT;
+  bv->precision    = BV_PRECISION_DEFAULT;
+  bv->nthreads     = 1;
+  bv->mipbs        = 0;
 
   bv->Bx           = NULL;
   bv->buffer       = NULL;
@@ -204,6 +211,8 @@ PetscErrorCode BVCreate(MPI_Comm comm,BV *newbv)
   bv->h            = NULL;
   bv->c            = NULL;
   bv->omega        = NULL;
+  bv->gram         = NULL;
+  bv->gramk        = 0;
   bv->B            = NULL;
   bv->C            = NULL;
   bv->Aid          = 0;
@@ -643,6 +652,12 @@ PetscErrorCode BVView(BV bv,PetscViewer viewer)
           ierr = PetscViewerASCIIPrintf(viewer,"doing matmult as a single matrix-matrix product, saving aux matrices\n");CHKERRQ(ierr);
           break;
       }
+      if (bv->precision==BV_PRECISION_SINGLE) {
+        ierr = PetscViewerASCIIPrintf(viewer,"storing entries in single precision\n");CHKERRQ(ierr);
+      }
+      if (bv->nthreads>1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using %D threads in local kernels\n",bv->nthreads);CHKERRQ(ierr);
+      }
       if (bv->rrandom) {
         ierr = PetscViewerASCIIPrintf(viewer,"generating random vectors independent of the number of processes\n");CHKERRQ(ierr);
       }
@@ -689,10 +704,12 @@ PetscErrorCode BVAllocateWork_Private(BV bv,PetscInt s)
 
   PetscFunctionBegin;
   if (s>bv->lwork) {
+    ierr = PetscLogEventBegin(BV_AllocateWork,bv,0,0,0);CHKERRQ(ierr);
     ierr = PetscFree(bv->work);CHKERRQ(ierr);
     ierr = PetscMalloc1(s,&bv->work);CHKERRQ(ierr);
     ierr = PetscLogObjectMemory((PetscObject)bv,(s-bv->lwork)*sizeof(PetscScalar));CHKERRQ(ierr);
     bv->lwork = s;
+    ierr = PetscLogEventEnd(BV_AllocateWork,bv,0,0,0);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
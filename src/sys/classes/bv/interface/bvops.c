@@ -87,6 +87,7 @@ PetscErrorCode BVMult(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
 
   ierr = PetscLogEventBegin(BV_Mult,X,Y,0,0);CHKERRQ(ierr);
   ierr = (*Y->ops->mult)(Y,alpha,beta,X,Q);CHKERRQ(ierr);
+  BV_DiscardGram(Y,Y->l);
   ierr = PetscLogEventEnd(BV_Mult,X,Y,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -257,6 +258,7 @@ PetscErrorCode BVMultInPlace(BV V,Mat Q,PetscInt s,PetscInt e)
 
   ierr = PetscLogEventBegin(BV_MultInPlace,V,Q,0,0);CHKERRQ(ierr);
   ierr = (*V->ops->multinplace)(V,Q,s,e);CHKERRQ(ierr);
+  BV_DiscardGram(V,s);
   ierr = PetscLogEventEnd(BV_MultInPlace,V,Q,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)V);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -309,6 +311,7 @@ PetscErrorCode BVMultInPlaceTranspose(BV V,Mat Q,PetscInt s,PetscInt e)
 
   ierr = PetscLogEventBegin(BV_MultInPlace,V,Q,0,0);CHKERRQ(ierr);
   ierr = (*V->ops->multinplacetrans)(V,Q,s,e);CHKERRQ(ierr);
+  BV_DiscardGram(V,s);
   ierr = PetscLogEventEnd(BV_MultInPlace,V,Q,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)V);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -345,6 +348,7 @@ PetscErrorCode BVScale(BV bv,PetscScalar alpha)
   if (bv->n) {
     ierr = (*bv->ops->scale)(bv,-1,alpha);CHKERRQ(ierr);
   }
+  BV_DiscardGram(bv,bv->l);
   ierr = PetscLogEventEnd(BV_Scale,bv,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)bv);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -382,6 +386,7 @@ PetscErrorCode BVScaleColumn(BV bv,PetscInt j,PetscScalar alpha)
   if (bv->n) {
     ierr = (*bv->ops->scale)(bv,j,alpha);CHKERRQ(ierr);
   }
+  BV_DiscardGram(bv,j);
   ierr = PetscLogEventEnd(BV_Scale,bv,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)bv);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -595,6 +600,7 @@ PetscErrorCode BVMatMult(BV V,Mat A,BV Y)
 
   ierr = PetscLogEventBegin(BV_MatMult,V,A,Y,0);CHKERRQ(ierr);
   ierr = (*V->ops->matmult)(V,A,Y);CHKERRQ(ierr);
+  BV_DiscardGram(Y,Y->l);
   ierr = PetscLogEventEnd(BV_MatMult,V,A,Y,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
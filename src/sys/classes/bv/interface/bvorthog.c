@@ -278,6 +278,124 @@ static PetscErrorCode BVOrthogonalizeCGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
 
 #define BVOrthogonalizeGS1(a,b,c,d,e,f,g,h) (mgs?BVOrthogonalizeMGS1:BVOrthogonalizeCGS1)(a,b,c,d,e,f,g,h)
 
+/*
+   BVOrthogonalizeCGSLowSync - Orthogonalize column j with classical Gram-Schmidt
+   performing a single global reduction, which computes at the same time the
+   coefficients c=V'*v, the value (v,v) and the entries of the Gram matrix G=V'*V
+   associated with the previous column (or all of them if they are not available).
+
+   The refinement is then done without communication, by using the coefficients
+   c+(I-G)*c, which are those that would result from a second pass of CGS. The
+   norm of the resulting vector is obtained from the Pythagorean identity,
+   unless there is severe cancellation.
+
+   j      - the index of the column to orthogonalize
+   norm   - (optional) norm of the vector after being orthogonalized
+   lindep - (optional) flag indicating possible linear dependence
+*/
+static PetscErrorCode BVOrthogonalizeCGSLowSync(BV bv,PetscInt j,PetscReal *norm,PetscBool *lindep)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,p,n,ld,i0;
+  PetscScalar    *G,*c,*t,*hh,*a,s;
+  PetscReal      beta2,sum,nrm,nrm1=0.0,nrm2;
+  PetscBool      refine;
+  Vec            w,z;
+
+  PetscFunctionBegin;
+  n  = bv->nc+j;   /* number of columns against which column j is orthogonalized */
+  ld = bv->nc+bv->m;
+  refine = (bv->orthog_ref==BV_ORTHOG_REFINE_NEVER)? PETSC_FALSE: PETSC_TRUE;
+  ierr = BV_AllocateCoeffs(bv);CHKERRQ(ierr);
+  c = bv->c;
+  t = bv->h;
+  if (refine && !bv->gram) {
+    ierr = PetscMalloc1(ld*ld,&bv->gram);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)bv,ld*ld*sizeof(PetscScalar));CHKERRQ(ierr);
+    bv->gramk = 0;
+  }
+  G  = bv->gram;
+  i0 = refine? PetscMin(bv->gramk,n): n;   /* first column of G that must be computed */
+
+  /* start the reduction: columns i0..n-1 of G, c = V'*v and (v,v) */
+  for (p=i0;p<n;p++) {
+    ierr = BVGetColumn(bv,p-bv->nc,&z);CHKERRQ(ierr);
+    bv->k = p-bv->nc+1;
+    ierr = BVDotVecBegin(bv,z,G+p*ld);CHKERRQ(ierr);
+    ierr = BVRestoreColumn(bv,p-bv->nc,&z);CHKERRQ(ierr);
+  }
+  ierr = BVGetColumn(bv,j,&w);CHKERRQ(ierr);
+  bv->k = j+1;
+  ierr = BVDotVecBegin(bv,w,c);CHKERRQ(ierr);
+  for (p=i0;p<n;p++) {
+    ierr = BVGetColumn(bv,p-bv->nc,&z);CHKERRQ(ierr);
+    bv->k = p-bv->nc+1;
+    ierr = BVDotVecEnd(bv,z,G+p*ld);CHKERRQ(ierr);
+    ierr = BVRestoreColumn(bv,p-bv->nc,&z);CHKERRQ(ierr);
+  }
+  bv->k = j+1;
+  ierr = BVDotVecEnd(bv,w,c);CHKERRQ(ierr);
+  ierr = BVRestoreColumn(bv,j,&w);CHKERRQ(ierr);
+  bv->k = j;
+  beta2 = PetscRealPart(c[n]);
+
+  ierr = VecGetArray(bv->buffer,&a);CHKERRQ(ierr);
+  hh = a + j*ld;
+  if (refine) {
+    /* t = G*c, where only the upper triangular part of G is stored */
+    for (p=0;p<n;p++) {
+      s = 0.0;
+      for (i=0;i<p;i++) s += PetscConj(G[i+p*ld])*c[i];
+      for (i=p;i<n;i++) s += G[p+i*ld]*c[i];
+      t[p] = s;
+    }
+    /* norm after the first pass, |v-V*c|^2 = (v,v)-2*c'*c+c'*G*c */
+    nrm1 = beta2;
+    for (p=0;p<n;p++) nrm1 += PetscRealPart(PetscConj(c[p])*(t[p]-2.0*c[p]));
+    nrm1 = (nrm1>0.0)? PetscSqrtReal(nrm1): 0.0;
+    /* h = c+(I-G)*c */
+    for (p=0;p<n;p++) hh[p] = 2.0*c[p]-t[p];
+    /* t = G*h */
+    for (p=0;p<n;p++) {
+      s = 0.0;
+      for (i=0;i<p;i++) s += PetscConj(G[i+p*ld])*hh[i];
+      for (i=p;i<n;i++) s += G[p+i*ld]*hh[i];
+      t[p] = s;
+    }
+    /* |v-V*h|^2 = (v,v)-2*Re(h'*c)+h'*G*h */
+    nrm2 = beta2;
+    for (p=0;p<n;p++) nrm2 += PetscRealPart(PetscConj(hh[p])*(t[p]-2.0*c[p]));
+    ierr = PetscLogFlops(4.0*n*n+10.0*n);CHKERRQ(ierr);
+  } else {
+    /* assume V orthonormal, |v-V*c|^2 = (v,v)-c'*c */
+    for (p=0;p<n;p++) hh[p] = c[p];
+    ierr = BV_SquareSum(bv,j,c,&sum);CHKERRQ(ierr);
+    nrm2 = beta2-sum;
+  }
+
+  /* v <- v - V*h */
+  ierr = BVMultColumn(bv,-1.0,1.0,j,hh);CHKERRQ(ierr);
+  ierr = VecRestoreArray(bv->buffer,&a);CHKERRQ(ierr);
+  if (refine) bv->gramk = n;
+
+  /* compute |v| explicitly in case of cancellation in the Pythagorean identity */
+  if (norm || lindep) {
+    if (nrm2 < 0.01*beta2) {
+      ierr = BVNormColumn(bv,j,NORM_2,&nrm);CHKERRQ(ierr);
+    } else nrm = PetscSqrtReal(nrm2);
+    if (lindep) {
+      if (refine) *lindep = PetscNot(nrm && nrm >= bv->orthog_eta*nrm1);
+      else *lindep = PetscNot(nrm);
+    }
+    if (norm) {
+      *norm = nrm;
+      /* store norm value next to the orthogonalization coefficients */
+      ierr = BV_SetValue(bv,j,j,NULL,(lindep && *lindep)? 0.0: nrm);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
    BVOrthogonalizeGS - Orthogonalize with (classical or modified) Gram-Schmidt
 
@@ -296,6 +414,10 @@ static PetscErrorCode BVOrthogonalizeGS(BV bv,PetscInt j,Vec v,PetscBool *which,
   PetscBool      mgs,dolindep,signature;
 
   PetscFunctionBegin;
+  if (bv->orthog_type==BV_ORTHOG_CGS_LOWSYNC && !v && !which && !bv->matrix) {
+    ierr = BVOrthogonalizeCGSLowSync(bv,j,norm,lindep);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (v) {
     k = bv->k;
     h = bv->h;
@@ -666,7 +788,7 @@ static PetscErrorCode BVOrthogonalize_GS(BV V,Mat R)
       ierr = BVOrthogonalizeColumn(V,j,NULL,&norm,NULL);CHKERRQ(ierr);
     }
     if (!norm) SETERRQ(PETSC_COMM_SELF,1,"Breakdown in BVOrthogonalize due to a linearly dependent column");
-    if (V->matrix && V->orthog_type==BV_ORTHOG_CGS) {  /* fill cached BV */
+    if (V->matrix && V->orthog_type!=BV_ORTHOG_MGS) {  /* fill cached BV */
       ierr = BVGetColumn(V->cached,j,&v);CHKERRQ(ierr);
       ierr = VecCopy(V->Bx,v);CHKERRQ(ierr);
       ierr = BVRestoreColumn(V->cached,j,&v);CHKERRQ(ierr);
@@ -764,6 +886,68 @@ static PetscErrorCode BVOrthogonalize_Chol(BV V,Mat Rin)
   PetscFunctionReturn(0);
 }
 
+/*
+   Orthogonalize a set of vectors with repeated Cholesky QR, two passes in
+   CholQR2 and three in shifted CholQR3, where the Gram matrix is shifted in
+   the first pass to guarantee that it is positive definite. The triangular
+   factors of each pass are accumulated in R
+ */
+static PetscErrorCode BVOrthogonalize_CholQR(BV V,Mat R,PetscBool shifted)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,p,npass,N,l=V->l,k=V->k,n=V->k-V->l,ld;
+  Mat            G,S;
+  PetscScalar    *pG,*pR,*T,sone=1.0;
+  PetscReal      shift;
+  PetscBLASInt   n_,k_;
+
+  PetscFunctionBegin;
+  npass = shifted? 3: 2;
+  ierr = PetscBLASIntCast(n,&n_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(k,&k_);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&G);CHKERRQ(ierr);
+  if (R) { ierr = PetscMalloc1(n*n,&T);CHKERRQ(ierr); }
+  for (p=0;p<npass;p++) {
+    ierr = BVDot(V,V,G);CHKERRQ(ierr);
+    if (shifted && !p) {
+      /* shift proportional to ||V||_F^2, see Fukaya et al., SISC 2020 */
+      ierr = BVGetSizes(V,NULL,&N,NULL);CHKERRQ(ierr);
+      ierr = MatDenseGetArray(G,&pG);CHKERRQ(ierr);
+      shift = 0.0;
+      for (i=l;i<k;i++) shift += PetscRealPart(pG[i+i*k]);
+      shift *= 11.0*((PetscReal)N*n+(PetscReal)n*(n+1))*PETSC_MACHINE_EPSILON;
+      for (i=l;i<k;i++) pG[i+i*k] += shift;
+      ierr = MatDenseRestoreArray(G,&pG);CHKERRQ(ierr);
+    }
+    ierr = MatCholeskyFactorInvert(G,l,&S);CHKERRQ(ierr);
+    ierr = BVMultInPlace(V,S,l,k);CHKERRQ(ierr);
+    ierr = MatDestroy(&S);CHKERRQ(ierr);
+    if (R) {  /* T = G*T */
+      ierr = MatDenseGetArray(G,&pG);CHKERRQ(ierr);
+      if (!p) {
+        for (j=0;j<n;j++) {
+          ierr = PetscMemcpy(T+j*n,pG+(l+j)*k+l,n*sizeof(PetscScalar));CHKERRQ(ierr);
+        }
+      } else {
+        PetscStackCallBLAS("BLAStrmm",BLAStrmm_("L","U","N","N",&n_,&n_,&sone,pG+l*k+l,&k_,T,&n_));
+        ierr = PetscLogFlops(1.0*n*n*n/3.0);CHKERRQ(ierr);
+      }
+      ierr = MatDenseRestoreArray(G,&pG);CHKERRQ(ierr);
+    }
+  }
+  if (R) {
+    ierr = MatGetSize(R,&ld,NULL);CHKERRQ(ierr);
+    ierr = MatDenseGetArray(R,&pR);CHKERRQ(ierr);
+    for (j=0;j<n;j++) {
+      ierr = PetscMemcpy(pR+(l+j)*ld+l,T+j*n,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    ierr = MatDenseRestoreArray(R,&pR);CHKERRQ(ierr);
+    ierr = PetscFree(T);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    Orthogonalize a set of vectors with the Tall-Skinny QR method
  */
@@ -848,6 +1032,12 @@ PetscErrorCode BVOrthogonalize(BV V,Mat R)
   case BV_ORTHOG_BLOCK_CHOL:
     ierr = BVOrthogonalize_Chol(V,R);CHKERRQ(ierr);
     break;
+  case BV_ORTHOG_BLOCK_CHOLQR2:
+    ierr = BVOrthogonalize_CholQR(V,R,PETSC_FALSE);CHKERRQ(ierr);
+    break;
+  case BV_ORTHOG_BLOCK_SCHOLQR3:
+    ierr = BVOrthogonalize_CholQR(V,R,PETSC_TRUE);CHKERRQ(ierr);
+    break;
   case BV_ORTHOG_BLOCK_TSQR:
     if (V->matrix) SETERRQ(PetscObjectComm((PetscObject)V),PETSC_ERR_SUP,"Orthogonalization method not available for non-standard inner product");
     ierr = BVOrthogonalize_TSQR(V,R);CHKERRQ(ierr);
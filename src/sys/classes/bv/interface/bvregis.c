@@ -25,6 +25,9 @@ PETSC_EXTERN PetscErrorCode BVCreate_Vecs(BV);
 PETSC_EXTERN PetscErrorCode BVCreate_Contiguous(BV);
 PETSC_EXTERN PetscErrorCode BVCreate_Svec(BV);
 PETSC_EXTERN PetscErrorCode BVCreate_Mat(BV);
+#if defined(PETSC_HAVE_UNISTD_H)
+PETSC_EXTERN PetscErrorCode BVCreate_MMap(BV);
+#endif
 
 /*@C
    BVRegisterAll - Registers all of the storage variants in the BV package.
@@ -46,6 +49,9 @@ PetscErrorCode BVRegisterAll(void)
   ierr = BVRegister(BVCONTIGUOUS,BVCreate_Contiguous);CHKERRQ(ierr);
   ierr = BVRegister(BVSVEC,BVCreate_Svec);CHKERRQ(ierr);
   ierr = BVRegister(BVMAT,BVCreate_Mat);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_UNISTD_H)
+  ierr = BVRegister(BVMMAP,BVCreate_MMap);CHKERRQ(ierr);
+#endif
   PetscFunctionReturn(0);
 }
 
@@ -28,6 +28,7 @@ int main(int argc,char **argv)
   PetscErrorCode ierr;
   DS             ds;
   FN             f1,f2,f3,funs[3],qfun;
+  RG             rg;
   SlepcSC        sc;
   PetscScalar    *Id,*A,*B,*wr,*wi,*X,coeffs[2];
   PetscReal      tau=0.001,h,a=20,xi,re,im,nrm,aux;
@@ -66,6 +67,11 @@ int main(int argc,char **argv)
   funs[2] = f3;
   ierr = DSNEPSetFN(ds,3,funs);CHKERRQ(ierr);
 
+  /* Set region, used by the contour integral and Newton methods */
+  ierr = RGCreate(PETSC_COMM_WORLD,&rg);CHKERRQ(ierr);
+  ierr = RGSetFromOptions(rg);CHKERRQ(ierr);
+  ierr = DSNEPSetRG(ds,rg);CHKERRQ(ierr);
+
   /* Set dimensions */
   ld = n+2;  /* test leading dimension larger than n */
   ierr = DSAllocate(ds,ld);CHKERRQ(ierr);
@@ -171,6 +177,7 @@ int main(int argc,char **argv)
   ierr = FNDestroy(&f1);CHKERRQ(ierr);
   ierr = FNDestroy(&f2);CHKERRQ(ierr);
   ierr = FNDestroy(&f3);CHKERRQ(ierr);
+  ierr = RGDestroy(&rg);CHKERRQ(ierr);
   ierr = DSDestroy(&ds);CHKERRQ(ierr);
   ierr = SlepcFinalize();
   return ierr;
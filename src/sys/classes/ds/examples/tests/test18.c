@@ -0,0 +1,104 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test DSSolveBatch with several DSHEP problems.\n\n";
+
+#include <slepcds.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  DS             *ds;
+  SlepcSC        sc;
+  PetscScalar    *A,*Q,*eig,r;
+  PetscReal      res,maxres=0.0;
+  PetscInt       i,j,k,l,n,ld,nds=4,off=0;
+
+  ierr = SlepcInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nds",&nds,NULL);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Solve a batch of %D dense systems of type HEP.\n",nds);CHKERRQ(ierr);
+
+  /* Create DS objects of dimension 4, 6, 8, ..., filled with symmetric Toeplitz matrices,
+     the leading dimension is larger than needed so that packing has some effect */
+  ierr = PetscMalloc1(nds,&ds);CHKERRQ(ierr);
+  for (k=0;k<nds;k++) {
+    n  = 4+2*k;
+    ld = 2*n;
+    off += n;
+    ierr = DSCreate(PETSC_COMM_WORLD,&ds[k]);CHKERRQ(ierr);
+    ierr = DSSetType(ds[k],DSHEP);CHKERRQ(ierr);
+    ierr = DSSetFromOptions(ds[k]);CHKERRQ(ierr);
+    ierr = DSAllocate(ds[k],ld);CHKERRQ(ierr);
+    ierr = DSSetDimensions(ds[k],n,0,0,0);CHKERRQ(ierr);
+    ierr = DSGetArray(ds[k],DS_MAT_A,&A);CHKERRQ(ierr);
+    for (i=0;i<n;i++) A[i+i*ld]=3.0;
+    for (j=1;j<3;j++) {
+      for (i=0;i<n-j;i++) { A[i+(i+j)*ld]=1.0; A[(i+j)+i*ld]=1.0; }
+    }
+    ierr = DSRestoreArray(ds[k],DS_MAT_A,&A);CHKERRQ(ierr);
+    ierr = DSSetState(ds[k],DS_STATE_RAW);CHKERRQ(ierr);
+    ierr = DSGetSlepcSC(ds[k],&sc);CHKERRQ(ierr);
+    sc->comparison    = SlepcCompareLargestMagnitude;
+    sc->comparisonctx = NULL;
+    sc->map           = NULL;
+    sc->mapobj        = NULL;
+  }
+
+  /* Solve all problems at once, the eigenvalues are packed contiguously */
+  ierr = PetscMalloc1(off,&eig);CHKERRQ(ierr);
+  ierr = DSSolveBatch(nds,ds,eig,NULL);CHKERRQ(ierr);
+
+  /* Sort and print eigenvalues */
+  off = 0;
+  for (k=0;k<nds;k++) {
+    ierr = DSGetDimensions(ds[k],&n,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+    ierr = DSSort(ds[k],eig+off,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Computed eigenvalues of problem %D =\n",k);CHKERRQ(ierr);
+    for (i=0;i<n;i++) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"  %.5f\n",(double)PetscRealPart(eig[off+i]));CHKERRQ(ierr);
+    }
+    /* check the eigenvectors in Q against the Toeplitz matrix */
+    ld = 2*n;
+    ierr = DSGetArray(ds[k],DS_MAT_Q,&Q);CHKERRQ(ierr);
+    for (j=0;j<n;j++) {
+      res = 0.0;
+      for (i=0;i<n;i++) {
+        r = (3.0-eig[off+j])*Q[i+j*ld];
+        for (l=PetscMax(0,i-2);l<=PetscMin(n-1,i+2);l++) if (l!=i) r += Q[l+j*ld];
+        res += PetscRealPart(r*PetscConj(r));
+      }
+      maxres = PetscMax(maxres,PetscSqrtReal(res));
+    }
+    ierr = DSRestoreArray(ds[k],DS_MAT_Q,&Q);CHKERRQ(ierr);
+    off += n;
+  }
+  if (maxres>100*off*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Wrong eigenvectors, the maximum residual is %g\n",(double)maxres);CHKERRQ(ierr);
+  }
+
+  for (k=0;k<nds;k++) {
+    ierr = DSDestroy(&ds[k]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(ds);CHKERRQ(ierr);
+  ierr = PetscFree(eig);CHKERRQ(ierr);
+  ierr = SlepcFinalize();
+  return ierr;
+}
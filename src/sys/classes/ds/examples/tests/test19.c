@@ -0,0 +1,117 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test DSNHEP in the arrow state.\n\n";
+
+#include <slepcds.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  DS             ds;
+  SlepcSC        sc;
+  PetscScalar    *A,*A0,*Q,*R,*wr,*wi;
+  PetscReal      re,im,nrm;
+  PetscInt       i,j,p,n=10,l=2,k=6,ld;
+  PetscViewer    viewer;
+
+  ierr = SlepcInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-l",&l,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+  if (l<0 || k<l || k>=n) SETERRQ(PETSC_COMM_WORLD,1,"Wrong value of l or k");
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Solve a Dense System of type NHEP in arrow form - dimension %D, l=%D, k=%D.\n",n,l,k);CHKERRQ(ierr);
+
+  /* Create DS object */
+  ierr = DSCreate(PETSC_COMM_WORLD,&ds);CHKERRQ(ierr);
+  ierr = DSSetType(ds,DSNHEP);CHKERRQ(ierr);
+  ierr = DSSetFromOptions(ds);CHKERRQ(ierr);
+  ld = n+2;  /* test leading dimension larger than n */
+  ierr = DSAllocate(ds,ld);CHKERRQ(ierr);
+  ierr = DSSetDimensions(ds,n,0,l,k);CHKERRQ(ierr);
+
+  /* Fill with a matrix that is upper triangular in the first k columns,
+     has a coupling row k, and is upper Hessenberg in the rest */
+  ierr = DSGetArray(ds,DS_MAT_A,&A);CHKERRQ(ierr);
+  for (j=0;j<n;j++) {
+    for (i=0;i<=PetscMin(j+1,n-1);i++) {
+      if (i==j) A[i+j*ld] = (PetscReal)(n-i);
+      else if (i<j) A[i+j*ld] = 1.0/(PetscReal)(j-i+1);
+      else if (j>=k) A[i+j*ld] = -1.0;
+    }
+  }
+  for (j=l;j<k;j++) A[k+j*ld] = 0.1*(PetscReal)(j+1);
+  ierr = PetscMalloc1(ld*ld,&A0);CHKERRQ(ierr);
+  ierr = PetscMemcpy(A0,A,ld*ld*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = DSRestoreArray(ds,DS_MAT_A,&A);CHKERRQ(ierr);
+  ierr = DSSetState(ds,DS_STATE_ARROW);CHKERRQ(ierr);
+
+  /* Solve */
+  ierr = PetscMalloc2(n,&wr,n,&wi);CHKERRQ(ierr);
+  ierr = DSGetSlepcSC(ds,&sc);CHKERRQ(ierr);
+  sc->comparison    = SlepcCompareLargestMagnitude;
+  sc->comparisonctx = NULL;
+  sc->map           = NULL;
+  sc->mapobj        = NULL;
+  ierr = DSSolve(ds,wr,wi);CHKERRQ(ierr);
+  ierr = DSSort(ds,wr,wi,NULL,NULL,NULL);CHKERRQ(ierr);
+
+  /* Print eigenvalues */
+  ierr = PetscViewerASCIIGetStdout(PETSC_COMM_WORLD,&viewer);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Computed eigenvalues =\n");CHKERRQ(ierr);
+  for (i=0;i<n;i++) {
+#if defined(PETSC_USE_COMPLEX)
+    re = PetscRealPart(wr[i]);
+    im = PetscImaginaryPart(wr[i]);
+#else
+    re = wr[i];
+    im = wi[i];
+#endif
+    if (PetscAbs(im)<1e-10) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  %.5f\n",(double)re);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIIPrintf(viewer,"  %.5f%+.5fi\n",(double)re,(double)im);CHKERRQ(ierr);
+    }
+  }
+
+  /* Check the Schur decomposition, R = A0*Q-Q*T */
+  ierr = DSGetArray(ds,DS_MAT_A,&A);CHKERRQ(ierr);
+  ierr = DSGetArray(ds,DS_MAT_Q,&Q);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n*n,&R);CHKERRQ(ierr);
+  for (j=0;j<n;j++) {
+    for (i=0;i<n;i++) {
+      for (p=0;p<n;p++) R[i+j*n] += A0[i+p*ld]*Q[p+j*ld]-Q[i+p*ld]*A[p+j*ld];
+    }
+  }
+  nrm = 0.0;
+  for (i=0;i<n*n;i++) nrm += PetscRealPart(R[i]*PetscConj(R[i]));
+  nrm = PetscSqrtReal(nrm);
+  ierr = DSRestoreArray(ds,DS_MAT_A,&A);CHKERRQ(ierr);
+  ierr = DSRestoreArray(ds,DS_MAT_Q,&Q);CHKERRQ(ierr);
+  if (nrm>100*n*PETSC_MACHINE_EPSILON) SETERRQ1(PETSC_COMM_WORLD,1,"Wrong Schur decomposition, the residual is %g",(double)nrm);
+
+  ierr = PetscFree2(wr,wi);CHKERRQ(ierr);
+  ierr = PetscFree(A0);CHKERRQ(ierr);
+  ierr = PetscFree(R);CHKERRQ(ierr);
+  ierr = DSDestroy(&ds);CHKERRQ(ierr);
+  ierr = SlepcFinalize();
+  return ierr;
+}
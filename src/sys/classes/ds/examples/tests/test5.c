@@ -30,7 +30,7 @@ int main(int argc,char **argv)
   SlepcSC        sc;
   PetscReal      re,im;
   PetscScalar    *A,*B,*eigr,*eigi;
-  PetscInt       i,j,n=10,ld;
+  PetscInt       i,j,n=10,ld,dims[3],dmin[3],dmax[3];
   PetscViewer    viewer;
   PetscBool      verbose;
 
@@ -85,6 +85,16 @@ int main(int argc,char **argv)
   sc->mapobj        = NULL;
   ierr = DSSolve(ds,eigr,eigi);CHKERRQ(ierr);
   ierr = DSSort(ds,eigr,eigi,NULL,NULL,NULL);CHKERRQ(ierr);
+  /* all processes must have the same dimensions after the solve, also with -ds_parallel synchronized */
+  ierr = DSGetDimensions(ds,NULL,NULL,&dims[0],&dims[1],&dims[2]);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(dims,dmin,3,MPIU_INT,MPI_MIN,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(dims,dmax,3,MPIU_INT,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  for (i=0;i<3;i++) {
+    if (dmin[i]!=dmax[i]) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Dimensions differ across processes: l=%D..%D, k=%D..%D, t=%D..%D\n",dmin[0],dmax[0],dmin[1],dmax[1],dmin[2],dmax[2]);CHKERRQ(ierr);
+      break;
+    }
+  }
   if (verbose) {
     ierr = PetscPrintf(PETSC_COMM_WORLD,"After solve - - - - - - - - -\n");CHKERRQ(ierr);
     ierr = DSView(ds,viewer);CHKERRQ(ierr);
@@ -31,11 +31,13 @@
       PetscEnum DS_STATE_INTERMEDIATE
       PetscEnum DS_STATE_CONDENSED
       PetscEnum DS_STATE_TRUNCATED
+      PetscEnum DS_STATE_ARROW
 
       parameter (DS_STATE_RAW                =  0)
       parameter (DS_STATE_INTERMEDIATE       =  1)
       parameter (DS_STATE_CONDENSED          =  2)
       parameter (DS_STATE_TRUNCATED          =  3)
+      parameter (DS_STATE_ARROW              =  4)
 
       PetscEnum DS_MAT_A
       PetscEnum DS_MAT_B
@@ -87,6 +89,14 @@
       parameter (DS_MAT_E9        = 22)
       parameter (DS_NUM_MAT       = 23)
 
+      PetscEnum DS_PARALLEL_REDUNDANT
+      PetscEnum DS_PARALLEL_SYNCHRONIZED
+      PetscEnum DS_PARALLEL_DISTRIBUTED
+
+      parameter (DS_PARALLEL_REDUNDANT    =  0)
+      parameter (DS_PARALLEL_SYNCHRONIZED =  1)
+      parameter (DS_PARALLEL_DISTRIBUTED  =  2)
+
 !
 !  End of Fortran include file for the DS package in SLEPc
 !
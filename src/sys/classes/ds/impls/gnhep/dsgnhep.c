@@ -275,8 +275,8 @@ static PetscErrorCode DSSort_GNHEP_Arbitrary(DS ds,PetscScalar *wr,PetscScalar *
   selection = ds->iwork;
   iwork     = ds->iwork + n;
   liwork    = ds->liwork - n;
-  /* Compute the selected eigenvalue to be in the leading position */
-  ierr = DSSortEigenvalues_Private(ds,rr,ri,ds->perm,PETSC_FALSE);CHKERRQ(ierr);
+  /* Compute the selected eigenvalue to be in the leading position, only the first k are needed */
+  ierr = DSSortEigenvaluesPartial_Private(ds,rr,ri,ds->perm,PETSC_FALSE,*k-ds->l);CHKERRQ(ierr);
   ierr = PetscMemzero(selection,n*sizeof(PetscBLASInt));CHKERRQ(ierr);
   for (i=0; i<*k; i++) selection[ds->perm[i]] = 1;
 #if !defined(PETSC_USE_COMPLEX)
@@ -22,6 +22,8 @@
 #include <slepc/private/dsimpl.h>
 #include <slepcblaslapack.h>
 
+#define DS_HEP_BANDWIDTH 32   /* maximum bandwidth in the first stage of DSTridiagTwoStage_HEP */
+
 PetscErrorCode DSAllocate_HEP(DS ds,PetscInt ld)
 {
   PetscErrorCode ierr;
@@ -109,7 +111,8 @@ PetscErrorCode DSView_HEP(DS ds,PetscViewer viewer)
                      "Implicit QR method (_steqr)",
                      "Relatively Robust Representations (_stevr)",
                      "Divide and Conquer method (_stedc)",
-                     "Block Divide and Conquer method (dsbtdc)"
+                     "Block Divide and Conquer method (dsbtdc)",
+                     "Two-stage tridiagonalization and Divide and Conquer (_sbtrd+_stedc)"
   };
   const int         nmeth=sizeof(methodname)/sizeof(methodname[0]);
 
@@ -301,9 +304,97 @@ static PetscErrorCode ArrowTridiag(PetscBLASInt n,PetscReal *d,PetscReal *e,Pets
 }
 
 /*
-   Reduce to tridiagonal form by means of ArrowTridiag.
+   Two-stage reduction to tridiagonal form of the n x n Hermitian matrix S,
+   accumulating the transformations in Q (that must be the identity on entry).
+   The first stage reduces S to band form with bandwidth nb by means of blocked
+   Householder reflectors, so that all the work on the trailing matrix is done
+   with BLAS-3 operations. The second stage reduces the band matrix to
+   tridiagonal form with _sbtrd, which costs only O(n^2*nb) flops.
+   On exit, S is overwritten.
+*/
+static PetscErrorCode DSTridiagTwoStage_HEP(DS ds,PetscBLASInt n,PetscScalar *S,PetscScalar *Q,PetscBLASInt ld,PetscReal *d,PetscReal *e)
+{
+#if defined(PETSC_MISSING_LAPACK_GEQRF) || defined(SLEPC_MISSING_LAPACK_LARFT) || defined(SLEPC_MISSING_LAPACK_SBTRD)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GEQRF/LARFT/SBTRD - Lapack routines are unavailable");
+#else
+  PetscErrorCode ierr;
+  PetscInt       i,j,c;
+  PetscBLASInt   nb,kd,m,k,ldab,lwork,info;
+  PetscScalar    *tau,*T,*M,*V,*X,*P,*AB,*work,*A22,one=1.0,zero=0.0,mone=-1.0,mhalf=-0.5;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  nb   = PetscMin(DS_HEP_BANDWIDTH,PetscMax(1,n/4));
+  kd   = PetscMin(nb,n-1);
+  ldab = kd+1;
+  lwork = nb*n;
+  ierr = DSAllocateWork_Private(ds,nb+2*nb*nb+3*nb*n+ldab*n+lwork,0,0);CHKERRQ(ierr);
+  tau  = ds->work;
+  T    = tau+nb;
+  M    = T+nb*nb;
+  V    = M+nb*nb;
+  X    = V+nb*n;
+  P    = X+nb*n;
+  AB   = P+nb*n;
+  work = AB+ldab*n;
+
+  /* the updates below work on the full matrix, so make it explicitly Hermitian */
+  for (j=0;j<n;j++) {
+    S[j+j*ld] = PetscRealPart(S[j+j*ld]);
+    for (i=j+1;i<n;i++) S[j+i*ld] = PetscConj(S[i+j*ld]);
+  }
+
+  /* First stage: annihilate the entries below the nb-th subdiagonal, one panel of nb columns at a time */
+  for (j=0;n-j-nb>1;j+=nb) {
+    m   = n-j-nb;
+    k   = PetscMin(nb,m);
+    A22 = S+(j+nb)+(j+nb)*ld;
+    PetscStackCallBLAS("LAPACKgeqrf",LAPACKgeqrf_(&m,&nb,S+(j+nb)+j*ld,&ld,tau,work,&lwork,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEQRF %d",info);
+
+    /* extract the Householder vectors, leaving only R in the panel */
+    for (c=0;c<k;c++) {
+      for (i=0;i<c;i++) V[i+c*m] = 0.0;
+      V[c+c*m] = 1.0;
+      for (i=c+1;i<m;i++) {
+        V[i+c*m] = S[(j+nb+i)+(j+c)*ld];
+        S[(j+nb+i)+(j+c)*ld] = 0.0;
+      }
+    }
+    PetscStackCallBLAS("LAPACKlarft",LAPACKlarft_("F","C",&m,&k,V,&m,tau,T,&nb));
+
+    /* A22 = H'*A22*H with H = I-V*T*V', computed as A22-V*X'-X*V' where
+       X = A22*V*T - 1/2*V*(T'*V'*A22*V*T) */
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&m,&k,&m,&one,A22,&ld,V,&m,&zero,X,&m));
+    PetscStackCallBLAS("BLAStrmm",BLAStrmm_("R","U","N","N",&m,&k,&one,T,&nb,X,&m));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&k,&k,&m,&one,V,&m,X,&m,&zero,M,&nb));
+    PetscStackCallBLAS("BLAStrmm",BLAStrmm_("L","U","C","N",&k,&k,&one,T,&nb,M,&nb));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&m,&k,&k,&mhalf,V,&m,M,&nb,&one,X,&m));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","C",&m,&m,&k,&mone,V,&m,X,&m,&one,A22,&ld));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","C",&m,&m,&k,&mone,X,&m,V,&m,&one,A22,&ld));
+
+    /* accumulate Q(:,j+nb:n-1) = Q(:,j+nb:n-1)*H */
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&k,&m,&one,Q+(j+nb)*ld,&ld,V,&m,&zero,P,&n));
+    PetscStackCallBLAS("BLAStrmm",BLAStrmm_("R","U","N","N",&n,&k,&one,T,&nb,P,&n));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","C",&n,&m,&k,&mone,P,&n,V,&m,&one,Q+(j+nb)*ld,&ld));
+  }
+
+  /* Second stage: copy the lower band to LAPACK band storage and reduce it to tridiagonal */
+  for (c=0;c<n;c++) {
+    for (i=c;i<=PetscMin(n-1,c+kd);i++) AB[i-c+c*ldab] = S[i+c*ld];
+  }
+  PetscStackCallBLAS("LAPACKsbtrd",LAPACKsbtrd_("U","L",&n,&kd,AB,&ldab,d,e,Q,&ld,work,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xSBTRD %d",info);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   Reduce to tridiagonal form by means of ArrowTridiag, or with _sytrd (or
+   DSTridiagTwoStage_HEP if twostage=PETSC_TRUE) in the non-compact case.
 */
-static PetscErrorCode DSIntermediate_HEP(DS ds)
+static PetscErrorCode DSIntermediate_HEP(DS ds,PetscBool twostage)
 {
 #if defined(SLEPC_MISSING_LAPACK_SYTRD) || defined(SLEPC_MISSING_LAPACK_ORGTR)
   PetscFunctionBegin;
@@ -338,7 +429,11 @@ static PetscErrorCode DSIntermediate_HEP(DS ds)
 
     for (i=0;i<l;i++) { d[i] = PetscRealPart(A[i+i*ld]); e[i] = 0.0; }
 
-    if (ds->state<DS_STATE_INTERMEDIATE) {
+    if (ds->state<DS_STATE_INTERMEDIATE && twostage) {
+      ierr = DSAllocateMat_Private(ds,DS_MAT_W);CHKERRQ(ierr);
+      ierr = DSCopyMatrix_Private(ds,DS_MAT_W,DS_MAT_A);CHKERRQ(ierr);
+      ierr = DSTridiagTwoStage_HEP(ds,n3,ds->mat[DS_MAT_W]+off,Q+off,ld,d+l,e+l);CHKERRQ(ierr);
+    } else if (ds->state<DS_STATE_INTERMEDIATE) {
       ierr = DSCopyMatrix_Private(ds,DS_MAT_Q,DS_MAT_A);CHKERRQ(ierr);
       ierr = DSAllocateWork_Private(ds,ld+ld*ld,0,0);CHKERRQ(ierr);
       tau  = ds->work;
@@ -444,7 +539,7 @@ PetscErrorCode DSSolve_HEP_QR(DS ds,PetscScalar *wr,PetscScalar *wi)
   e  = ds->rmat[DS_MAT_T]+ld;
 
   /* Reduce to tridiagonal form */
-  ierr = DSIntermediate_HEP(ds);CHKERRQ(ierr);
+  ierr = DSIntermediate_HEP(ds,PETSC_FALSE);CHKERRQ(ierr);
 
   /* Solve the tridiagonal eigenproblem */
   for (i=0;i<l;i++) wr[i] = d[i];
@@ -501,7 +596,7 @@ PetscErrorCode DSSolve_HEP_MRRR(DS ds,PetscScalar *wr,PetscScalar *wi)
   e  = ds->rmat[DS_MAT_T]+ld;
 
   /* Reduce to tridiagonal form */
-  ierr = DSIntermediate_HEP(ds);CHKERRQ(ierr);
+  ierr = DSIntermediate_HEP(ds,PETSC_FALSE);CHKERRQ(ierr);
 
   /* Solve the tridiagonal eigenproblem */
   for (i=0;i<l;i++) wr[i] = d[i];
@@ -553,7 +648,129 @@ PetscErrorCode DSSolve_HEP_MRRR(DS ds,PetscScalar *wr,PetscScalar *wi)
 #endif
 }
 
-PetscErrorCode DSSolve_HEP_DC(DS ds,PetscScalar *wr,PetscScalar *wi)
+/*
+   Distributed variant of the MRRR solver: the first process reduces to
+   tridiagonal form (this is the only sequential part), then the tridiagonal
+   matrix and the orthogonal matrix of the reduction are broadcast and each
+   process computes with MRRR a block of consecutive eigenpairs (selected by
+   index) and backtransforms them, as in ScaLAPACK's pdsyevr. Eigenvalues
+   and eigenvectors are finally gathered in all processes.
+*/
+PetscErrorCode DSSolve_HEP_MRRR_Distributed(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+#if defined(SLEPC_MISSING_LAPACK_STEVR)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"STEVR - Lapack routine is unavailable");
+#else
+  PetscErrorCode ierr,perr=0;
+  PetscInt       i,j,c0,c1;
+  PetscBLASInt   n1,n2,n3,nc,lwork,liwork,info=0,l,n,m,ld,off,il,iu,*isuppz;
+  PetscScalar    *A,*Q,*Qb,*Z,*X,one=1.0,zero=0.0;
+  PetscReal      *d,*e,*dd,*ee,*Zr,*ev,abstol=0.0,vl,vu;
+  PetscMPIInt    size,rank,p,count,*cnt,*disp,*ecnt,*edisp,linfo,ginfo;
+  MPI_Comm       comm=PetscObjectComm((PetscObject)ds);
+
+  PetscFunctionBegin;
+  if (ds->bs>1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This method is not prepared for bs>1");
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->l,&l);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->ld,&ld);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->k-l+1,&n1);CHKERRQ(ierr); /* size of leading block, excl. locked */
+  ierr = PetscBLASIntCast(n-ds->k-1,&n2);CHKERRQ(ierr); /* size of trailing block */
+  n3 = n1+n2;
+  off = l+l*ld;
+  A  = ds->mat[DS_MAT_A];
+  Q  = ds->mat[DS_MAT_Q];
+  d  = ds->rmat[DS_MAT_T];
+  e  = ds->rmat[DS_MAT_T]+ld;
+
+  /* Reduce to tridiagonal form in the first process */
+  if (!rank) perr = DSIntermediate_HEP(ds,PETSC_FALSE);
+  ierr = DSSynchronizeError_Private(ds,perr);CHKERRQ(ierr);
+  lwork  = 20*ld;
+  liwork = 10*ld;
+  ierr = DSAllocateWork_Private(ds,3*n3*n3,lwork+n3*n3+3*n3,liwork+2*ld);CHKERRQ(ierr);
+  Qb     = ds->work;
+  Z      = ds->work+n3*n3;
+  X      = ds->work+2*n3*n3;
+  Zr     = ds->rwork+lwork;
+  ev     = ds->rwork+lwork+n3*n3;
+  dd     = ds->rwork+lwork+n3*n3+n3;
+  ee     = ds->rwork+lwork+n3*n3+2*n3;
+  isuppz = ds->iwork+liwork;
+  if (!rank) {
+    for (j=0;j<n3;j++) {
+      ierr = PetscMemcpy(Qb+j*n3,Q+off+j*ld,n3*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscMPIIntCast(n,&count);CHKERRQ(ierr);
+  ierr = MPI_Bcast(d,count,MPIU_REAL,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Bcast(e,count,MPIU_REAL,0,comm);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(n3*n3,&count);CHKERRQ(ierr);
+  ierr = MPI_Bcast(Qb,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr);
+
+  /* Each process computes eigenpairs c0:c1-1 of the tridiagonal matrix */
+  ierr = PetscMalloc4(size,&cnt,size,&disp,size,&ecnt,size,&edisp);CHKERRQ(ierr);
+  for (p=0;p<size;p++) {
+    c0 = (n3/size)*p+PetscMin(p,n3%size);
+    c1 = c0+n3/size+((p<n3%size)?1:0);
+    ierr = PetscMPIIntCast(n3*c0,&disp[p]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(n3*(c1-c0),&cnt[p]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(c0,&edisp[p]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(c1-c0,&ecnt[p]);CHKERRQ(ierr);
+  }
+  c0 = (n3/size)*rank+PetscMin(rank,n3%size);
+  ierr = PetscBLASIntCast(n3/size+((rank<n3%size)?1:0),&nc);CHKERRQ(ierr);
+  if (nc) {
+    ierr = PetscMemcpy(dd,d+l,n3*sizeof(PetscReal));CHKERRQ(ierr);
+    ierr = PetscMemcpy(ee,e+l,n3*sizeof(PetscReal));CHKERRQ(ierr);
+    il = c0+1; iu = c0+nc;
+    PetscStackCallBLAS("LAPACKstevr",LAPACKstevr_("V","I",&n3,dd,ee,&vl,&vu,&il,&iu,&abstol,&m,ev,Zr,&n3,isuppz,ds->rwork,&lwork,ds->iwork,&liwork,&info));
+  }
+  linfo = PetscAbs((PetscMPIInt)info);
+  ierr = MPI_Allreduce(&linfo,&ginfo,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  if (ginfo) {
+    ierr = PetscFree4(cnt,disp,ecnt,edisp);CHKERRQ(ierr);
+    SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack DSTEVR %d",info? info: ginfo);
+  }
+
+  /* Backtransform in each process, X(:,c0:c1-1) = Qb*Z */
+  for (i=0;i<n3*nc;i++) Z[i] = Zr[i];
+  if (nc) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n3,&nc,&n3,&one,Qb,&n3,Z,&n3,&zero,X+n3*c0,&n3));
+    ierr = PetscMemcpy(d+l+c0,ev,nc*sizeof(PetscReal));CHKERRQ(ierr);
+  }
+  ierr = MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DATATYPE_NULL,X,cnt,disp,MPIU_SCALAR,comm);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DATATYPE_NULL,d+l,ecnt,edisp,MPIU_REAL,comm);CHKERRQ(ierr);
+  ierr = PetscFree4(cnt,disp,ecnt,edisp);CHKERRQ(ierr);
+  for (i=0;i<n;i++) {
+    ierr = PetscMemzero(Q+i*ld,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  for (i=0;i<l;i++) Q[i+i*ld] = 1.0;
+  for (j=0;j<n3;j++) {
+    ierr = PetscMemcpy(Q+off+j*ld,X+j*n3,n3*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  for (i=0;i<n;i++) wr[i] = d[i];
+
+  /* Create diagonal matrix as a result */
+  if (ds->compact) {
+    ierr = PetscMemzero(e,(n-1)*sizeof(PetscReal));CHKERRQ(ierr);
+  } else {
+    for (i=l;i<n;i++) {
+      ierr = PetscMemzero(A+l+i*ld,(n-l)*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    for (i=l;i<n;i++) A[i+i*ld] = d[i];
+  }
+
+  /* Set zero wi */
+  if (wi) for (i=l;i<n;i++) wi[i] = 0.0;
+  PetscFunctionReturn(0);
+#endif
+}
+
+static PetscErrorCode DSSolve_HEP_DC_Private(DS ds,PetscScalar *wr,PetscScalar *wi,PetscBool twostage)
 {
 #if defined(SLEPC_MISSING_LAPACK_STEDC)
   PetscFunctionBegin;
@@ -581,7 +798,7 @@ PetscErrorCode DSSolve_HEP_DC(DS ds,PetscScalar *wr,PetscScalar *wi)
   e  = ds->rmat[DS_MAT_T]+ld;
 
   /* Reduce to tridiagonal form */
-  ierr = DSIntermediate_HEP(ds);CHKERRQ(ierr);
+  ierr = DSIntermediate_HEP(ds,twostage);CHKERRQ(ierr);
 
   /* Solve the tridiagonal eigenproblem */
   for (i=0;i<l;i++) wr[i] = d[i];
@@ -618,6 +835,24 @@ PetscErrorCode DSSolve_HEP_DC(DS ds,PetscScalar *wr,PetscScalar *wi)
 #endif
 }
 
+PetscErrorCode DSSolve_HEP_DC(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DSSolve_HEP_DC_Private(ds,wr,wi,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DSSolve_HEP_TwoStage(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DSSolve_HEP_DC_Private(ds,wr,wi,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #if !defined(PETSC_USE_COMPLEX)
 PetscErrorCode DSSolve_HEP_BDC(DS ds,PetscScalar *wr,PetscScalar *wi)
 {
@@ -811,6 +1046,8 @@ PETSC_EXTERN PetscErrorCode DSCreate_HEP(DS ds)
 #if !defined(PETSC_USE_COMPLEX)
   ds->ops->solve[3]      = DSSolve_HEP_BDC;
 #endif
+  ds->ops->solve[4]      = DSSolve_HEP_TwoStage;
+  ds->ops->pdsolve[1]    = DSSolve_HEP_MRRR_Distributed;
   ds->ops->sort          = DSSort_HEP;
   ds->ops->truncate      = DSTruncate_HEP;
   ds->ops->update        = DSUpdateExtraRow_HEP;
@@ -22,10 +22,13 @@
 #include <slepc/private/dsimpl.h>       /*I "slepcds.h" I*/
 #include <slepcblaslapack.h>
 
+#define DS_NEP_NEWTON_MAXK 4   /* maximum size of the invariant pair in DSSolve_NEP_Newton */
+
 typedef struct {
   PetscInt nf;                 /* number of functions in f[] */
   FN       f[DS_NUM_EXTRA];    /* functions defining the nonlinear operator */
   PetscInt neig;               /* number of available eigenpairs */
+  RG       rg;                 /* region of interest, used in contour and Newton methods */
 } DS_NEP;
 
 /*
@@ -139,8 +142,8 @@ PetscErrorCode DSSort_NEP(DS ds,PetscScalar *wr,PetscScalar *wi,PetscScalar *rr,
     ierr = DSSortEigenvalues_Private(ds,wr,NULL,perm,PETSC_FALSE);CHKERRQ(ierr);
   }
   ds->t = told;  /* restore value of t */
-  for (i=l;i<n;i++) A[i+i*ld] = wr[perm[i]];
-  for (i=l;i<n;i++) wr[i] = A[i+i*ld];
+  for (i=l;i<ctx->neig;i++) A[i+i*ld] = wr[perm[i]];
+  for (i=l;i<ctx->neig;i++) wr[i] = A[i+i*ld];
   /* cannot use DSPermuteColumns_Private() since not all columns are filled */
   X  = ds->mat[DS_MAT_X];
   for (i=0;i<ctx->neig;i++) {
@@ -281,6 +284,398 @@ PetscErrorCode DSSolve_NEP_SLP(DS ds,PetscScalar *wr,PetscScalar *wi)
 #endif
 }
 
+PetscErrorCode DSSolve_NEP_Contour(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+#if !defined(PETSC_USE_COMPLEX)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"The contour integral method of DSNEP requires complex scalars");
+#elif defined(PETSC_MISSING_LAPACK_GESVD) || defined(PETSC_MISSING_LAPACK_GEEV) || defined(PETSC_MISSING_LAPACK_GETRF) || defined(PETSC_MISSING_LAPACK_GETRS)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GESVD/GEEV/GETRF/GETRS - Lapack routines are unavailable");
+#else
+  PetscErrorCode ierr;
+  DS_NEP         *ctx = (DS_NEP*)ds->data;
+  PetscScalar    *A,*W,*X,*A0,*A1,*U,*VT,*B,*V,*tmp,*z,*zi,*e,*work,w,sone=1.0,zero=0.0;
+  PetscReal      *sigma,*rwork,nrm;
+  PetscBLASInt   info,n,ld,r,lwork,*ipiv,one=1;
+  PetscInt       i,j,k,nnod=64,*inside;
+  PetscBool      istrivial;
+
+  PetscFunctionBegin;
+  if (!ctx->rg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The contour integral method of DSNEP requires a region, set it with DSNEPSetRG()");
+  ierr = RGIsTrivial(ctx->rg,&istrivial);CHKERRQ(ierr);
+  if (istrivial) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The contour integral method of DSNEP requires a nontrivial region");
+  if (!ds->mat[DS_MAT_A]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_A);CHKERRQ(ierr);
+  }
+  if (!ds->mat[DS_MAT_W]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_W);CHKERRQ(ierr);
+  }
+  ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->ld,&ld);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(5*ds->n,&lwork);CHKERRQ(ierr);
+  ierr = DSAllocateWork_Private(ds,2*nnod+7*ds->n*ds->n+ds->n+lwork,ds->n+lwork,2*ds->n);CHKERRQ(ierr);
+  z     = ds->work;
+  zi    = z+nnod;
+  A0    = zi+nnod;
+  A1    = A0+ds->n*ds->n;
+  U     = A1+ds->n*ds->n;
+  VT    = U+ds->n*ds->n;
+  B     = VT+ds->n*ds->n;
+  V     = B+ds->n*ds->n;
+  tmp   = V+ds->n*ds->n;
+  e     = tmp+ds->n*ds->n;
+  work  = e+ds->n;
+  sigma = ds->rwork;
+  rwork = ds->rwork+ds->n;
+  ipiv  = ds->iwork;
+  inside = ds->iwork+ds->n;
+  A = ds->mat[DS_MAT_A];
+  W = ds->mat[DS_MAT_W];
+  X = ds->mat[DS_MAT_X];
+
+  /* moments A0 = 1/(2*pi*i) int T(z)^{-1} dz and A1 = 1/(2*pi*i) int z*T(z)^{-1} dz,
+     approximated by the trapezoidal rule; the contour is parametrized at equally
+     spaced points, so central differences give dz up to a constant factor */
+  ierr = RGComputeContour(ctx->rg,nnod,z,zi);CHKERRQ(ierr);
+  ierr = PetscMemzero(A0,2*ds->n*ds->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (j=0;j<nnod;j++) {
+    ierr = DSNEPComputeMatrix(ds,z[j],PETSC_FALSE,DS_MAT_A);CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,A,&ld,ipiv,&info));
+    if (info<0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRF %d",info);
+    if (info>0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Singular T(z) at an integration point, try modifying the region");
+    ierr = PetscMemzero(W,ds->ld*ds->n*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (i=0;i<n;i++) W[i+i*ld] = 1.0;
+    PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&n,&n,A,&ld,ipiv,W,&ld,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRS %d",info);
+    w = (z[(j+1)%nnod]-z[(j+nnod-1)%nnod])/(4.0*PETSC_PI*PETSC_i);
+    for (k=0;k<n;k++) {
+      for (i=0;i<n;i++) {
+        A0[i+k*n] += w*W[i+k*ld];
+        A1[i+k*n] += w*z[j]*W[i+k*ld];
+      }
+    }
+  }
+
+  /* rank-revealing SVD of A0 = U*Sigma*V' */
+  PetscStackCallBLAS("LAPACKgesvd",LAPACKgesvd_("S","S",&n,&n,A0,&n,sigma,U,&n,VT,&n,work,&lwork,rwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESVD %d",info);
+  r = 0;
+  while (r<n && sigma[r]>PETSC_SQRT_MACHINE_EPSILON*sigma[0]) r++;
+  if (!r) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"DSNEP did not find any eigenvalue inside the region");
+
+  /* reduced linear problem B = U(:,1:r)'*A1*V(:,1:r)*inv(Sigma(1:r,1:r)) */
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","C",&n,&r,&n,&sone,A1,&n,VT,&n,&zero,tmp,&n));
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&r,&r,&n,&sone,U,&n,tmp,&n,&zero,B,&r));
+  for (j=0;j<r;j++) {
+    for (i=0;i<r;i++) B[i+j*r] /= sigma[j];
+  }
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","V",&r,B,&r,e,NULL,&r,V,&r,work,&lwork,rwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEEV %d",info);
+
+  /* keep the eigenpairs inside the region, with eigenvectors X = U(:,1:r)*V */
+  ierr = RGCheckInside(ctx->rg,r,e,NULL,inside);CHKERRQ(ierr);
+  k = 0;
+  for (j=0;j<r;j++) {
+    if (inside[j]<0) continue;
+    PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n,&r,&sone,U,&n,V+j*r,&one,&zero,X+k*ld,&one));
+    nrm = BLASnrm2_(&n,X+k*ld,&one);
+    w = 1.0/nrm;
+    PetscStackCallBLAS("BLASscal",BLASscal_(&n,&w,X+k*ld,&one));
+    wr[k] = e[j];
+    if (wi) wi[k] = 0.0;
+    k++;
+  }
+  if (!k) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"DSNEP did not find any eigenvalue inside the region");
+  ctx->neig = k;
+  PetscFunctionReturn(0);
+#endif
+}
+
+PetscErrorCode DSSolve_NEP_Newton(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+#if defined(SLEPC_MISSING_LAPACK_GGEV) || defined(PETSC_MISSING_LAPACK_GEEV) || defined(PETSC_MISSING_LAPACK_GETRF) || defined(PETSC_MISSING_LAPACK_GETRS)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GGEV/GEEV/GETRF/GETRS - Lapack routines are unavailable");
+#else
+  PetscErrorCode ierr;
+  DS_NEP         *ctx = (DS_NEP*)ds->data;
+  Mat            Sm,Fm,Zm,FZm;
+  PetscScalar    *A,*B,*W,*X,*E,*work,*alpha,*beta,*lr,*li;
+  PetscScalar    *Xk,*X0,*S,*R,*F,*AX,*J,*rhs,*V,*pM,*pF,mu,sone=1.0,szero=0.0,smone=-1.0;
+  PetscReal      nrm,nrmT,amin,tol;
+  PetscBLASInt   info,n,ld,lrwork=0,lwork,one=1,k_,k2,nk,nn,kk,*ipiv;
+  PetscInt       i,j,p,q,a,b,c,it,k,pos,res,nf=ctx->nf,maxit=30,*inside;
+  PetscBool      istrivial=PETSC_TRUE;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal      *rwork;
+#else
+  PetscScalar    *ei;
+  PetscReal      *alphai;
+#endif
+
+  PetscFunctionBegin;
+  if (!ds->mat[DS_MAT_A]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_A);CHKERRQ(ierr);
+  }
+  if (!ds->mat[DS_MAT_B]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_B);CHKERRQ(ierr);
+  }
+  if (!ds->mat[DS_MAT_W]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_W);CHKERRQ(ierr);
+  }
+  ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->ld,&ld);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscBLASIntCast(4*ds->n+2*ds->n,&lwork);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(8*ds->n,&lrwork);CHKERRQ(ierr);
+#else
+  ierr = PetscBLASIntCast(5*ds->n+8*ds->n,&lwork);CHKERRQ(ierr);
+#endif
+  ierr = DSAllocateWork_Private(ds,lwork,lrwork,ds->n);CHKERRQ(ierr);
+  alpha = ds->work;
+  beta  = ds->work+ds->n;
+  lr    = ds->work+2*ds->n;
+  li    = ds->work+3*ds->n;
+#if defined(PETSC_USE_COMPLEX)
+  work  = ds->work+4*ds->n;
+  lwork -= 4*ds->n;
+  rwork = ds->rwork;
+#else
+  alphai = ds->work+4*ds->n;
+  work  = ds->work+5*ds->n;
+  lwork -= 5*ds->n;
+#endif
+  inside = ds->iwork;
+  A = ds->mat[DS_MAT_A];
+  B = ds->mat[DS_MAT_B];
+  W = ds->mat[DS_MAT_W];
+  X = ds->mat[DS_MAT_X];
+
+  /* initial approximations from the linearization at sigma=0, that is,
+     lambda = -mu with T(0)*x = mu*T'(0)*x */
+  ierr = DSNEPComputeMatrix(ds,0.0,PETSC_FALSE,DS_MAT_A);CHKERRQ(ierr);
+  ierr = DSNEPComputeMatrix(ds,0.0,PETSC_TRUE,DS_MAT_B);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKggev",LAPACKggev_("N","V",&n,A,&ld,B,&ld,alpha,beta,NULL,&ld,W,&ld,work,&lwork,rwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack ZGGEV %d",info);
+#else
+  PetscStackCallBLAS("LAPACKggev",LAPACKggev_("N","V",&n,A,&ld,B,&ld,alpha,alphai,beta,NULL,&ld,W,&ld,work,&lwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack DGGEV %d",info);
+#endif
+  for (j=0;j<n;j++) {
+    lr[j] = (beta[j]==0.0)? PETSC_MAX_REAL: -alpha[j]/beta[j];
+#if defined(PETSC_USE_COMPLEX)
+    li[j] = 0.0;
+#else
+    li[j] = (beta[j]==0.0)? 0.0: -alphai[j]/beta[j];
+#endif
+  }
+
+  /* the size of the invariant pair is the number of approximations inside
+     the region, or one (the closest to the origin) if no region is given */
+  if (ctx->rg) {
+    ierr = RGIsTrivial(ctx->rg,&istrivial);CHKERRQ(ierr);
+  }
+  if (!istrivial) {
+    ierr = RGCheckInside(ctx->rg,n,lr,li,inside);CHKERRQ(ierr);
+  } else {
+    for (j=0;j<n;j++) inside[j] = -1;
+  }
+  k = 0;
+  for (j=0;j<n;j++) {
+    if (beta[j]==0.0 || li[j]!=0.0 || inside[j]<0) continue;
+    inside[k++] = j;
+  }
+  /* the Jacobian is dense of order n*k+k^2, so the size of the pair is limited to
+     DS_NEP_NEWTON_MAXK, keeping the first approximations according to the sorting criterion
+     (or the ones closest to the origin if there is none) */
+  if (k>DS_NEP_NEWTON_MAXK) {
+    for (j=0;j<DS_NEP_NEWTON_MAXK;j++) {
+      pos = j;
+      for (i=j+1;i<k;i++) {
+        if (ds->sc && ds->sc->comparison) {
+          ierr = SlepcSCCompare(ds->sc,lr[inside[pos]],0.0,lr[inside[i]],0.0,&res);CHKERRQ(ierr);
+        } else res = (PetscAbsScalar(lr[inside[i]])<PetscAbsScalar(lr[inside[pos]]))? 1: 0;
+        if (res>0) pos = i;
+      }
+      p = inside[j]; inside[j] = inside[pos]; inside[pos] = p;
+    }
+    k = DS_NEP_NEWTON_MAXK;
+  }
+  for (j=0;j<k;j++) {
+    ierr = PetscMemcpy(X+j*ld,W+inside[j]*ld,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    wr[j] = lr[inside[j]];
+  }
+  if (!k) {
+    /* in real scalars complex approximations are skipped, so the closest real one is taken */
+    pos = -1;
+    amin = PETSC_MAX_REAL;
+    for (j=0;j<n;j++) {
+      if (beta[j]==0.0 || li[j]!=0.0) continue;
+      nrm = PetscAbsScalar(lr[j]);
+      if (nrm<amin) { amin = nrm; pos = j; }
+    }
+#if !defined(PETSC_USE_COMPLEX)
+    if (pos<0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"DSNEP found only complex initial approximations; try rerunning with complex scalars");
+#else
+    if (pos<0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"DSNEP could not compute an initial approximation");
+#endif
+    ierr = PetscMemcpy(X,W+pos*ld,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    wr[k++] = lr[pos];
+  }
+
+  /* workspace for Newton's method on the invariant pair (X,S),
+     with unknowns [vec(X);vec(S)] of size nn */
+  ierr = PetscBLASIntCast(k,&k_);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(2*k,&k2);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(k*k,&kk);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->n*k,&nk);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->n*k+k*k,&nn);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(4*k,&lwork);CHKERRQ(ierr);
+  ierr = DSAllocateWork_Private(ds,3*nk+(nf+2)*kk+nf*nk+nn*nn+nn+2*k+lwork,2*k,nn);CHKERRQ(ierr);
+  Xk   = ds->work;
+  X0   = Xk+nk;
+  R    = X0+nk;
+  S    = R+nk;
+  V    = S+kk;
+  F    = V+kk;
+  AX   = F+nf*kk;
+  J    = AX+nf*nk;
+  rhs  = J+nn*nn;
+  lr   = rhs+nn;
+  work = lr+2*k;
+#if defined(PETSC_USE_COMPLEX)
+  rwork = ds->rwork;
+#else
+  ei   = lr+k;
+#endif
+  ipiv = ds->iwork;
+  for (j=0;j<k;j++) {
+    nrm = BLASnrm2_(&n,X+j*ld,&one);
+    for (i=0;i<n;i++) X0[i+j*n] = X[i+j*ld]/nrm;
+  }
+  ierr = PetscMemcpy(Xk,X0,nk*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(S,kk*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (j=0;j<k;j++) S[j+j*k] = wr[j];
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&Sm);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&Fm);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,2*k,2*k,NULL,&Zm);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,2*k,2*k,NULL,&FZm);CHKERRQ(ierr);
+  nrmT = 0.0;
+  for (i=0;i<nf;i++) {
+    E = ds->mat[DSMatExtra[i]];
+    nrm = 0.0;
+    for (j=0;j<n;j++) {
+      for (p=0;p<n;p++) nrm += PetscRealPart(E[p+j*ld]*PetscConj(E[p+j*ld]));
+    }
+    nrmT += PetscSqrtReal(nrm);
+  }
+  tol = 1000*n*PETSC_MACHINE_EPSILON;
+
+  for (it=0;it<maxit;it++) {
+
+    /* residual R = sum_i A_i*X*f_i(S) */
+    ierr = MatDenseGetArray(Sm,&pM);CHKERRQ(ierr);
+    ierr = PetscMemcpy(pM,S,kk*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = MatDenseRestoreArray(Sm,&pM);CHKERRQ(ierr);
+    ierr = PetscMemzero(R,nk*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (i=0;i<nf;i++) {
+      ierr = FNEvaluateFunctionMat(ctx->f[i],Sm,Fm);CHKERRQ(ierr);
+      ierr = MatDenseGetArray(Fm,&pF);CHKERRQ(ierr);
+      ierr = PetscMemcpy(F+i*kk,pF,kk*sizeof(PetscScalar));CHKERRQ(ierr);
+      ierr = MatDenseRestoreArray(Fm,&pF);CHKERRQ(ierr);
+      E = ds->mat[DSMatExtra[i]];
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&k_,&n,&sone,E,&ld,Xk,&n,&szero,AX+i*nk,&n));
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&k_,&k_,&sone,AX+i*nk,&n,F+i*kk,&k_,&sone,R,&n));
+    }
+    nrm = BLASnrm2_(&nk,R,&one);
+    ierr = PetscInfo2(ds,"Newton iteration %D, residual norm %g\n",it,(double)(nrm/nrmT));CHKERRQ(ierr);
+    if (nrm<=tol*nrmT) break;
+
+    /* Jacobian, first the derivative with respect to X, sum_i kron(f_i(S)^T,A_i) */
+    ierr = PetscMemzero(J,nn*nn*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (i=0;i<nf;i++) {
+      E = ds->mat[DSMatExtra[i]];
+      for (j=0;j<k;j++) {
+        for (q=0;q<k;q++) {
+          mu = F[i*kk+q+j*k];
+          if (mu==0.0) continue;
+          for (c=0;c<n;c++) {
+            for (p=0;p<n;p++) J[j*n+p+(q*n+c)*nn] += mu*E[p+c*ld];
+          }
+        }
+      }
+    }
+    /* derivative with respect to S, sum_i A_i*X*L_i(S,E_ab), where the Frechet
+       derivative L_i is the (1,2) block of f_i([S E_ab;0 S]) */
+    for (b=0;b<k;b++) {
+      for (a=0;a<k;a++) {
+        ierr = MatDenseGetArray(Zm,&pM);CHKERRQ(ierr);
+        ierr = PetscMemzero(pM,4*kk*sizeof(PetscScalar));CHKERRQ(ierr);
+        for (q=0;q<k;q++) {
+          for (p=0;p<k;p++) pM[p+q*k2] = pM[k+p+(k+q)*k2] = S[p+q*k];
+        }
+        pM[a+(k+b)*k2] = 1.0;
+        ierr = MatDenseRestoreArray(Zm,&pM);CHKERRQ(ierr);
+        for (i=0;i<nf;i++) {
+          ierr = FNEvaluateFunctionMat(ctx->f[i],Zm,FZm);CHKERRQ(ierr);
+          ierr = MatDenseGetArray(FZm,&pF);CHKERRQ(ierr);
+          PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&k_,&k_,&sone,AX+i*nk,&n,pF+k*k2,&k2,&sone,J+(nk+a+b*k)*nn,&n));
+          ierr = MatDenseRestoreArray(FZm,&pF);CHKERRQ(ierr);
+        }
+      }
+    }
+    /* normalization condition X0'*X = X0'*X0 */
+    for (j=0;j<k;j++) {
+      for (p=0;p<k;p++) {
+        for (c=0;c<n;c++) J[nk+p+j*k+(j*n+c)*nn] = PetscConj(X0[c+p*n]);
+      }
+    }
+
+    /* right-hand side and Newton correction */
+    for (i=0;i<nk;i++) {
+      rhs[i] = -R[i];
+      R[i] = Xk[i]-X0[i];
+    }
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&k_,&k_,&n,&smone,X0,&n,R,&n,&szero,rhs+nk,&k_));
+    PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&nn,&nn,J,&nn,ipiv,&info));
+    if (info<0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRF %d",info);
+    if (info>0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Singular Jacobian in the Newton method of DSNEP");
+    PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&nn,&one,J,&nn,ipiv,rhs,&nn,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRS %d",info);
+    PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&nk,&sone,rhs,&one,Xk,&one));
+    PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&kk,&sone,rhs+nk,&one,S,&one));
+  }
+  ierr = MatDestroy(&Sm);CHKERRQ(ierr);
+  ierr = MatDestroy(&Fm);CHKERRQ(ierr);
+  ierr = MatDestroy(&Zm);CHKERRQ(ierr);
+  ierr = MatDestroy(&FZm);CHKERRQ(ierr);
+  if (it==maxit) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"DSNEP did not converge");
+
+  /* eigenpairs of the invariant pair, S*V = V*diag(lambda), X*V */
+#if defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","V",&k_,S,&k_,lr,NULL,&k_,V,&k_,work,&lwork,rwork,&info));
+#else
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","V",&k_,S,&k_,lr,ei,NULL,&k_,V,&k_,work,&lwork,&info));
+#endif
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEEV %d",info);
+  for (j=0;j<k;j++) {
+#if !defined(PETSC_USE_COMPLEX)
+    if (ei[j]!=0.0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"DSNEP found a complex eigenvalue; try rerunning with complex scalars");
+#endif
+    PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n,&k_,&sone,Xk,&n,V+j*k,&one,&szero,X+j*ld,&one));
+    nrm = BLASnrm2_(&n,X+j*ld,&one);
+    mu = 1.0/nrm;
+    PetscStackCallBLAS("BLASscal",BLASscal_(&n,&mu,X+j*ld,&one));
+    wr[j] = lr[j];
+    if (wi) wi[j] = 0.0;
+  }
+  ctx->neig = k;
+  PetscFunctionReturn(0);
+#endif
+}
+
 static PetscErrorCode DSNEPSetFN_NEP(DS ds,PetscInt n,FN fn[])
 {
   PetscErrorCode ierr;
@@ -415,6 +810,107 @@ PetscErrorCode DSNEPGetNumFN(DS ds,PetscInt *n)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode DSNEPSetRG_NEP(DS ds,RG rg)
+{
+  PetscErrorCode ierr;
+  DS_NEP         *ctx = (DS_NEP*)ds->data;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectReference((PetscObject)rg);CHKERRQ(ierr);
+  ierr = RGDestroy(&ctx->rg);CHKERRQ(ierr);
+  ctx->rg = rg;
+  ierr = PetscLogObjectParent((PetscObject)ds,(PetscObject)ctx->rg);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DSNEPSetRG - Associates a region object to the nonlinear direct solver.
+
+   Collective on DS and RG
+
+   Input Parameters:
++  ds - the direct solver context
+-  rg - the region context
+
+   Notes:
+   The region is required by the contour integral method (DSSetMethod() with
+   value 1), whose integration path is the contour of the region. The Newton
+   method (value 2) uses it to determine the number of eigenpairs that are
+   computed, those whose initial approximations lie inside the region (at most
+   four, the first ones according to the sorting criterion).
+
+   In real scalars the Newton method works with real eigenvalues only, so
+   complex initial approximations are discarded. Without a region, the real
+   approximation closest to the origin is refined even if a complex one is
+   closer. Use complex scalars to compute complex eigenvalues.
+
+   Level: advanced
+
+.seealso: DSNEPGetRG(), DSSetMethod()
+@*/
+PetscErrorCode DSNEPSetRG(DS ds,RG rg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ds,DS_CLASSID,1);
+  PetscValidHeaderSpecific(rg,RG_CLASSID,2);
+  PetscCheckSameComm(ds,1,rg,2);
+  ierr = PetscTryMethod(ds,"DSNEPSetRG_C",(DS,RG),(ds,rg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DSNEPGetRG_NEP(DS ds,RG *rg)
+{
+  PetscErrorCode ierr;
+  DS_NEP         *ctx = (DS_NEP*)ds->data;
+
+  PetscFunctionBegin;
+  if (!ctx->rg) {
+    ierr = RGCreate(PetscObjectComm((PetscObject)ds),&ctx->rg);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)ds,(PetscObject)ctx->rg);CHKERRQ(ierr);
+  }
+  *rg = ctx->rg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DSNEPGetRG - Obtain the region object associated to the nonlinear
+   direct solver.
+
+   Not Collective
+
+   Input Parameter:
+.  ds - the direct solver context
+
+   Output Parameter:
+.  rg - the region context
+
+   Level: advanced
+
+.seealso: DSNEPSetRG()
+@*/
+PetscErrorCode DSNEPGetRG(DS ds,RG *rg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ds,DS_CLASSID,1);
+  PetscValidPointer(rg,2);
+  ierr = PetscUseMethod(ds,"DSNEPGetRG_C",(DS,RG*),(ds,rg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DSSynchronize_NEP(DS ds,PetscScalar *eigr,PetscScalar *eigi)
+{
+  PetscErrorCode ierr;
+  DS_NEP         *ctx = (DS_NEP*)ds->data;
+
+  PetscFunctionBegin;
+  ierr = MPI_Bcast(&ctx->neig,1,MPIU_INT,0,PetscObjectComm((PetscObject)ds));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DSDestroy_NEP(DS ds)
 {
   PetscErrorCode ierr;
@@ -425,10 +921,13 @@ PetscErrorCode DSDestroy_NEP(DS ds)
   for (i=0;i<ctx->nf;i++) {
     ierr = FNDestroy(&ctx->f[i]);CHKERRQ(ierr);
   }
+  ierr = RGDestroy(&ctx->rg);CHKERRQ(ierr);
   ierr = PetscFree(ds->data);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPSetFN_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPGetFN_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPGetNumFN_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPSetRG_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPGetRG_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -445,11 +944,16 @@ PETSC_EXTERN PetscErrorCode DSCreate_NEP(DS ds)
   ds->ops->view          = DSView_NEP;
   ds->ops->vectors       = DSVectors_NEP;
   ds->ops->solve[0]      = DSSolve_NEP_SLP;
+  ds->ops->solve[1]      = DSSolve_NEP_Contour;
+  ds->ops->solve[2]      = DSSolve_NEP_Newton;
   ds->ops->sort          = DSSort_NEP;
+  ds->ops->synchronize   = DSSynchronize_NEP;
   ds->ops->destroy       = DSDestroy_NEP;
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPSetFN_C",DSNEPSetFN_NEP);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPGetFN_C",DSNEPGetFN_NEP);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPGetNumFN_C",DSNEPGetNumFN_NEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPSetRG_C",DSNEPSetRG_NEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ds,"DSNEPGetRG_C",DSNEPGetRG_NEP);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -329,8 +329,8 @@ static PetscErrorCode DSSort_NHEP_Arbitrary(DS ds,PetscScalar *wr,PetscScalar *w
   work = ds->work;
   selection = ds->iwork;
 #endif
-  /* Compute the selected eigenvalue to be in the leading position */
-  ierr = DSSortEigenvalues_Private(ds,rr,ri,ds->perm,PETSC_FALSE);CHKERRQ(ierr);
+  /* Compute the selected eigenvalue to be in the leading position, only the first k are needed */
+  ierr = DSSortEigenvaluesPartial_Private(ds,rr,ri,ds->perm,PETSC_FALSE,*k-ds->l);CHKERRQ(ierr);
   ierr = PetscMemzero(selection,n*sizeof(PetscBLASInt));CHKERRQ(ierr);
   for (i=0;i<*k;i++) selection[ds->perm[i]] = 1;
 #if !defined(PETSC_USE_COMPLEX)
@@ -466,6 +466,86 @@ PetscErrorCode DSUpdateExtraRow_NHEP(DS ds)
   PetscFunctionReturn(0);
 }
 
+/*
+   Reduce to Hessenberg form a raw matrix with the DS_STATE_ARROW hint, that is, the block
+   of rows and columns l..k-1 is upper (quasi-)triangular, row k contains
+   the coupling entries in columns l..k-1, and the rest is upper Hessenberg.
+   Only the leading block and the coupling row are reduced, the orthogonal
+   transformation Z of order k-l is chosen so that Z'*T*Z is Hessenberg and
+   the coupling row becomes a multiple of e_{k-1}'. Z is computed with gehrd
+   applied to the flipped (k-l+1)x(k-l+1) matrix [0 0; P*conj(b) P*T'*P],
+   where P is the reversal permutation, and Q is set to diag(I,Z,I).
+*/
+static PetscErrorCode DSArrowHessenberg_NHEP(DS ds)
+{
+#if defined(SLEPC_MISSING_LAPACK_GEHRD) || defined(SLEPC_MISSING_LAPACK_ORGHR)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GEHRD/ORGHR - Lapack routines are unavailable");
+#else
+  PetscErrorCode ierr;
+  PetscInt       i,j,l=ds->l,k=ds->k;
+  PetscBLASInt   m,m1,ilo=1,lwork,info,ld,lr,nk,one=1;
+  PetscScalar    *A=ds->mat[DS_MAT_A],*Q=ds->mat[DS_MAT_Q],*E,*Z,*C,*tau,*work,sone=1.0,zero=0.0;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(ds->ld,&ld);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(k-l,&m);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(l,&lr);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->n-k,&nk);CHKERRQ(ierr);
+  m1 = m+1;
+  ierr = DSAllocateWork_Private(ds,4*ld*ld+ld,0,0);CHKERRQ(ierr);
+  E     = ds->work;
+  Z     = ds->work+ld*ld;
+  C     = ds->work+2*ld*ld;
+  tau   = ds->work+3*ld*ld;
+  work  = ds->work+3*ld*ld+ld;
+  lwork = ld*ld;
+
+  /* build the flipped matrix */
+  for (j=0;j<m1;j++) E[j*m1] = 0.0;
+  for (i=0;i<m;i++) {
+    E[i+1] = PetscConj(A[k+(k-1-i)*ld]);
+    for (j=0;j<m;j++) E[i+1+(j+1)*m1] = PetscConj(A[l+m-1-j+(l+m-1-i)*ld]);
+  }
+  PetscStackCallBLAS("LAPACKgehrd",LAPACKgehrd_(&m1,&ilo,&m1,E,&m1,tau,work,&lwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEHRD %d",info);
+
+  /* flip back the Hessenberg block and the coupling row */
+  for (j=0;j<m;j++) {
+    for (i=0;i<m;i++) A[l+i+(l+j)*ld] = (i<=j+1)? PetscConj(E[m-j+(m-i)*m1]): 0.0;
+    A[k+(l+j)*ld] = 0.0;
+  }
+  A[k+(k-1)*ld] = PetscConj(E[1]);
+
+  /* form Z and apply it to the off-diagonal blocks */
+  PetscStackCallBLAS("LAPACKorghr",LAPACKorghr_(&m1,&ilo,&m1,E,&m1,tau,work,&lwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xORGHR %d",info);
+  for (j=0;j<m;j++) {
+    for (i=0;i<m;i++) Z[i+j*m] = E[m-i+(m-j)*m1];
+  }
+  if (lr) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&lr,&m,&m,&sone,A+l*ld,&ld,Z,&m,&zero,C,&lr));
+    for (j=0;j<m;j++) {
+      for (i=0;i<l;i++) A[i+(l+j)*ld] = C[i+j*l];
+    }
+  }
+  if (ds->extrarow) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&one,&m,&m,&sone,A+ds->n+l*ld,&ld,Z,&m,&zero,C,&one));
+    for (j=0;j<m;j++) A[ds->n+(l+j)*ld] = C[j];
+  }
+  if (nk) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&m,&nk,&m,&sone,Z,&m,A+l+k*ld,&ld,&zero,C,&m));
+    for (j=0;j<nk;j++) {
+      for (i=0;i<m;i++) A[l+i+(k+j)*ld] = C[i+j*m];
+    }
+  }
+  for (j=0;j<m;j++) {
+    for (i=0;i<m;i++) Q[l+i+(l+j)*ld] = Z[i+j*m];
+  }
+  PetscFunctionReturn(0);
+#endif
+}
+
 PetscErrorCode DSSolve_NHEP(DS ds,PetscScalar *wr,PetscScalar *wi)
 {
 #if defined(SLEPC_MISSING_LAPACK_GEHRD) || defined(SLEPC_MISSING_LAPACK_ORGHR) || defined(PETSC_MISSING_LAPACK_HSEQR)
@@ -486,10 +566,6 @@ PetscErrorCode DSSolve_NHEP(DS ds,PetscScalar *wr,PetscScalar *wi)
   ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(ds->ld,&ld);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(ds->l+1,&ilo);CHKERRQ(ierr);
-  ierr = DSAllocateWork_Private(ds,ld+ld*ld,0,0);CHKERRQ(ierr);
-  tau  = ds->work;
-  work = ds->work+ld;
-  lwork = ld*ld;
 
   /* initialize orthogonal matrix */
   ierr = PetscMemzero(Q,ld*ld*sizeof(PetscScalar));CHKERRQ(ierr);
@@ -501,8 +577,17 @@ PetscErrorCode DSSolve_NHEP(DS ds,PetscScalar *wr,PetscScalar *wi)
     PetscFunctionReturn(0);
   }
 
+  /* in the arrow state only the kept Schur block and the coupling row need reduction */
+  if (ds->arrow && ds->k>ds->l+1 && ds->k<ds->n) {
+    ierr = DSArrowHessenberg_NHEP(ds);CHKERRQ(ierr);
+  }
+  ierr = DSAllocateWork_Private(ds,ld+ld*ld,0,0);CHKERRQ(ierr);
+  tau  = ds->work;
+  work = ds->work+ld;
+  lwork = ld*ld;
+
   /* reduce to upper Hessenberg form */
-  if (ds->state<DS_STATE_INTERMEDIATE) {
+  if (ds->state<DS_STATE_INTERMEDIATE && !ds->arrow) {
     PetscStackCallBLAS("LAPACKgehrd",LAPACKgehrd_(&n,&ilo,&n,A,&ld,tau,work,&lwork,&info));
     if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEHRD %d",info);
     for (j=0;j<n-1;j++) {
@@ -24,6 +24,7 @@
 
 typedef struct {
   PetscInt d;              /* polynomial degree */
+  DS       dsg;            /* auxiliary DSGHIEP for symmetric quadratic problems */
 } DS_PEP;
 
 PetscErrorCode DSAllocate_PEP(DS ds,PetscInt ld)
@@ -127,6 +128,50 @@ PetscErrorCode DSSort_PEP(DS ds,PetscScalar *wr,PetscScalar *wi,PetscScalar *rr,
   PetscFunctionReturn(0);
 }
 
+/*
+   Normalize the columns of X and Y, complex conjugate pairs in real arithmetic
+   are stored in two consecutive columns
+*/
+static PetscErrorCode DSPEPNormalizeVectors_Private(DS ds,PetscScalar *wi)
+{
+  DS_PEP         *ctx = (DS_PEP*)ds->data;
+  PetscInt       j;
+  PetscScalar    *X = ds->mat[DS_MAT_X],*Y = ds->mat[DS_MAT_Y],norm;
+  PetscBLASInt   n,nd,one=1;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscScalar    norm0;
+#endif
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(ds->n*ctx->d,&nd);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
+  for (j=0;j<nd;j++) {
+#if !defined(PETSC_USE_COMPLEX)
+    if (wi[j] != 0.0) {
+      norm = BLASnrm2_(&n,X+j*ds->ld,&one);
+      norm0 = BLASnrm2_(&n,X+(j+1)*ds->ld,&one);
+      norm = 1.0/SlepcAbsEigenvalue(norm,norm0);
+      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,X+j*ds->ld,&one));
+      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,X+(j+1)*ds->ld,&one));
+      norm = BLASnrm2_(&n,Y+j*ds->ld,&one);
+      norm0 = BLASnrm2_(&n,Y+(j+1)*ds->ld,&one);
+      norm = 1.0/SlepcAbsEigenvalue(norm,norm0);
+      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,Y+j*ds->ld,&one));
+      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,Y+(j+1)*ds->ld,&one));
+      j++;
+    } else
+#endif
+    {
+      norm = 1.0/BLASnrm2_(&n,X+j*ds->ld,&one);
+      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,X+j*ds->ld,&one));
+      norm = 1.0/BLASnrm2_(&n,Y+j*ds->ld,&one);
+      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,Y+j*ds->ld,&one));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DSSolve_PEP_QZ(DS ds,PetscScalar *wr,PetscScalar *wi)
 {
 #if defined(SLEPC_MISSING_LAPACK_GGEV)
@@ -136,12 +181,10 @@ PetscErrorCode DSSolve_PEP_QZ(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscErrorCode ierr;
   DS_PEP         *ctx = (DS_PEP*)ds->data;
   PetscInt       i,j,off;
-  PetscScalar    *A,*B,*W,*X,*U,*Y,*E,*work,*beta,norm;
-  PetscBLASInt   info,n,ldd,nd,lrwork=0,lwork,one=1;
+  PetscScalar    *A,*B,*W,*X,*U,*Y,*E,*work,*beta;
+  PetscBLASInt   info,ldd,nd,lrwork=0,lwork;
 #if defined(PETSC_USE_COMPLEX)
   PetscReal      *rwork;
-#else
-  PetscScalar    norm0;
 #endif
 
   PetscFunctionBegin;
@@ -158,7 +201,6 @@ PetscErrorCode DSSolve_PEP_QZ(DS ds,PetscScalar *wr,PetscScalar *wi)
     ierr = DSAllocateMat_Private(ds,DS_MAT_U);CHKERRQ(ierr);
   }
   ierr = PetscBLASIntCast(ds->n*ctx->d,&nd);CHKERRQ(ierr);
-  ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(ds->ld*ctx->d,&ldd);CHKERRQ(ierr);
 #if defined(PETSC_USE_COMPLEX)
   ierr = PetscBLASIntCast(nd+2*nd,&lwork);CHKERRQ(ierr);
@@ -216,34 +258,284 @@ PetscErrorCode DSSolve_PEP_QZ(DS ds,PetscScalar *wr,PetscScalar *wi)
 #endif
   }
 
-  /* copy and normalize eigenvectors */
+  /* copy eigenvectors */
   for (j=0;j<nd;j++) {
     ierr = PetscMemcpy(X+j*ds->ld,W+j*ldd,ds->n*sizeof(PetscScalar));CHKERRQ(ierr);
     ierr = PetscMemcpy(Y+j*ds->ld,U+ds->n*(ctx->d-1)+j*ldd,ds->n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
-  for (j=0;j<nd;j++) {
+  ierr = DSPEPNormalizeVectors_Private(ds,wi);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   Companion linearization transformed to a standard eigenproblem. The
+   polynomial is first scaled, P(gamma*mu) with gamma=(||A_0||/||A_d||)^(1/d),
+   then the leading coefficient is factored and the block companion matrix
+   with identity superdiagonal blocks and last block row -A_d\A_i is solved
+   with the Hessenberg QR algorithm (about a third of the cost of QZ on the
+   pencil). When A_d is (numerically) singular the QZ method is used instead.
+*/
+PetscErrorCode DSSolve_PEP_Companion(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+#if defined(PETSC_MISSING_LAPACK_GEEV) || defined(PETSC_MISSING_LAPACK_GETRF) || defined(PETSC_MISSING_LAPACK_GETRS)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GEEV/GETRF/GETRS - Lapack routines are unavailable");
+#else
+  PetscErrorCode ierr;
+  DS_PEP         *ctx = (DS_PEP*)ds->data;
+  PetscInt       i,j,k,off;
+  PetscScalar    *A,*W,*X,*U,*Y,*E,*F,*work,s;
+  PetscReal      gamma=1.0,nrm0,nrmd,umin,umax,*rwork;
+  PetscBLASInt   info,n,ldd,nd,ld,lwork,*ipiv;
+#if defined(PETSC_USE_COMPLEX)
+  PetscInt       lrwork=2*ds->ld*ctx->d;
+#else
+  PetscInt       lrwork=ds->ld;
+#endif
+
+  PetscFunctionBegin;
+  if (!ds->mat[DS_MAT_A]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_A);CHKERRQ(ierr);
+  }
+  if (!ds->mat[DS_MAT_W]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_W);CHKERRQ(ierr);
+  }
+  if (!ds->mat[DS_MAT_U]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_U);CHKERRQ(ierr);
+  }
+  ierr = PetscBLASIntCast(ds->n*ctx->d,&nd);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->n,&n);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->ld,&ld);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ds->ld*ctx->d,&ldd);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(8*nd,&lwork);CHKERRQ(ierr);
+  ierr = DSAllocateWork_Private(ds,ld*ld+lwork,lrwork,ld);CHKERRQ(ierr);
+  F     = ds->work;
+  work  = ds->work+ld*ld;
+  rwork = ds->rwork;
+  ipiv  = ds->iwork;
+  A = ds->mat[DS_MAT_A];
+  W = ds->mat[DS_MAT_W];
+  U = ds->mat[DS_MAT_U];
+  X = ds->mat[DS_MAT_X];
+  Y = ds->mat[DS_MAT_Y];
+  E = ds->mat[DSMatExtra[ctx->d]];
+
+  /* scaling of the eigenvalue parameter */
+  nrm0 = LAPACKlange_("F",&n,&n,ds->mat[DSMatExtra[0]],&ld,rwork);
+  nrmd = LAPACKlange_("F",&n,&n,E,&ld,rwork);
+  if (nrm0>0.0 && nrmd>0.0) gamma = PetscPowReal(nrm0/nrmd,1.0/ctx->d);
+
+  /* LU factorization of the scaled leading coefficient, F = gamma^d*A_d */
+  s = PetscPowReal(gamma,(PetscReal)ctx->d);
+  for (j=0;j<ds->n;j++) {
+    for (i=0;i<ds->n;i++) F[i+j*ds->ld] = s*E[i+j*ds->ld];
+  }
+  PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,F,&ld,ipiv,&info));
+  if (info<0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRF %d",info);
+  umin = PETSC_MAX_REAL; umax = 0.0;
+  for (i=0;i<ds->n;i++) {
+    umin = PetscMin(umin,PetscAbsScalar(F[i+i*ds->ld]));
+    umax = PetscMax(umax,PetscAbsScalar(F[i+i*ds->ld]));
+  }
+  if (info || umin<=ds->n*PETSC_MACHINE_EPSILON*umax) {
+    ierr = PetscInfo(ds,"Singular leading coefficient, switching to QZ on the linearization\n");CHKERRQ(ierr);
+    ierr = DSSolve_PEP_QZ(ds,wr,wi);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  /* build the block companion matrix */
+  ierr = PetscMemzero(A,ldd*ldd*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (i=0;i<nd-ds->n;i++) A[i+(i+ds->n)*ldd] = 1.0;
+  off = (ctx->d-1)*ds->n;
+  for (k=0;k<ctx->d;k++) {
+    s = -PetscPowReal(gamma,(PetscReal)k);
+    for (j=0;j<ds->n;j++) {
+      for (i=0;i<ds->n;i++) A[off+i+(k*ds->n+j)*ldd] = s*ds->mat[DSMatExtra[k]][i+j*ds->ld];
+    }
+  }
+  PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&n,&nd,F,&ld,ipiv,A+off,&ldd,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRS %d",info);
+
+  /* solve the standard eigenproblem, U and W contain left and right eigenvectors */
+#if defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("V","V",&nd,A,&ldd,wr,U,&ldd,W,&ldd,work,&lwork,rwork,&info));
+#else
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("V","V",&nd,A,&ldd,wr,wi,U,&ldd,W,&ldd,work,&lwork,&info));
+#endif
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEEV %d",info);
+  for (i=0;i<nd;i++) {
+    wr[i] *= gamma;
 #if !defined(PETSC_USE_COMPLEX)
-    if (wi[j] != 0.0) {
-      norm = BLASnrm2_(&n,X+j*ds->ld,&one);
-      norm0 = BLASnrm2_(&n,X+(j+1)*ds->ld,&one);
-      norm = 1.0/SlepcAbsEigenvalue(norm,norm0);
-      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,X+j*ds->ld,&one));
-      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,X+(j+1)*ds->ld,&one));
-      norm = BLASnrm2_(&n,Y+j*ds->ld,&one);
-      norm0 = BLASnrm2_(&n,Y+(j+1)*ds->ld,&one);
-      norm = 1.0/SlepcAbsEigenvalue(norm,norm0);
-      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,Y+j*ds->ld,&one));
-      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,Y+(j+1)*ds->ld,&one));
-      j++;
-    } else
+    wi[i] *= gamma;
+#else
+    if (wi) wi[i] = 0.0;
 #endif
-    {
-      norm = 1.0/BLASnrm2_(&n,X+j*ds->ld,&one);
-      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,X+j*ds->ld,&one));
-      norm = 1.0/BLASnrm2_(&n,Y+j*ds->ld,&one);
-      PetscStackCallBLAS("BLASscal",BLASscal_(&n,&norm,Y+j*ds->ld,&one));
+  }
+
+  /* right eigenvectors are the first block, left eigenvectors of the
+     polynomial are F^{-*} times the last block of those of the companion */
+  for (j=0;j<nd;j++) {
+    ierr = PetscMemcpy(X+j*ds->ld,W+j*ldd,ds->n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemcpy(Y+j*ds->ld,U+off+j*ldd,ds->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("C",&n,&nd,F,&ld,ipiv,Y,&ld,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRS %d",info);
+  ierr = DSPEPNormalizeVectors_Private(ds,wi);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   Symmetric quadratic problems, (K+lambda*C+lambda^2*M)x=0 with K, C, M real
+   symmetric, are solved with the symmetric linearization
+
+       A = [-K 0; 0 M],   B = [C M; M 0].
+
+   The indefinite matrix B is written as B = G*Omega*G' with G = V*|L|^(1/2)
+   from its eigendecomposition B = V*L*V', so that inv(G)*A*inv(G)' and the
+   signature Omega = sign(L) define a problem of type DSGHIEP that is solved
+   with the HZ algorithm. Other problems, and those with singular M, are
+   solved with DSSolve_PEP_Companion().
+*/
+PetscErrorCode DSSolve_PEP_GHIEP(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+#if defined(PETSC_USE_COMPLEX)
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscInfo(ds,"The symmetric solver is available only for real scalars, using the companion solver\n");CHKERRQ(ierr);
+  ierr = DSSolve_PEP_Companion(ds,wr,wi);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#elif defined(PETSC_MISSING_LAPACK_SYEV)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"SYEV - Lapack routine is unavailable");
+#else
+  PetscErrorCode ierr;
+  DS_PEP         *ctx = (DS_PEP*)ds->data;
+  PetscInt       i,j,k,n=ds->n,ld=ds->ld;
+  PetscScalar    *K,*C,*M,*A,*B,*W,*X,*Y,*Ag,*Bg,*Xg,*lam,*work,sone=1.0,mone=-1.0,zero=0.0;
+  PetscReal      amax,lmin,lmax;
+  PetscBLASInt   nb,ldb,n2,ldd,lwork,info;
+  PetscBool      symm=PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscValidPointer(wi,3);
+  if (ctx->d!=2) {
+    ierr = PetscInfo(ds,"The symmetric solver is available only for quadratic problems, using the companion solver\n");CHKERRQ(ierr);
+    ierr = DSSolve_PEP_Companion(ds,wr,wi);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  K = ds->mat[DS_MAT_E0];
+  C = ds->mat[DS_MAT_E1];
+  M = ds->mat[DS_MAT_E2];
+  for (k=0;k<3 && symm;k++) {
+    A = ds->mat[DSMatExtra[k]];
+    amax = 0.0;
+    for (j=0;j<n;j++) {
+      for (i=0;i<n;i++) amax = PetscMax(amax,PetscAbsScalar(A[i+j*ld]));
+    }
+    for (j=0;j<n && symm;j++) {
+      for (i=j+1;i<n;i++) {
+        if (PetscAbsScalar(A[i+j*ld]-A[j+i*ld])>10*n*PETSC_MACHINE_EPSILON*amax) { symm = PETSC_FALSE; break; }
+      }
+    }
+  }
+  if (!symm) {
+    ierr = PetscInfo(ds,"Coefficient matrices are not symmetric, using the companion solver\n");CHKERRQ(ierr);
+    ierr = DSSolve_PEP_Companion(ds,wr,wi);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  if (!ds->mat[DS_MAT_B]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_B);CHKERRQ(ierr);
+  }
+  if (!ds->mat[DS_MAT_W]) {
+    ierr = DSAllocateMat_Private(ds,DS_MAT_W);CHKERRQ(ierr);
+  }
+  ierr = PetscBLASIntCast(2*n,&n2);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(2*ld,&ldd);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(34*n2,&lwork);CHKERRQ(ierr);
+  ierr = DSAllocateWork_Private(ds,n2+lwork,0,0);CHKERRQ(ierr);
+  lam  = ds->work;
+  work = ds->work+n2;
+  B = ds->mat[DS_MAT_B];
+  W = ds->mat[DS_MAT_W];
+  X = ds->mat[DS_MAT_X];
+  Y = ds->mat[DS_MAT_Y];
+
+  /* eigendecomposition of B = [C M; M 0] */
+  ierr = PetscMemzero(B,ldd*ldd*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (j=0;j<n;j++) {
+    for (i=0;i<n;i++) {
+      B[i+j*ldd]     = C[i+j*ld];
+      B[n+i+j*ldd]   = M[i+j*ld];
+      B[i+(n+j)*ldd] = M[i+j*ld];
+    }
+  }
+  PetscStackCallBLAS("LAPACKsyev",LAPACKsyev_("V","L",&n2,B,&ldd,lam,work,&lwork,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xSYEV %d",info);
+  lmin = PETSC_MAX_REAL; lmax = 0.0;
+  for (i=0;i<n2;i++) {
+    lmin = PetscMin(lmin,PetscAbsReal(lam[i]));
+    lmax = PetscMax(lmax,PetscAbsReal(lam[i]));
+  }
+  if (lmin<=n2*PETSC_MACHINE_EPSILON*lmax) {
+    ierr = PetscInfo(ds,"Singular leading coefficient, using the companion solver\n");CHKERRQ(ierr);
+    ierr = DSSolve_PEP_Companion(ds,wr,wi);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* B := G^{-T} = V*|L|^{-1/2} */
+  for (j=0;j<n2;j++) {
+    lmin = 1.0/PetscSqrtReal(PetscAbsReal(lam[j]));
+    for (i=0;i<n2;i++) B[i+j*ldd] *= lmin;
+  }
+
+  /* set up the auxiliary DSGHIEP with inv(G)*A*inv(G)' and the signature */
+  if (!ctx->dsg) {
+    ierr = DSCreate(PETSC_COMM_SELF,&ctx->dsg);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)ds,(PetscObject)ctx->dsg);CHKERRQ(ierr);
+    ierr = DSSetType(ctx->dsg,DSGHIEP);CHKERRQ(ierr);
+    ierr = DSSetMethod(ctx->dsg,1);CHKERRQ(ierr);
+  }
+  ierr = DSAllocate(ctx->dsg,2*ld);CHKERRQ(ierr);
+  ierr = DSSetDimensions(ctx->dsg,2*n,0,0,0);CHKERRQ(ierr);
+  ierr = DSGetArray(ctx->dsg,DS_MAT_A,&Ag);CHKERRQ(ierr);
+  ierr = DSGetArray(ctx->dsg,DS_MAT_B,&Bg);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(n,&nb);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ld,&ldb);CHKERRQ(ierr);
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&nb,&n2,&nb,&mone,K,&ldb,B,&ldd,&zero,W,&ldd));
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&nb,&n2,&nb,&sone,M,&ldb,B+n,&ldd,&zero,W+n,&ldd));
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&n2,&n2,&n2,&sone,B,&ldd,W,&ldd,&zero,Ag,&ldd));
+  for (j=0;j<n2;j++) {
+    for (i=j+1;i<n2;i++) Ag[i+j*ldd] = Ag[j+i*ldd] = 0.5*(Ag[i+j*ldd]+Ag[j+i*ldd]);
+  }
+  ierr = PetscMemzero(Bg,ldd*ldd*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (i=0;i<n2;i++) Bg[i+i*ldd] = (PetscRealPart(lam[i])>0.0)? 1.0: -1.0;
+  ierr = DSRestoreArray(ctx->dsg,DS_MAT_A,&Ag);CHKERRQ(ierr);
+  ierr = DSRestoreArray(ctx->dsg,DS_MAT_B,&Bg);CHKERRQ(ierr);
+  ierr = DSSetState(ctx->dsg,DS_STATE_RAW);CHKERRQ(ierr);
+  ierr = DSSolve(ctx->dsg,wr,wi);CHKERRQ(ierr);
+  ierr = DSVectors(ctx->dsg,DS_MAT_X,NULL,NULL);CHKERRQ(ierr);
+
+  /* eigenvectors of the linearization are G^{-T}*Xg = [x; lambda*x], and since the
+     coefficients are symmetric the left eigenvectors are conj(x), taken from the top
+     block (the bottom block vanishes when lambda=0) */
+  ierr = DSGetArray(ctx->dsg,DS_MAT_X,&Xg);CHKERRQ(ierr);
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n2,&n2,&n2,&sone,B,&ldd,Xg,&ldd,&zero,W,&ldd));
+  ierr = DSRestoreArray(ctx->dsg,DS_MAT_X,&Xg);CHKERRQ(ierr);
+  for (j=0;j<n2;j++) {
+    ierr = PetscMemcpy(X+j*ld,W+j*ldd,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemcpy(Y+j*ld,W+j*ldd,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    if (wi[j]!=0.0) {
+      j++;
+      for (i=0;i<n;i++) {
+        X[i+j*ld] = W[i+j*ldd];
+        Y[i+j*ld] = -W[i+j*ldd];
+      }
     }
   }
+  ierr = DSPEPNormalizeVectors_Private(ds,wi);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 #endif
 }
@@ -318,11 +610,32 @@ PetscErrorCode DSPEPGetDegree(DS ds,PetscInt *d)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode DSSynchronize_PEP(DS ds,PetscScalar *eigr,PetscScalar *eigi)
+{
+  PetscErrorCode ierr;
+  DS_PEP         *ctx = (DS_PEP*)ds->data;
+  PetscMPIInt    count;
+  MPI_Comm       comm=PetscObjectComm((PetscObject)ds);
+
+  PetscFunctionBegin;
+  /* there are d*n eigenvalues, only the first n are sent by DSSynchronize_Private() */
+  ierr = PetscMPIIntCast(ctx->d*ds->n,&count);CHKERRQ(ierr);
+  if (eigr) {
+    ierr = MPI_Bcast(eigr,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr);
+  }
+  if (eigi) {
+    ierr = MPI_Bcast(eigi,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DSDestroy_PEP(DS ds)
 {
   PetscErrorCode ierr;
+  DS_PEP         *ctx = (DS_PEP*)ds->data;
 
   PetscFunctionBegin;
+  ierr = DSDestroy(&ctx->dsg);CHKERRQ(ierr);
   ierr = PetscFree(ds->data);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSPEPSetDegree_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSPEPGetDegree_C",NULL);CHKERRQ(ierr);
@@ -342,7 +655,10 @@ PETSC_EXTERN PetscErrorCode DSCreate_PEP(DS ds)
   ds->ops->view          = DSView_PEP;
   ds->ops->vectors       = DSVectors_PEP;
   ds->ops->solve[0]      = DSSolve_PEP_QZ;
+  ds->ops->solve[1]      = DSSolve_PEP_Companion;
+  ds->ops->solve[2]      = DSSolve_PEP_GHIEP;
   ds->ops->sort          = DSSort_PEP;
+  ds->ops->synchronize   = DSSynchronize_PEP;
   ds->ops->destroy       = DSDestroy_PEP;
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSPEPSetDegree_C",DSPEPSetDegree_PEP);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ds,"DSPEPGetDegree_C",DSPEPGetDegree_PEP);CHKERRQ(ierr);
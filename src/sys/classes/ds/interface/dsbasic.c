@@ -26,10 +26,11 @@
 PetscFunctionList DSList = 0;
 PetscBool         DSRegisterAllCalled = PETSC_FALSE;
 PetscClassId      DS_CLASSID = 0;
-PetscLogEvent     DS_Solve = 0,DS_Vectors = 0,DS_Other = 0;
+PetscLogEvent     DS_Solve = 0,DS_Vectors = 0,DS_Other = 0,DS_AllocateWork = 0;
 static PetscBool  DSPackageInitialized = PETSC_FALSE;
 
-const char *DSStateTypes[] = {"RAW","INTERMEDIATE","CONDENSED","TRUNCATED","DSStateType","DS_STATE_",0};
+const char *DSStateTypes[] = {"RAW","INTERMEDIATE","CONDENSED","TRUNCATED","ARROW","DSStateType","DS_STATE_",0};
+const char *DSParallelTypes[] = {"REDUNDANT","SYNCHRONIZED","DISTRIBUTED","DSParallelType","DS_PARALLEL_",0};
 const char *DSMatName[DS_NUM_MAT] = {"A","B","C","T","D","Q","Z","X","Y","U","VT","W","E0","E1","E2","E3","E4","E5","E6","E7","E8","E9"};
 DSMatType  DSMatExtra[DS_NUM_EXTRA] = {DS_MAT_E0,DS_MAT_E1,DS_MAT_E2,DS_MAT_E3,DS_MAT_E4,DS_MAT_E5,DS_MAT_E6,DS_MAT_E7,DS_MAT_E8,DS_MAT_E9};
 
@@ -79,6 +80,8 @@ PetscErrorCode DSInitializePackage()
   ierr = PetscLogEventRegister("DSSolve",DS_CLASSID,&DS_Solve);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DSVectors",DS_CLASSID,&DS_Vectors);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DSOther",DS_CLASSID,&DS_Other);CHKERRQ(ierr);
+  /* counts the times the work arrays of a DS had to be enlarged, calls that reuse them are not logged */
+  ierr = PetscLogEventRegister("DSAllocateWork",DS_CLASSID,&DS_AllocateWork);CHKERRQ(ierr);
   /* Process info exclusions */
   ierr = PetscOptionsGetString(NULL,NULL,"-info_exclude",logList,256,&opt);CHKERRQ(ierr);
   if (opt) {
@@ -131,7 +134,9 @@ PetscErrorCode DSCreate(MPI_Comm comm,DS *newds)
   ierr = SlepcHeaderCreate(ds,DS_CLASSID,"DS","Direct Solver (or Dense System)","DS",comm,DSDestroy,DSView);CHKERRQ(ierr);
 
   ds->state         = DS_STATE_RAW;
+  ds->arrow         = PETSC_FALSE;
   ds->method        = 0;
+  ds->pmode         = DS_PARALLEL_REDUNDANT;
   ds->compact       = PETSC_FALSE;
   ds->refined       = PETSC_FALSE;
   ds->extrarow      = PETSC_FALSE;
@@ -157,6 +162,11 @@ PetscErrorCode DSCreate(MPI_Comm comm,DS *newds)
   ds->lwork         = 0;
   ds->lrwork        = 0;
   ds->liwork        = 0;
+  ds->packed        = PETSC_FALSE;
+  ds->bwork         = NULL;
+  ds->brwork        = NULL;
+  ds->lbwork        = 0;
+  ds->lbrwork       = 0;
 
   *newds = ds;
   PetscFunctionReturn(0);
@@ -357,6 +367,72 @@ PetscErrorCode DSGetMethod(DS ds,PetscInt *meth)
   PetscFunctionReturn(0);
 }
 
+/*@
+   DSSetParallel - Selects the mode of operation in parallel runs.
+
+   Logically Collective on DS
+
+   Input Parameter:
++  ds    - the direct solver context
+-  pmode - the parallel mode
+
+   Options Database Key:
+.  -ds_parallel <mode> - Sets the parallel mode, either 'redundant',
+   'synchronized' or 'distributed'
+
+   Notes:
+   In the 'redundant' parallel mode, all processes will make the computation
+   redundantly, starting from the same data, and producing the same result.
+   This result may be slightly different in the different processes if using a
+   multithreaded BLAS library, which may cause issues in ill-conditioned problems.
+
+   In the 'synchronized' parallel mode, only the first MPI process performs the
+   computation and then the computed quantities are broadcast to the other
+   processes in the communicator. This communication is done automatically at
+   the end of DSSolve(), DSSort() and DSVectors().
+
+   In the 'distributed' parallel mode, the dense computation is split among
+   the processes of the communicator, and the result is gathered in all of
+   them. This is only available in some solvers (currently the MRRR method
+   of DSHEP), the rest behave as in the 'synchronized' mode.
+
+   Level: advanced
+
+.seealso: DSGetParallel()
+@*/
+PetscErrorCode DSSetParallel(DS ds,DSParallelType pmode)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ds,DS_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ds,pmode,2);
+  ds->pmode = pmode;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DSGetParallel - Gets the mode of operation in parallel runs.
+
+   Not Collective
+
+   Input Parameter:
+.  ds - the direct solver context
+
+   Output Parameter:
+.  pmode - the parallel mode
+
+   Level: advanced
+
+.seealso: DSSetParallel()
+@*/
+PetscErrorCode DSGetParallel(DS ds,DSParallelType *pmode)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ds,DS_CLASSID,1);
+  PetscValidPointer(pmode,2);
+  *pmode = ds->pmode;
+  PetscFunctionReturn(0);
+}
+
 /*@
    DSSetCompact - Switch to compact storage of matrices.
 
@@ -645,6 +721,7 @@ PetscErrorCode DSSetFromOptions(DS ds)
   PetscErrorCode ierr;
   PetscInt       bs,meth;
   PetscBool      flag;
+  DSParallelType pmode;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ds,DS_CLASSID,1);
@@ -661,6 +738,9 @@ PetscErrorCode DSSetFromOptions(DS ds)
     ierr = PetscOptionsInt("-ds_method","Method to be used for the dense system","DSSetMethod",ds->method,&meth,&flag);CHKERRQ(ierr);
     if (flag) { ierr = DSSetMethod(ds,meth);CHKERRQ(ierr); }
 
+    ierr = PetscOptionsEnum("-ds_parallel","Operation mode in parallel runs","DSSetParallel",DSParallelTypes,(PetscEnum)ds->pmode,(PetscEnum*)&pmode,&flag);CHKERRQ(ierr);
+    if (flag) { ierr = DSSetParallel(ds,pmode);CHKERRQ(ierr); }
+
     ierr = PetscObjectProcessOptionsHandlers(PetscOptionsObject,(PetscObject)ds);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -705,6 +785,9 @@ PetscErrorCode DSView(DS ds,PetscViewer viewer)
   if (isascii) {
     ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
     ierr = PetscObjectPrintClassNamePrefixType((PetscObject)ds,viewer);CHKERRQ(ierr);
+    if (ds->pmode!=DS_PARALLEL_REDUNDANT) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  parallel operation mode: %s\n",DSParallelTypes[ds->pmode]);CHKERRQ(ierr);
+    }
     if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
       ierr = PetscViewerASCIIPrintf(viewer,"  current state: %s\n",DSStateTypes[ds->state]);CHKERRQ(ierr);
       ierr = PetscObjectTypeCompare((PetscObject)ds,DSSVD,&issvd);CHKERRQ(ierr);
@@ -787,6 +870,7 @@ PetscErrorCode DSReset(DS ds)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ds,DS_CLASSID,1);
   ds->state    = DS_STATE_RAW;
+  ds->arrow    = PETSC_FALSE;
   ds->ld       = 0;
   ds->l        = 0;
   ds->n        = 0;
@@ -826,6 +910,8 @@ PetscErrorCode DSDestroy(DS *ds)
   ierr = PetscFree((*ds)->work);CHKERRQ(ierr);
   ierr = PetscFree((*ds)->rwork);CHKERRQ(ierr);
   ierr = PetscFree((*ds)->iwork);CHKERRQ(ierr);
+  ierr = PetscFree((*ds)->bwork);CHKERRQ(ierr);
+  ierr = PetscFree((*ds)->brwork);CHKERRQ(ierr);
   ierr = PetscFree((*ds)->sc);CHKERRQ(ierr);
   ierr = PetscHeaderDestroy(ds);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -66,6 +66,13 @@ PetscErrorCode DSGetLeadingDimension(DS ds,PetscInt *ld)
    This function is normally used to return to the raw state when the
    condensed structure is destroyed.
 
+   DS_STATE_ARROW can be used after a restart of Krylov-Schur to indicate
+   that the matrix is raw but the block l:k-1 is upper (quasi-)triangular,
+   row k has nonzero entries in columns l:k-1 and the rest is upper
+   Hessenberg. The state is set to raw, and solvers that support the hint
+   (currently DSNHEP) reduce only the leading block instead of the whole
+   matrix. DSGetState() returns DS_STATE_ARROW until the system is solved.
+
    Level: advanced
 
 .seealso: DSGetState()
@@ -84,6 +91,11 @@ PetscErrorCode DSSetState(DS ds,DSStateType state)
     case DS_STATE_TRUNCATED:
       if (ds->state<state) { ierr = PetscInfo(ds,"DS state has been increased\n");CHKERRQ(ierr); }
       ds->state = state;
+      ds->arrow = PETSC_FALSE;
+      break;
+    case DS_STATE_ARROW:
+      ds->state = DS_STATE_RAW;
+      ds->arrow = PETSC_TRUE;
       break;
     default:
       SETERRQ(PetscObjectComm((PetscObject)ds),PETSC_ERR_ARG_WRONG,"Wrong state");
@@ -111,7 +123,7 @@ PetscErrorCode DSGetState(DS ds,DSStateType *state)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ds,DS_CLASSID,1);
   PetscValidPointer(state,2);
-  *state = ds->state;
+  *state = (ds->state==DS_STATE_RAW && ds->arrow)? DS_STATE_ARROW: ds->state;
   PetscFunctionReturn(0);
 }
 
@@ -246,6 +258,7 @@ PetscErrorCode DSTruncate(DS ds,PetscInt n)
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DS_Other,ds,0,0,0);CHKERRQ(ierr);
   ds->state = DS_STATE_TRUNCATED;
+  ds->arrow = PETSC_FALSE;
   ierr = PetscObjectStateIncrease((PetscObject)ds);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -499,7 +512,8 @@ PetscErrorCode DSRestoreArrayReal(DS ds,DSMatType m,PetscReal *a[])
 @*/
 PetscErrorCode DSSolve(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 {
-  PetscErrorCode ierr;
+  PetscErrorCode ierr,perr=0;
+  PetscMPIInt    size,rank;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ds,DS_CLASSID,1);
@@ -507,16 +521,179 @@ PetscErrorCode DSSolve(DS ds,PetscScalar eigr[],PetscScalar eigi[])
   PetscValidPointer(eigr,2);
   if (ds->state>=DS_STATE_CONDENSED) PetscFunctionReturn(0);
   if (!ds->ops->solve[ds->method]) SETERRQ(PetscObjectComm((PetscObject)ds),PETSC_ERR_ARG_OUTOFRANGE,"The specified method number does not exist for this DS");
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)ds),&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)ds),&rank);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(DS_Solve,ds,0,0,0);CHKERRQ(ierr);
   ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
-  ierr = (*ds->ops->solve[ds->method])(ds,eigr,eigi);CHKERRQ(ierr);
+  if (size==1 || ds->pmode==DS_PARALLEL_REDUNDANT) {
+    ierr = (*ds->ops->solve[ds->method])(ds,eigr,eigi);CHKERRQ(ierr);
+  } else if (ds->pmode==DS_PARALLEL_DISTRIBUTED && ds->ops->pdsolve[ds->method]) {
+    ierr = (*ds->ops->pdsolve[ds->method])(ds,eigr,eigi);CHKERRQ(ierr);
+  } else {
+    if (!rank) perr = (*ds->ops->solve[ds->method])(ds,eigr,eigi);
+    ierr = DSSynchronizeError_Private(ds,perr);CHKERRQ(ierr);
+    ierr = DSSynchronize_Private(ds,DS_NUM_MAT,eigr,eigi);CHKERRQ(ierr);
+  }
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DS_Solve,ds,0,0,0);CHKERRQ(ierr);
   ds->state = DS_STATE_CONDENSED;
+  ds->arrow = PETSC_FALSE;
   ierr = PetscObjectStateIncrease((PetscObject)ds);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+/*
+   Exchange the working arrays of two DS objects, so that a batch of problems
+   can reuse the workspace of one of them
+*/
+PETSC_STATIC_INLINE void DSSwapWork_Private(DS ds,DS ds2)
+{
+  PetscScalar  *work=ds->work;
+  PetscReal    *rwork=ds->rwork;
+  PetscBLASInt *iwork=ds->iwork;
+  PetscInt     lwork=ds->lwork,lrwork=ds->lrwork,liwork=ds->liwork;
+
+  ds->work   = ds2->work;   ds2->work   = work;
+  ds->rwork  = ds2->rwork;  ds2->rwork  = rwork;
+  ds->iwork  = ds2->iwork;  ds2->iwork  = iwork;
+  ds->lwork  = ds2->lwork;  ds2->lwork  = lwork;
+  ds->lrwork = ds2->lrwork; ds2->lrwork = lrwork;
+  ds->liwork = ds2->liwork; ds2->liwork = liwork;
+}
+
+/*@C
+   DSSolveBatch - Solves a batch of independent problems of the same type.
+
+   Logically Collective on DS
+
+   Input Parameters:
++  nds - number of problems
+-  ds  - array of nds direct solver contexts
+
+   Output Parameters:
++  eigr - array to store the computed eigenvalues (real part)
+-  eigi - array to store the computed eigenvalues (imaginary part)
+
+   Options Database Key:
+.  -ds_batch_threads <nt> - number of threads used to solve the problems
+   concurrently (read with the options prefix of ds[0])
+
+   Notes:
+   The result is the same as calling DSSolve() for each ds[i], but the overhead
+   per problem is much smaller, which is relevant when solving many small
+   problems. While being solved, the matrices of all problems are stored
+   contiguously in a buffer kept by ds[0], with the leading dimension reduced
+   to the size of each problem (except for DSPEP). The problems solved by
+   the same thread share the workspace of one of the first DS objects, which
+   is kept for subsequent calls. Several threads can be used if SLEPc was
+   built with OpenMP and PETSc was configured with thread safety.
+
+   The eigenvalues are returned packed contiguously: eigr (and eigi) start
+   with the n_0 values of ds[0], followed by the n_1 values of ds[1], and so on,
+   where n_i is the dimension of ds[i]. Argument eigi can be NULL only if
+   it can also be NULL in DSSolve() for this type of problem.
+
+   All DS objects must have the same type, must have been allocated with
+   DSAllocate() and must use the redundant parallel mode (or live in a
+   communicator with one process).
+
+   Level: advanced
+
+.seealso: DSSolve(), DSSetParallel()
+@*/
+PetscErrorCode DSSolveBatch(PetscInt nds,DS ds[],PetscScalar eigr[],PetscScalar eigi[])
+{
+  PetscErrorCode   ierr,perr,*errs;
+  PetscInt         i,t,nt=1,ns,nr,*off,*poff,*proff;
+  PetscMPIInt      size;
+  PetscBool        same,pack;
+  DSPacked_Private sv;
+
+  PetscFunctionBegin;
+  if (nds<0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of problems must be non-negative");
+  if (!nds) PetscFunctionReturn(0);
+  PetscValidPointer(ds,2);
+  PetscValidPointer(eigr,3);
+  ierr = PetscObjectTypeCompare((PetscObject)ds[0],DSPEP,&pack);CHKERRQ(ierr);
+  pack = pack? PETSC_FALSE: PETSC_TRUE;
+  ierr = PetscMalloc4(nds+1,&off,nds,&errs,nds+1,&poff,nds+1,&proff);CHKERRQ(ierr);
+  off[0] = 0; poff[0] = 0; proff[0] = 0;
+  for (i=0;i<nds;i++) {
+    PetscValidHeaderSpecific(ds[i],DS_CLASSID,2);
+    DSCheckAlloc(ds[i],2);
+    ierr = PetscObjectTypeCompare((PetscObject)ds[i],((PetscObject)ds[0])->type_name,&same);CHKERRQ(ierr);
+    if (!same) SETERRQ(PetscObjectComm((PetscObject)ds[i]),PETSC_ERR_ARG_INCOMP,"All DS objects in the batch must have the same type");
+    if (!ds[i]->ops->solve[ds[i]->method]) SETERRQ(PetscObjectComm((PetscObject)ds[i]),PETSC_ERR_ARG_OUTOFRANGE,"The specified method number does not exist for this DS");
+    ierr = MPI_Comm_size(PetscObjectComm((PetscObject)ds[i]),&size);CHKERRQ(ierr);
+    if (size>1 && ds[i]->pmode!=DS_PARALLEL_REDUNDANT) SETERRQ(PetscObjectComm((PetscObject)ds[i]),PETSC_ERR_SUP,"DSSolveBatch requires the redundant parallel mode");
+    ns = 0; nr = 0;
+    if (pack && ds[i]->state<DS_STATE_CONDENSED) {
+      ierr = DSPackedSize_Private(ds[i],&ns,&nr);CHKERRQ(ierr);
+    }
+    off[i+1]   = off[i]+ds[i]->n;
+    poff[i+1]  = poff[i]+ns;
+    proff[i+1] = proff[i]+nr;
+    errs[i]    = 0;
+  }
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  ierr = PetscOptionsGetInt(NULL,((PetscObject)ds[0])->prefix,"-ds_batch_threads",&nt,NULL);CHKERRQ(ierr);
+  nt = PetscMax(1,PetscMin(nt,nds));
+#endif
+
+  /* the packed storage only grows, so it is reused in subsequent calls */
+  if (poff[nds]>ds[0]->lbwork || proff[nds]>ds[0]->lbrwork) {
+    ierr = PetscLogEventBegin(DS_AllocateWork,ds[0],0,0,0);CHKERRQ(ierr);
+    if (poff[nds]>ds[0]->lbwork) {
+      ierr = PetscFree(ds[0]->bwork);CHKERRQ(ierr);
+      ierr = PetscMalloc1(poff[nds],&ds[0]->bwork);CHKERRQ(ierr);
+      ierr = PetscLogObjectMemory((PetscObject)ds[0],(poff[nds]-ds[0]->lbwork)*sizeof(PetscScalar));CHKERRQ(ierr);
+      ds[0]->lbwork = poff[nds];
+    }
+    if (proff[nds]>ds[0]->lbrwork) {
+      ierr = PetscFree(ds[0]->brwork);CHKERRQ(ierr);
+      ierr = PetscMalloc1(proff[nds],&ds[0]->brwork);CHKERRQ(ierr);
+      ierr = PetscLogObjectMemory((PetscObject)ds[0],(proff[nds]-ds[0]->lbrwork)*sizeof(PetscReal));CHKERRQ(ierr);
+      ds[0]->lbrwork = proff[nds];
+    }
+    ierr = PetscLogEventEnd(DS_AllocateWork,ds[0],0,0,0);CHKERRQ(ierr);
+  }
+
+  ierr = PetscLogEventBegin(DS_Solve,ds[0],0,0,0);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  /* problem i is solved by thread t=i%nt, using the workspace of ds[t] */
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#pragma omp parallel for num_threads(nt) schedule(static,1) private(i,sv,perr)
+#endif
+  for (t=0;t<nt;t++) {
+    for (i=t;i<nds;i+=nt) {
+      if (ds[i]->state>=DS_STATE_CONDENSED) continue;
+      if (i!=t) DSSwapWork_Private(ds[i],ds[t]);
+      if (pack) errs[i] = DSPack_Private(ds[i],ds[0]->bwork+poff[i],ds[0]->brwork+proff[i],&sv);
+      if (!errs[i]) {
+        errs[i] = (*ds[i]->ops->solve[ds[i]->method])(ds[i],eigr+off[i],eigi?eigi+off[i]:NULL);
+        if (pack) {
+          perr = DSUnpack_Private(ds[i],&sv);
+          if (!errs[i]) errs[i] = perr;
+        }
+      }
+      if (i!=t) DSSwapWork_Private(ds[i],ds[t]);
+      if (!errs[i]) {
+        ds[i]->state = DS_STATE_CONDENSED;
+        ds[i]->arrow = PETSC_FALSE;
+      }
+    }
+  }
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DS_Solve,ds[0],0,0,0);CHKERRQ(ierr);
+
+  for (i=0;i<nds;i++) {
+    ierr = errs[i];CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject)ds[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(off,errs,poff,proff);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DSSort - Sorts the result of DSSolve() according to a given sorting
    criterion.
@@ -552,8 +729,10 @@ PetscErrorCode DSSolve(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 @*/
 PetscErrorCode DSSort(DS ds,PetscScalar *eigr,PetscScalar *eigi,PetscScalar *rr,PetscScalar *ri,PetscInt *k)
 {
-  PetscErrorCode ierr;
+  PetscErrorCode ierr,perr=0;
   PetscInt       i;
+  PetscMPIInt    size,rank,count;
+  MPI_Comm       comm;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ds,DS_CLASSID,1);
@@ -566,9 +745,22 @@ PetscErrorCode DSSort(DS ds,PetscScalar *eigr,PetscScalar *eigi,PetscScalar *rr,
   if (k && !rr) SETERRQ(PetscObjectComm((PetscObject)ds),PETSC_ERR_ARG_WRONG,"Argument k can only be used together with rr");
 
   for (i=0;i<ds->n;i++) ds->perm[i] = i;   /* initialize to trivial permutation */
+  comm = PetscObjectComm((PetscObject)ds);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(DS_Other,ds,0,0,0);CHKERRQ(ierr);
   ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
-  ierr = (*ds->ops->sort)(ds,eigr,eigi,rr,ri,k);CHKERRQ(ierr);
+  if (size==1 || ds->pmode==DS_PARALLEL_REDUNDANT) {
+    ierr = (*ds->ops->sort)(ds,eigr,eigi,rr,ri,k);CHKERRQ(ierr);
+  } else {
+    if (!rank) perr = (*ds->ops->sort)(ds,eigr,eigi,rr,ri,k);
+    ierr = DSSynchronizeError_Private(ds,perr);CHKERRQ(ierr);
+    ierr = DSSynchronize_Private(ds,DS_NUM_MAT,eigr,eigi);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(ds->n,&count);CHKERRQ(ierr);
+    if (rr) { ierr = MPI_Bcast(rr,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr); }
+    if (ri) { ierr = MPI_Bcast(ri,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr); }
+    if (k) { ierr = MPI_Bcast(k,1,MPIU_INT,0,comm);CHKERRQ(ierr); }
+  }
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DS_Other,ds,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)ds);CHKERRQ(ierr);
@@ -614,7 +806,9 @@ PetscErrorCode DSSort(DS ds,PetscScalar *eigr,PetscScalar *eigi,PetscScalar *rr,
 @*/
 PetscErrorCode DSVectors(DS ds,DSMatType mat,PetscInt *j,PetscReal *rnorm)
 {
-  PetscErrorCode ierr;
+  PetscErrorCode ierr,perr=0;
+  PetscMPIInt    size,rank;
+  MPI_Comm       comm;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ds,DS_CLASSID,1);
@@ -624,9 +818,20 @@ PetscErrorCode DSVectors(DS ds,DSMatType mat,PetscInt *j,PetscReal *rnorm)
   if (!ds->ops->vectors) SETERRQ1(PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"DS type %s",((PetscObject)ds)->type_name);
   if (rnorm && !j) SETERRQ(PetscObjectComm((PetscObject)ds),PETSC_ERR_ORDER,"Must give a value of j");
   if (!ds->mat[mat]) { ierr = DSAllocateMat_Private(ds,mat);CHKERRQ(ierr); }
+  comm = PetscObjectComm((PetscObject)ds);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(DS_Vectors,ds,0,0,0);CHKERRQ(ierr);
   ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
-  ierr = (*ds->ops->vectors)(ds,mat,j,rnorm);CHKERRQ(ierr);
+  if (size==1 || ds->pmode==DS_PARALLEL_REDUNDANT) {
+    ierr = (*ds->ops->vectors)(ds,mat,j,rnorm);CHKERRQ(ierr);
+  } else {
+    if (!rank) perr = (*ds->ops->vectors)(ds,mat,j,rnorm);
+    ierr = DSSynchronizeError_Private(ds,perr);CHKERRQ(ierr);
+    ierr = DSSynchronize_Private(ds,mat,NULL,NULL);CHKERRQ(ierr);
+    if (j) { ierr = MPI_Bcast(j,1,MPIU_INT,0,comm);CHKERRQ(ierr); }
+    if (rnorm) { ierr = MPI_Bcast(rnorm,1,MPIU_REAL,0,comm);CHKERRQ(ierr); }
+  }
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DS_Vectors,ds,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)ds);CHKERRQ(ierr);
@@ -738,6 +943,7 @@ PetscErrorCode DSTranslateHarmonic(DS ds,PetscScalar tau,PetscReal beta,PetscBoo
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DS_Other,ds,0,0,0);CHKERRQ(ierr);
   ds->state = DS_STATE_RAW;
+  ds->arrow = PETSC_FALSE;
   ierr = PetscObjectStateIncrease((PetscObject)ds);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -780,6 +986,7 @@ PetscErrorCode DSTranslateRKS(DS ds,PetscScalar alpha)
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DS_Other,ds,0,0,0);CHKERRQ(ierr);
   ds->state   = DS_STATE_RAW;
+  ds->arrow   = PETSC_FALSE;
   ds->compact = PETSC_FALSE;
   ierr = PetscObjectStateIncrease((PetscObject)ds);CHKERRQ(ierr);
   PetscFunctionReturn(0);
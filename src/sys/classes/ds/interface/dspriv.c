@@ -24,10 +24,12 @@
 #include <slepc/private/dsimpl.h>      /*I "slepcds.h" I*/
 #include <slepcblaslapack.h>
 
-PetscErrorCode DSAllocateMatrix_Private(DS ds,DSMatType m,PetscBool isreal)
+/*
+   Number of elements allocated for matrix m, see the description of DSMatType
+*/
+static PetscErrorCode DSMatrixSize_Private(DS ds,DSMatType m,PetscInt *nelem)
 {
-  size_t         sz;
-  PetscInt       n,d,nelem;
+  PetscInt       n,d;
   PetscBool      ispep;
   PetscErrorCode ierr;
 
@@ -40,19 +42,39 @@ PetscErrorCode DSAllocateMatrix_Private(DS ds,DSMatType m,PetscBool isreal)
   else n = ds->ld;
   switch (m) {
     case DS_MAT_T:
-      nelem = 3*ds->ld;
+      *nelem = 3*ds->ld;
       break;
     case DS_MAT_D:
-      nelem = ds->ld;
+      *nelem = ds->ld;
       break;
     case DS_MAT_X:
-      nelem = ds->ld*n;
+      *nelem = ds->ld*n;
       break;
     case DS_MAT_Y:
-      nelem = ds->ld*n;
+      *nelem = ds->ld*n;
       break;
     default:
-      nelem = n*n;
+      *nelem = n*n;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DSAllocateMatrix_Private(DS ds,DSMatType m,PetscBool isreal)
+{
+  size_t         sz;
+  PetscInt       nelem;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DSMatrixSize_Private(ds,m,&nelem);CHKERRQ(ierr);
+  if (ds->packed && (isreal? ds->rmat[m]: ds->mat[m])) {
+    /* packed storage cannot be freed, and has the right size */
+    if (isreal) {
+      ierr = PetscMemzero(ds->rmat[m],nelem*sizeof(PetscReal));CHKERRQ(ierr);
+    } else {
+      ierr = PetscMemzero(ds->mat[m],nelem*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
   }
   if (isreal) {
     sz = nelem*sizeof(PetscReal);
@@ -74,11 +96,245 @@ PetscErrorCode DSAllocateMatrix_Private(DS ds,DSMatType m,PetscBool isreal)
   PetscFunctionReturn(0);
 }
 
+/*
+   Leading dimension used in packed storage, the smallest one that holds
+   the current problem (including an extra row, if present)
+*/
+PETSC_STATIC_INLINE PetscInt DSPackedLD_Private(DS ds)
+{
+  return PetscMin(ds->ld,PetscMax(ds->n,ds->m)+1);
+}
+
+/*
+   DSPackedSize_Private - Number of scalar and real elements taken by the
+   allocated matrices of ds in packed storage, see DSPack_Private()
+*/
+PetscErrorCode DSPackedSize_Private(DS ds,PetscInt *ns,PetscInt *nr)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,ld=ds->ld,nelem;
+
+  PetscFunctionBegin;
+  *ns = 0; *nr = 0;
+  ds->ld = DSPackedLD_Private(ds);
+  for (i=0;i<DS_NUM_MAT;i++) {
+    if (!ds->mat[i] && !ds->rmat[i]) continue;
+    ierr = DSMatrixSize_Private(ds,(DSMatType)i,&nelem);CHKERRQ(ierr);
+    if (ds->mat[i]) *ns += nelem;
+    if (ds->rmat[i]) *nr += nelem;
+  }
+  ds->ld = ld;
+  PetscFunctionReturn(0);
+}
+
+/*
+   DSPack_Private - Moves the matrices of ds to the storage given by buf and
+   rbuf (of the size returned by DSPackedSize_Private), with the leading
+   dimension reduced to the current size of the problem, so that a batch of
+   small problems occupies a contiguous block of memory. The original location
+   is kept in sv. Not available in DSPEP, whose matrices are stored by blocks.
+*/
+PetscErrorCode DSPack_Private(DS ds,PetscScalar *buf,PetscReal *rbuf,DSPacked_Private *sv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,nelem,pld=DSPackedLD_Private(ds);
+
+  PetscFunctionBegin;
+  sv->ld = ds->ld;
+  for (i=0;i<DS_NUM_MAT;i++) {
+    sv->mat[i]  = ds->mat[i];
+    sv->rmat[i] = ds->rmat[i];
+  }
+  ds->ld = pld;
+  for (i=0;i<DS_NUM_MAT;i++) {
+    if (!ds->mat[i] && !ds->rmat[i]) continue;
+    ierr = DSMatrixSize_Private(ds,(DSMatType)i,&nelem);CHKERRQ(ierr);
+    if (ds->mat[i]) {
+      for (j=0;j<nelem/pld;j++) {
+        ierr = PetscMemcpy(buf+j*pld,sv->mat[i]+j*sv->ld,pld*sizeof(PetscScalar));CHKERRQ(ierr);
+      }
+      ds->mat[i] = buf;
+      buf += nelem;
+    }
+    if (ds->rmat[i]) {
+      for (j=0;j<nelem/pld;j++) {
+        ierr = PetscMemcpy(rbuf+j*pld,sv->rmat[i]+j*sv->ld,pld*sizeof(PetscReal));CHKERRQ(ierr);
+      }
+      ds->rmat[i] = rbuf;
+      rbuf += nelem;
+    }
+  }
+  ds->packed = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   DSUnpack_Private - Copies back the matrices of ds from packed storage to
+   their original location. Matrices created while packed (with the reduced
+   leading dimension) are moved to new storage with the original one.
+*/
+PetscErrorCode DSUnpack_Private(DS ds,DSPacked_Private *sv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,nelem,pld=ds->ld;
+  PetscScalar    *pmat;
+  PetscReal      *prmat;
+
+  PetscFunctionBegin;
+  ds->packed = PETSC_FALSE;
+  for (i=0;i<DS_NUM_MAT;i++) {
+    if (!ds->mat[i] && !ds->rmat[i]) continue;
+    ierr = DSMatrixSize_Private(ds,(DSMatType)i,&nelem);CHKERRQ(ierr);
+    pmat  = ds->mat[i];
+    prmat = ds->rmat[i];
+    ds->ld = sv->ld;
+    if (pmat && !sv->mat[i]) {
+      ds->mat[i] = NULL;
+      ierr = DSAllocateMat_Private(ds,(DSMatType)i);CHKERRQ(ierr);
+      sv->mat[i] = ds->mat[i];
+    }
+    if (prmat && !sv->rmat[i]) {
+      ds->rmat[i] = NULL;
+      ierr = DSAllocateMatReal_Private(ds,(DSMatType)i);CHKERRQ(ierr);
+      sv->rmat[i] = ds->rmat[i];
+    }
+    ds->ld = pld;
+    for (j=0;j<nelem/pld;j++) {
+      if (pmat) { ierr = PetscMemcpy(sv->mat[i]+j*sv->ld,pmat+j*pld,pld*sizeof(PetscScalar));CHKERRQ(ierr); }
+      if (prmat) { ierr = PetscMemcpy(sv->rmat[i]+j*sv->ld,prmat+j*pld,pld*sizeof(PetscReal));CHKERRQ(ierr); }
+    }
+    /* free the matrices that were not in the packed storage */
+    if (pmat && pmat!=ds->mat[i]) { ierr = PetscFree(pmat);CHKERRQ(ierr); }
+    if (prmat && prmat!=ds->rmat[i]) { ierr = PetscFree(prmat);CHKERRQ(ierr); }
+  }
+  for (i=0;i<DS_NUM_MAT;i++) {
+    ds->mat[i]  = sv->mat[i];
+    ds->rmat[i] = sv->rmat[i];
+  }
+  ds->ld = sv->ld;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Number of leading elements of matrix m that contain the active part, that
+   is, the first columns up to the current dimension (with stride ld)
+*/
+static PetscErrorCode DSMatrixActiveSize_Private(DS ds,DSMatType m,PetscInt *nelem)
+{
+  PetscInt       ld=ds->ld,nc,d=1;
+  PetscBool      ispep;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DSMatrixSize_Private(ds,m,nelem);CHKERRQ(ierr);
+  if (m==DS_MAT_T || m==DS_MAT_D) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)ds,DSPEP,&ispep);CHKERRQ(ierr);
+  nc = PetscMax(ds->n,ds->m);
+  if (ispep && (m==DS_MAT_A || m==DS_MAT_B || m==DS_MAT_W || m==DS_MAT_U || m==DS_MAT_X || m==DS_MAT_Y)) {
+    ierr = DSPEPGetDegree(ds,&d);CHKERRQ(ierr);
+    if (m!=DS_MAT_X && m!=DS_MAT_Y) ld *= d;
+    nc *= d;
+  }
+  *nelem = PetscMin(*nelem,ld*nc);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Make all processes return with an error if an operation done only in the
+   first process (DS_PARALLEL_SYNCHRONIZED) failed, instead of leaving the
+   rest blocked in the next collective call. perr is the error code obtained
+   in the first process.
+*/
+PetscErrorCode DSSynchronizeError_Private(DS ds,PetscErrorCode perr)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,err=(PetscMPIInt)perr;
+  MPI_Comm       comm=PetscObjectComm((PetscObject)ds);
+
+  PetscFunctionBegin;
+  ierr = MPI_Bcast(&err,1,MPI_INT,0,comm);CHKERRQ(ierr);
+  if (err) {
+    ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+    if (!rank) { CHKERRQ(perr); }
+    SETERRQ(PETSC_COMM_SELF,err,"The operation failed in the first process");
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Broadcast from the first process the data that may have been modified by
+   an operation done only in that process (DS_PARALLEL_SYNCHRONIZED), that is,
+   matrix mat (or all allocated matrices if mat is DS_NUM_MAT), the permutation
+   and the n eigenvalues (if eigr and eigi are not NULL). Only the leading
+   columns up to the current dimension are sent.
+*/
+PetscErrorCode DSSynchronize_Private(DS ds,DSMatType mat,PetscScalar *eigr,PetscScalar *eigi)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,i0,i1,nelem,dims[3];
+  PetscMPIInt    count,rank,alloc[2*DS_NUM_MAT];
+  MPI_Comm       comm=PetscObjectComm((PetscObject)ds);
+
+  PetscFunctionBegin;
+  /* the solvers may modify the dimensions, e.g. the length of the decomposition */
+  dims[0] = ds->l; dims[1] = ds->k; dims[2] = ds->t;
+  ierr = MPI_Bcast(dims,3,MPIU_INT,0,comm);CHKERRQ(ierr);
+  ds->l = dims[0]; ds->k = dims[1]; ds->t = dims[2];
+  /* matrices may have been allocated in the first process only */
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  for (i=0;i<DS_NUM_MAT;i++) {
+    alloc[i] = ds->mat[i]? 1: 0;
+    alloc[DS_NUM_MAT+i] = ds->rmat[i]? 1: 0;
+  }
+  ierr = MPI_Bcast(alloc,2*DS_NUM_MAT,MPI_INT,0,comm);CHKERRQ(ierr);
+  if (rank) {
+    for (i=0;i<DS_NUM_MAT;i++) {
+      if (alloc[i] && !ds->mat[i]) { ierr = DSAllocateMat_Private(ds,(DSMatType)i);CHKERRQ(ierr); }
+      if (alloc[DS_NUM_MAT+i] && !ds->rmat[i]) { ierr = DSAllocateMatReal_Private(ds,(DSMatType)i);CHKERRQ(ierr); }
+    }
+  }
+  if (mat==DS_NUM_MAT) { i0 = 0; i1 = DS_NUM_MAT; }
+  else { i0 = mat; i1 = mat+1; }
+  for (i=i0;i<i1;i++) {
+    if (!ds->mat[i] && !ds->rmat[i]) continue;
+    ierr = DSMatrixActiveSize_Private(ds,(DSMatType)i,&nelem);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(nelem,&count);CHKERRQ(ierr);
+    if (ds->mat[i]) {
+      ierr = MPI_Bcast(ds->mat[i],count,MPIU_SCALAR,0,comm);CHKERRQ(ierr);
+    }
+    if (ds->rmat[i]) {
+      ierr = MPI_Bcast(ds->rmat[i],count,MPIU_REAL,0,comm);CHKERRQ(ierr);
+    }
+  }
+  if (ds->perm) {
+    ierr = PetscMPIIntCast(ds->n,&count);CHKERRQ(ierr);
+    ierr = MPI_Bcast(ds->perm,count,MPIU_INT,0,comm);CHKERRQ(ierr);
+  }
+  ierr = PetscMPIIntCast(ds->n,&count);CHKERRQ(ierr);
+  if (eigr) {
+    ierr = MPI_Bcast(eigr,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr);
+  }
+  if (eigi) {
+    ierr = MPI_Bcast(eigi,count,MPIU_SCALAR,0,comm);CHKERRQ(ierr);
+  }
+  /* solver-specific data */
+  if (ds->ops->synchronize) {
+    ierr = (*ds->ops->synchronize)(ds,eigr,eigi);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Grow-only allocation of the work arrays; the DSAllocateWork event is logged
+   only when some array has to be reallocated
+*/
 PetscErrorCode DSAllocateWork_Private(DS ds,PetscInt s,PetscInt r,PetscInt i)
 {
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (s<=ds->lwork && r<=ds->lrwork && i<=ds->liwork) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(DS_AllocateWork,ds,0,0,0);CHKERRQ(ierr);
   if (s>ds->lwork) {
     ierr = PetscFree(ds->work);CHKERRQ(ierr);
     ierr = PetscMalloc1(s,&ds->work);CHKERRQ(ierr);
@@ -97,6 +353,7 @@ PetscErrorCode DSAllocateWork_Private(DS ds,PetscInt s,PetscInt r,PetscInt i)
     ierr = PetscLogObjectMemory((PetscObject)ds,(i-ds->liwork)*sizeof(PetscBLASInt));CHKERRQ(ierr);
     ds->liwork = i;
   }
+  ierr = PetscLogEventEnd(DS_AllocateWork,ds,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -186,80 +443,84 @@ PetscErrorCode DSViewMat(DS ds,PetscViewer viewer,DSMatType m)
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode DSSortEigenvalues_Private(DS ds,PetscScalar *wr,PetscScalar *wi,PetscInt *perm,PetscBool isghiep)
+/*
+  Sorts the eigenvalues in positions l:t-1 of perm (the rest are left untouched),
+  keeping together complex conjugate pairs; if nw>0, only the first nw items
+  are guaranteed to be in order (see SlepcSCSort_Private)
+*/
+static PetscErrorCode DSSortEigenvalues_Items(DS ds,PetscScalar *wr,PetscScalar *wi,PetscInt *perm,PetscBool isghiep,PetscInt nw)
 {
   PetscErrorCode ierr;
-  PetscScalar    re,im,wi0;
-  PetscInt       n,i,j,result,tmp1,tmp2=0,d=1;
+  PetscScalar    *kr,*ki;
+  PetscInt       n,i,j,m,s,len,*first,*idx,*orig;
 
   PetscFunctionBegin;
   n = ds->t;   /* sort only first t pairs if truncated */
-  /* insertion sort */
-  i=ds->l+1;
+  if (n-ds->l<2) PetscFunctionReturn(0);
+  ierr = PetscMalloc5(n,&kr,n,&ki,n,&first,n,&idx,n,&orig);CHKERRQ(ierr);
+  m = 0;
+  for (i=ds->l;i<n;i++) {
+    kr[m] = wr[perm[i]];
+    ki[m] = wi? wi[perm[i]]: 0.0;
+    first[m++] = i;
 #if !defined(PETSC_USE_COMPLEX)
-  if (wi && wi[perm[i-1]]!=0.0) i++; /* initial value is complex */
+    if (wi && wi[perm[i]]!=0.0) i++;  /* complex conjugate pair */
 #else
-  if (isghiep && PetscImaginaryPart(wr[perm[i-1]])!=0.0) i++;
+    if (isghiep && PetscImaginaryPart(wr[perm[i]])!=0.0) i++;
 #endif
-  for (;i<n;i+=d) {
-    re = wr[perm[i]];
-    if (wi) im = wi[perm[i]];
-    else im = 0.0;
-    tmp1 = perm[i];
-#if !defined(PETSC_USE_COMPLEX)
-    if (im!=0.0) { d = 2; tmp2 = perm[i+1]; }
-    else d = 1;
-#else
-    if (isghiep && PetscImaginaryPart(re)!=0.0) { d = 2; tmp2 = perm[i+1]; }
-    else d = 1;
-#endif
-    j = i-1;
-    if (wi) wi0 = wi[perm[j]];
-    else wi0 = 0.0;
-    ierr = SlepcSCCompare(ds->sc,re,im,wr[perm[j]],wi0,&result);CHKERRQ(ierr);
-    while (result<0 && j>=ds->l) {
-      perm[j+d] = perm[j];
-      j--;
-#if !defined(PETSC_USE_COMPLEX)
-      if (wi && wi[perm[j+1]]!=0)
-#else
-      if (isghiep && PetscImaginaryPart(wr[perm[j+1]])!=0)
-#endif
-        { perm[j+d] = perm[j]; j--; }
-
-      if (j>=ds->l) {
-        if (wi) wi0 = wi[perm[j]];
-        else wi0 = 0.0;
-        ierr = SlepcSCCompare(ds->sc,re,im,wr[perm[j]],wi0,&result);CHKERRQ(ierr);
-      }
-    }
-    perm[j+1] = tmp1;
-    if (d==2) perm[j+2] = tmp2;
   }
+  ierr = SlepcSCSort_Private(ds->sc,m,kr,ki,PETSC_FALSE,nw,idx);CHKERRQ(ierr);
+  ierr = PetscMemcpy(orig,perm,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (s=0,j=ds->l;s<m;s++) {
+    len = PetscMin((idx[s]<m-1)? first[idx[s]+1]: n,n)-first[idx[s]];
+    for (i=0;i<len;i++) perm[j++] = orig[first[idx[s]]+i];
+  }
+  ierr = PetscFree5(kr,ki,first,idx,orig);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DSSortEigenvalues_Private(DS ds,PetscScalar *wr,PetscScalar *wi,PetscInt *perm,PetscBool isghiep)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DSSortEigenvalues_Items(ds,wr,wi,perm,isghiep,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Same as DSSortEigenvalues_Private, but only the first k eigenvalues from
+  position l are guaranteed to be sorted, for callers that only need the
+  wanted ones
+*/
+PetscErrorCode DSSortEigenvaluesPartial_Private(DS ds,PetscScalar *wr,PetscScalar *wi,PetscInt *perm,PetscBool isghiep,PetscInt k)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DSSortEigenvalues_Items(ds,wr,wi,perm,isghiep,PetscMax(k,1));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 PetscErrorCode DSSortEigenvaluesReal_Private(DS ds,PetscReal *eig,PetscInt *perm)
 {
   PetscErrorCode ierr;
-  PetscScalar    re;
-  PetscInt       i,j,result,tmp,l,n;
+  PetscScalar    *kr,*ki;
+  PetscInt       i,n,l,*idx,*orig;
 
   PetscFunctionBegin;
   n = ds->t;   /* sort only first t pairs if truncated */
   l = ds->l;
-  /* insertion sort */
-  for (i=l+1;i<n;i++) {
-    re = eig[perm[i]];
-    j = i-1;
-    ierr = SlepcSCCompare(ds->sc,re,0.0,eig[perm[j]],0.0,&result);CHKERRQ(ierr);
-    while (result<0 && j>=l) {
-      tmp = perm[j]; perm[j] = perm[j+1]; perm[j+1] = tmp; j--;
-      if (j>=l) {
-        ierr = SlepcSCCompare(ds->sc,re,0.0,eig[perm[j]],0.0,&result);CHKERRQ(ierr);
-      }
-    }
+  if (n-l<2) PetscFunctionReturn(0);
+  ierr = PetscMalloc4(n-l,&kr,n-l,&ki,n-l,&idx,n-l,&orig);CHKERRQ(ierr);
+  for (i=0;i<n-l;i++) {
+    kr[i] = eig[perm[l+i]];
+    ki[i] = 0.0;
   }
+  ierr = SlepcSCSort_Private(ds->sc,n-l,kr,ki,PETSC_FALSE,0,idx);CHKERRQ(ierr);
+  ierr = PetscMemcpy(orig,perm+l,(n-l)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0;i<n-l;i++) perm[l+i] = orig[idx[i]];
+  ierr = PetscFree4(kr,ki,idx,orig);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -23,15 +23,98 @@ static char help[] = "Test Phi functions.\n\n";
 
 #include <slepcfn.h>
 
+/*
+   Compute B = phi_k(A) and check that its first column coincides with
+   the result of FNEvaluateFunctionMatVec(), computed by a different method
+ */
+PetscErrorCode TestPhiMat(FN fn,Mat A)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,n;
+  PetscReal      nrm,nrmv;
+  Mat            B;
+  Vec            v,f0;
+
+  PetscFunctionBeginUser;
+  ierr = FNPhiGetIndex(fn,&k);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&n,NULL);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&B);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMat(fn,A,B);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&v,&f0);CHKERRQ(ierr);
+  ierr = MatGetColumnVector(B,f0,0);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMatVec(fn,A,v);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&nrmv);CHKERRQ(ierr);
+  ierr = VecAXPY(v,-1.0,f0);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&nrm);CHKERRQ(ierr);
+  nrm /= nrmv;
+  if (nrm<100*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  phi_%D(A): ||f(A)*e_1-v||/||v|| < 100*eps\n",k);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  phi_%D(A): ||f(A)*e_1-v||/||v|| = %g\n",k,(double)nrm);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = VecDestroy(&f0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Compute phi_0(A),...,phi_k(A) with a single call, both the full matrices
+   and the first columns, and check that the first column of each matrix
+   coincides with the corresponding vector, which is computed by a different
+   method (exponential of an augmented matrix)
+ */
+PetscErrorCode TestPhiAll(FN fn,Mat A)
+{
+  PetscErrorCode ierr;
+  PetscInt       j,k,n;
+  PetscReal      nrm,nrmv,err=0.0;
+  Mat            *B;
+  Vec            *v,f0;
+
+  PetscFunctionBeginUser;
+  ierr = FNPhiGetIndex(fn,&k);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(k+1,&B,k+1,&v);CHKERRQ(ierr);
+  for (j=0;j<=k;j++) {
+    ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&B[j]);CHKERRQ(ierr);
+    ierr = MatCreateVecs(A,&v[j],NULL);CHKERRQ(ierr);
+  }
+  ierr = MatCreateVecs(A,&f0,NULL);CHKERRQ(ierr);
+  ierr = FNPhiEvaluateFunctionMatAll(fn,A,B);CHKERRQ(ierr);
+  ierr = FNPhiEvaluateFunctionMatVecAll(fn,A,v);CHKERRQ(ierr);
+  for (j=0;j<=k;j++) {
+    ierr = MatGetColumnVector(B[j],f0,0);CHKERRQ(ierr);
+    ierr = VecNorm(v[j],NORM_2,&nrmv);CHKERRQ(ierr);
+    ierr = VecAXPY(f0,-1.0,v[j]);CHKERRQ(ierr);
+    ierr = VecNorm(f0,NORM_2,&nrm);CHKERRQ(ierr);
+    err = PetscMax(err,nrm/nrmv);
+  }
+  if (err<100*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  phi_0(A),...,phi_%D(A) computed together: ||f(A)*e_1-v||/||v|| < 100*eps\n",k);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  phi_0(A),...,phi_%D(A) computed together: ||f(A)*e_1-v||/||v|| = %g\n",k,(double)err);CHKERRQ(ierr);
+  }
+  for (j=0;j<=k;j++) {
+    ierr = MatDestroy(&B[j]);CHKERRQ(ierr);
+    ierr = VecDestroy(&v[j]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(B,v);CHKERRQ(ierr);
+  ierr = VecDestroy(&f0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 int main(int argc,char **argv)
 {
   PetscErrorCode ierr;
   FN             phi0,phi1,phik,phicopy;
-  PetscInt       k;
-  PetscScalar    x,y,yp,tau,eta;
+  Mat            A;
+  PetscInt       i,k,n=10;
+  PetscScalar    x,y,yp,tau,eta,*As;
   char           strx[50],str[50];
 
   ierr = SlepcInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
 
   /* phi_0(x) = exp(x) */
   ierr = FNCreate(PETSC_COMM_WORLD,&phi0);CHKERRQ(ierr);
@@ -81,6 +164,19 @@ int main(int argc,char **argv)
   ierr = SlepcSNPrintfScalar(str,50,yp,PETSC_FALSE);CHKERRQ(ierr);
   ierr = PetscPrintf(PETSC_COMM_WORLD,"  f'(%s)=%s\n",strx,str);CHKERRQ(ierr);
 
+  /* Matrix functions of a non-symmetric tridiagonal matrix */
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Matrix functions, n=%D\n",n);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&A);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(A,&As);CHKERRQ(ierr);
+  for (i=0;i<n;i++) As[i+i*n] = -2.0;
+  for (i=0;i<n-1;i++) { As[i+(i+1)*n] = 1.0; As[(i+1)+i*n] = 0.5; }
+  ierr = MatDenseRestoreArray(A,&As);CHKERRQ(ierr);
+  ierr = TestPhiMat(phi0,A);CHKERRQ(ierr);
+  ierr = TestPhiMat(phi1,A);CHKERRQ(ierr);
+  ierr = TestPhiMat(phicopy,A);CHKERRQ(ierr);
+  ierr = TestPhiAll(phicopy,A);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+
   ierr = FNDestroy(&phi0);CHKERRQ(ierr);
   ierr = FNDestroy(&phi1);CHKERRQ(ierr);
   ierr = FNDestroy(&phik);CHKERRQ(ierr);
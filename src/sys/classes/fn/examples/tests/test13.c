@@ -0,0 +1,142 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test evaluation of functions on arrays of values.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of values.\n\n";
+
+#include <slepcfn.h>
+
+/*
+   Compares FNEvaluateFunctionArray and FNEvaluateDerivativeArray, also
+   in-place, with the evaluation of each value separately
+*/
+PetscErrorCode TestArray(FN fn,const char *name,PetscInt n,PetscScalar *x)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscScalar    *y,*yp,*z,f,fp;
+  PetscReal      err=0.0;
+
+  PetscFunctionBeginUser;
+  ierr = PetscMalloc3(n,&y,n,&yp,n,&z);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionArray(fn,n,x,y);CHKERRQ(ierr);
+  ierr = FNEvaluateDerivativeArray(fn,n,x,yp);CHKERRQ(ierr);
+  for (i=0;i<n;i++) {
+    ierr = FNEvaluateFunction(fn,x[i],&f);CHKERRQ(ierr);
+    ierr = FNEvaluateDerivative(fn,x[i],&fp);CHKERRQ(ierr);
+    err = PetscMax(err,PetscAbsScalar(y[i]-f)/PetscMax(PetscAbsScalar(f),1.0));
+    err = PetscMax(err,PetscAbsScalar(yp[i]-fp)/PetscMax(PetscAbsScalar(fp),1.0));
+  }
+  ierr = PetscMemcpy(z,x,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionArray(fn,n,z,z);CHKERRQ(ierr);
+  for (i=0;i<n;i++) err = PetscMax(err,PetscAbsScalar(z[i]-y[i])/PetscMax(PetscAbsScalar(y[i]),1.0));
+  if (err<100*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  %s: array and scalar evaluations agree\n",name);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  %s: array and scalar evaluations differ by %g\n",name,(double)err);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(y,yp,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  FN             fn,f1,f2,f3,g;
+  PetscInt       i,n=40;
+  PetscScalar    *x,p[3],q[3];
+
+  ierr = SlepcInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  if (n<2) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_USER_INPUT,"The number of values must be at least 2");
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Evaluation of functions on arrays, n=%D.\n",n);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&x);CHKERRQ(ierr);
+  for (i=0;i<n;i++) x[i] = 0.1+1.9*i/(n-1);
+
+  /* exponential with scaling factors */
+  ierr = FNCreate(PETSC_COMM_WORLD,&fn);CHKERRQ(ierr);
+  ierr = FNSetType(fn,FNEXP);CHKERRQ(ierr);
+  ierr = FNSetScale(fn,-0.2,1.3);CHKERRQ(ierr);
+  ierr = TestArray(fn,"exp",n,x);CHKERRQ(ierr);
+
+  /* rational function (x^2-2x+3)/(x+0.5) */
+  ierr = FNSetType(fn,FNRATIONAL);CHKERRQ(ierr);
+  ierr = FNSetScale(fn,1.0,1.0);CHKERRQ(ierr);
+  p[0] = 1.0; p[1] = -2.0; p[2] = 3.0;
+  q[0] = 1.0; q[1] = 0.5;
+  ierr = FNRationalSetNumerator(fn,3,p);CHKERRQ(ierr);
+  ierr = FNRationalSetDenominator(fn,2,q);CHKERRQ(ierr);
+  ierr = TestArray(fn,"rational",n,x);CHKERRQ(ierr);
+  ierr = FNDestroy(&fn);CHKERRQ(ierr);
+
+  /* phi_3 function */
+  ierr = FNCreate(PETSC_COMM_WORLD,&fn);CHKERRQ(ierr);
+  ierr = FNSetType(fn,FNPHI);CHKERRQ(ierr);
+  ierr = FNPhiSetIndex(fn,3);CHKERRQ(ierr);
+  ierr = TestArray(fn,"phi",n,x);CHKERRQ(ierr);
+  ierr = FNDestroy(&fn);CHKERRQ(ierr);
+
+  /* square root, inverse square root and logarithm */
+  ierr = FNCreate(PETSC_COMM_WORLD,&fn);CHKERRQ(ierr);
+  ierr = FNSetType(fn,FNSQRT);CHKERRQ(ierr);
+  ierr = TestArray(fn,"sqrt",n,x);CHKERRQ(ierr);
+  ierr = FNSetType(fn,FNINVSQRT);CHKERRQ(ierr);
+  ierr = TestArray(fn,"invsqrt",n,x);CHKERRQ(ierr);
+  ierr = FNSetType(fn,FNLOG);CHKERRQ(ierr);
+  ierr = FNSetScale(fn,0.9,0.5);CHKERRQ(ierr);
+  ierr = TestArray(fn,"log",n,x);CHKERRQ(ierr);
+  ierr = FNDestroy(&fn);CHKERRQ(ierr);
+
+  /* combined function (1-x^2)*exp(-x/(1+x^2)), with nested FNCOMBINE */
+  ierr = FNCreate(PETSC_COMM_WORLD,&f1);CHKERRQ(ierr);
+  ierr = FNSetType(f1,FNRATIONAL);CHKERRQ(ierr);
+  p[0] = -1.0; p[1] = 0.0;
+  q[0] = 1.0; q[1] = 0.0; q[2] = 1.0;
+  ierr = FNRationalSetNumerator(f1,2,p);CHKERRQ(ierr);
+  ierr = FNRationalSetDenominator(f1,3,q);CHKERRQ(ierr);
+  ierr = FNCreate(PETSC_COMM_WORLD,&f2);CHKERRQ(ierr);
+  ierr = FNSetType(f2,FNEXP);CHKERRQ(ierr);
+  ierr = FNCreate(PETSC_COMM_WORLD,&g);CHKERRQ(ierr);
+  ierr = FNSetType(g,FNCOMBINE);CHKERRQ(ierr);
+  ierr = FNCombineSetChildren(g,FN_COMBINE_COMPOSE,f1,f2);CHKERRQ(ierr);
+  ierr = FNCreate(PETSC_COMM_WORLD,&f3);CHKERRQ(ierr);
+  ierr = FNSetType(f3,FNRATIONAL);CHKERRQ(ierr);
+  p[0] = -1.0; p[1] = 0.0; p[2] = 1.0;
+  ierr = FNRationalSetNumerator(f3,3,p);CHKERRQ(ierr);
+  ierr = FNCreate(PETSC_COMM_WORLD,&fn);CHKERRQ(ierr);
+  ierr = FNSetType(fn,FNCOMBINE);CHKERRQ(ierr);
+  ierr = FNCombineSetChildren(fn,FN_COMBINE_MULTIPLY,f3,g);CHKERRQ(ierr);
+  ierr = TestArray(fn,"combine",n,x);CHKERRQ(ierr);
+  ierr = FNCombineSetChildren(fn,FN_COMBINE_DIVIDE,g,f2);CHKERRQ(ierr);
+  ierr = TestArray(fn,"combine",n,x);CHKERRQ(ierr);
+  ierr = FNCombineSetChildren(fn,FN_COMBINE_ADD,f1,g);CHKERRQ(ierr);
+  ierr = TestArray(fn,"combine",n,x);CHKERRQ(ierr);
+
+  ierr = FNDestroy(&f1);CHKERRQ(ierr);
+  ierr = FNDestroy(&f2);CHKERRQ(ierr);
+  ierr = FNDestroy(&f3);CHKERRQ(ierr);
+  ierr = FNDestroy(&g);CHKERRQ(ierr);
+  ierr = FNDestroy(&fn);CHKERRQ(ierr);
+  ierr = PetscFree(x);CHKERRQ(ierr);
+  ierr = SlepcFinalize();
+  return ierr;
+}
@@ -0,0 +1,149 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test the Schur cache of matrix functions.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n\n";
+
+#include <slepcfn.h>
+
+/*
+   Checks that ||X-Y||_F/||X||_F is small
+*/
+PetscErrorCode CheckMat(Mat X,Mat Y,const char *msg)
+{
+  PetscErrorCode ierr;
+  PetscInt       n;
+  PetscReal      nrm,nrmx;
+  Mat            D;
+
+  PetscFunctionBeginUser;
+  ierr = MatGetSize(X,&n,NULL);CHKERRQ(ierr);
+  ierr = MatDuplicate(Y,MAT_COPY_VALUES,&D);CHKERRQ(ierr);
+  ierr = MatAXPY(D,-1.0,X,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(D,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+  ierr = MatNorm(X,NORM_FROBENIUS,&nrmx);CHKERRQ(ierr);
+  if (nrm/nrmx<100*n*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: agrees with the computation without cache\n",msg);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: relative difference %g\n",msg,(double)(nrm/nrmx));CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  FN             f,fsqrt,flog,fns[2];
+  Mat            A,F0,F,G0,G,H0,H,M[2];
+  Vec            v,w;
+  PetscInt       i,j,n=10;
+  PetscScalar    *As;
+  PetscReal      nrm,nrmw;
+
+  ierr = SlepcInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Schur cache for sqrt(0.5*A)*log(A), n=%D.\n",n);CHKERRQ(ierr);
+
+  /* Create function f(x)=sqrt(0.5*x)*log(x) */
+  ierr = FNCreate(PETSC_COMM_WORLD,&fsqrt);CHKERRQ(ierr);
+  ierr = FNSetType(fsqrt,FNSQRT);CHKERRQ(ierr);
+  ierr = FNSetScale(fsqrt,0.5,1.0);CHKERRQ(ierr);
+  ierr = FNCreate(PETSC_COMM_WORLD,&flog);CHKERRQ(ierr);
+  ierr = FNSetType(flog,FNLOG);CHKERRQ(ierr);
+  ierr = FNCreate(PETSC_COMM_WORLD,&f);CHKERRQ(ierr);
+  ierr = FNSetType(f,FNCOMBINE);CHKERRQ(ierr);
+  ierr = FNCombineSetChildren(f,FN_COMBINE_MULTIPLY,fsqrt,flog);CHKERRQ(ierr);
+
+  /* Create a non-symmetric matrix A */
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&A);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)A,"A");CHKERRQ(ierr);
+  ierr = MatDenseGetArray(A,&As);CHKERRQ(ierr);
+  for (i=0;i<n;i++) As[i+i*n]=3.0;
+  for (j=1;j<3;j++) {
+    for (i=0;i<n-j;i++) As[i+(i+j)*n]=1.0;
+  }
+  for (i=0;i<n-1;i++) As[(i+1)+i*n]=0.5;
+  ierr = MatDenseRestoreArray(A,&As);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&F0);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&F);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&G0);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&G);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&H0);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&H);CHKERRQ(ierr);
+
+  /* Reference result, without cache */
+  ierr = FNEvaluateFunctionMat(f,A,F0);CHKERRQ(ierr);
+
+  /* Children share the cache of the combined function, also in a repeated call */
+  ierr = FNSetSchurCache(f,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMat(f,A,F);CHKERRQ(ierr);
+  ierr = CheckMat(F0,F,"Combined function");CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMat(f,A,F);CHKERRQ(ierr);
+  ierr = CheckMat(F0,F,"Repeated evaluation");CHKERRQ(ierr);
+  /* The decomposition was computed once, for sqrt, and reused by log and in the repeated call */
+  ierr = FNView(f,NULL);CHKERRQ(ierr);
+
+  /* First column only */
+  ierr = MatCreateVecs(A,&v,&w);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMatVec(f,A,v);CHKERRQ(ierr);
+  ierr = MatGetColumnVector(F0,w,0);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_2,&nrmw);CHKERRQ(ierr);
+  ierr = VecAXPY(w,-1.0,v);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_2,&nrm);CHKERRQ(ierr);
+  if (nrm/nrmw<100*n*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"First column: agrees with the computation without cache\n");CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"First column: relative difference %g\n",(double)(nrm/nrmw));CHKERRQ(ierr);
+  }
+
+  /* The cached decomposition must not be used after modifying A */
+  ierr = MatShift(A,1.0);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMat(f,A,F);CHKERRQ(ierr);
+  ierr = FNSetSchurCache(f,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMat(f,A,F0);CHKERRQ(ierr);
+  ierr = CheckMat(F0,F,"Modified matrix");CHKERRQ(ierr);
+
+  /* Several functions of the same matrix */
+  ierr = FNEvaluateFunctionMat(fsqrt,A,G0);CHKERRQ(ierr);
+  ierr = FNEvaluateFunctionMat(flog,A,H0);CHKERRQ(ierr);
+  fns[0] = fsqrt; fns[1] = flog;
+  M[0] = G; M[1] = H;
+  ierr = FNEvaluateFunctionMatMultiple(2,fns,A,M);CHKERRQ(ierr);
+  ierr = CheckMat(G0,G,"Multiple evaluation, sqrt");CHKERRQ(ierr);
+  ierr = CheckMat(H0,H,"Multiple evaluation, log");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&F0);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = MatDestroy(&G0);CHKERRQ(ierr);
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  ierr = MatDestroy(&H0);CHKERRQ(ierr);
+  ierr = MatDestroy(&H);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = FNDestroy(&f);CHKERRQ(ierr);
+  ierr = FNDestroy(&fsqrt);CHKERRQ(ierr);
+  ierr = FNDestroy(&flog);CHKERRQ(ierr);
+  ierr = SlepcFinalize();
+  return ierr;
+}
@@ -102,6 +102,109 @@ PetscErrorCode FNEvaluateDerivative_Combine(FN fn,PetscScalar x,PetscScalar *yp)
   PetscFunctionReturn(0);
 }
 
+/*
+   Each child is evaluated once on the whole array, instead of descending the
+   expression tree for every point
+*/
+PetscErrorCode FNEvaluateFunctionArray_Combine(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscErrorCode ierr;
+  FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
+  PetscInt       i;
+  PetscScalar    *a,*b;
+
+  PetscFunctionBegin;
+  ierr = FNAllocateWork_Private(fn,2*n,0,0);CHKERRQ(ierr);
+  a = fn->work;
+  b = a+n;
+  ierr = FNEvaluateFunctionArray(ctx->f1,n,x,a);CHKERRQ(ierr);
+  switch (ctx->comb) {
+    case FN_COMBINE_ADD:
+      ierr = FNEvaluateFunctionArray(ctx->f2,n,x,b);CHKERRQ(ierr);
+      for (i=0;i<n;i++) y[i] = a[i]+b[i];
+      break;
+    case FN_COMBINE_MULTIPLY:
+      ierr = FNEvaluateFunctionArray(ctx->f2,n,x,b);CHKERRQ(ierr);
+      for (i=0;i<n;i++) y[i] = a[i]*b[i];
+      break;
+    case FN_COMBINE_DIVIDE:
+      ierr = FNEvaluateFunctionArray(ctx->f2,n,x,b);CHKERRQ(ierr);
+      for (i=0;i<n;i++) if (b[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Function not defined in the requested value");
+      for (i=0;i<n;i++) y[i] = a[i]/b[i];
+      break;
+    case FN_COMBINE_COMPOSE:
+      ierr = FNEvaluateFunctionArray(ctx->f2,n,a,y);CHKERRQ(ierr);
+      break;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateDerivativeArray_Combine(FN fn,PetscInt n,PetscScalar *x,PetscScalar *yp)
+{
+  PetscErrorCode ierr;
+  FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
+  PetscInt       i;
+  PetscScalar    *a,*b,*ap,*bp;
+
+  PetscFunctionBegin;
+  ierr = FNAllocateWork_Private(fn,4*n,0,0);CHKERRQ(ierr);
+  a  = fn->work;
+  b  = a+n;
+  ap = b+n;
+  bp = ap+n;
+  switch (ctx->comb) {
+    case FN_COMBINE_ADD:
+      ierr = FNEvaluateDerivativeArray(ctx->f1,n,x,ap);CHKERRQ(ierr);
+      ierr = FNEvaluateDerivativeArray(ctx->f2,n,x,bp);CHKERRQ(ierr);
+      for (i=0;i<n;i++) yp[i] = ap[i]+bp[i];
+      break;
+    case FN_COMBINE_MULTIPLY:
+      ierr = FNEvaluateDerivativeArray(ctx->f1,n,x,ap);CHKERRQ(ierr);
+      ierr = FNEvaluateDerivativeArray(ctx->f2,n,x,bp);CHKERRQ(ierr);
+      ierr = FNEvaluateFunctionArray(ctx->f1,n,x,a);CHKERRQ(ierr);
+      ierr = FNEvaluateFunctionArray(ctx->f2,n,x,b);CHKERRQ(ierr);
+      for (i=0;i<n;i++) yp[i] = ap[i]*b[i]+a[i]*bp[i];
+      break;
+    case FN_COMBINE_DIVIDE:
+      ierr = FNEvaluateDerivativeArray(ctx->f1,n,x,ap);CHKERRQ(ierr);
+      ierr = FNEvaluateDerivativeArray(ctx->f2,n,x,bp);CHKERRQ(ierr);
+      ierr = FNEvaluateFunctionArray(ctx->f1,n,x,a);CHKERRQ(ierr);
+      ierr = FNEvaluateFunctionArray(ctx->f2,n,x,b);CHKERRQ(ierr);
+      for (i=0;i<n;i++) if (b[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+      for (i=0;i<n;i++) yp[i] = (ap[i]*b[i]-a[i]*bp[i])/(b[i]*b[i]);
+      break;
+    case FN_COMBINE_COMPOSE:
+      ierr = FNEvaluateFunctionArray(ctx->f1,n,x,a);CHKERRQ(ierr);
+      ierr = FNEvaluateDerivativeArray(ctx->f1,n,x,ap);CHKERRQ(ierr);
+      ierr = FNEvaluateDerivativeArray(ctx->f2,n,a,yp);CHKERRQ(ierr);
+      for (i=0;i<n;i++) yp[i] *= ap[i];
+      break;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Lends the Schur cache of fn to the children that do not have their own,
+   the previous values are saved in old and put back with FNCombineRestoreSchur()
+*/
+static void FNCombineShareSchur(FN fn,FN_SCHUR **old)
+{
+  FN_COMBINE *ctx = (FN_COMBINE*)fn->data;
+
+  old[0] = ctx->f1->schur;
+  old[1] = ctx->f2->schur;
+  if (!old[0]) ctx->f1->schur = fn->schur;
+  if (!old[1]) ctx->f2->schur = fn->schur;
+}
+
+static void FNCombineRestoreSchur(FN fn,FN_SCHUR **old)
+{
+  FN_COMBINE *ctx = (FN_COMBINE*)fn->data;
+
+  ctx->f1->schur = old[0];
+  ctx->f2->schur = old[1];
+}
+
 PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
 {
 #if defined(PETSC_MISSING_LAPACK_GESV)
@@ -110,14 +213,15 @@ PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
 #else
   PetscErrorCode ierr;
   FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
-  PetscScalar    *Aa,*Ba,*Wa,*Za,one=1.0,zero=0.0;
+  FN_SCHUR       *old[2];
+  PetscScalar    *Ba,*Wa,*Za,one=1.0,zero=0.0;
   PetscBLASInt   n,ld,ld2,inc=1,*ipiv,info;
   PetscInt       m;
   Mat            W,Z;
 
   PetscFunctionBegin;
+  FNCombineShareSchur(fn,old);
   ierr = FN_AllocateWorkMat(fn,A,&W);CHKERRQ(ierr);
-  ierr = MatDenseGetArray(A,&Aa);CHKERRQ(ierr);
   ierr = MatDenseGetArray(B,&Ba);CHKERRQ(ierr);
   ierr = MatDenseGetArray(W,&Wa);CHKERRQ(ierr);
   ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
@@ -143,10 +247,10 @@ PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
     case FN_COMBINE_DIVIDE:
       ierr = FNEvaluateFunctionMat(ctx->f2,A,W);CHKERRQ(ierr);
       ierr = FNEvaluateFunctionMat(ctx->f1,A,B);CHKERRQ(ierr);
-      ierr = PetscMalloc1(ld,&ipiv);CHKERRQ(ierr);
+      ierr = FNAllocateWork_Private(fn,0,0,ld);CHKERRQ(ierr);
+      ipiv = fn->iwork;
       PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&n,&n,Wa,&ld,ipiv,Ba,&ld,&info));
       if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESV %d",info);
-      ierr = PetscFree(ipiv);CHKERRQ(ierr);
       break;
     case FN_COMBINE_COMPOSE:
       ierr = FNEvaluateFunctionMat(ctx->f1,A,W);CHKERRQ(ierr);
@@ -154,10 +258,10 @@ PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
       break;
   }
 
-  ierr = MatDenseRestoreArray(A,&Aa);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(B,&Ba);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(W,&Wa);CHKERRQ(ierr);
   ierr = FN_FreeWorkMat(fn,&W);CHKERRQ(ierr);
+  FNCombineRestoreSchur(fn,old);
   PetscFunctionReturn(0);
 #endif
 }
@@ -170,6 +274,7 @@ PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
 #else
   PetscErrorCode ierr;
   FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
+  FN_SCHUR       *old[2];
   PetscScalar    *va,*Za;
   PetscBLASInt   n,ld,*ipiv,info,one=1;
   PetscInt       m;
@@ -177,6 +282,7 @@ PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
   Vec            w;
 
   PetscFunctionBegin;
+  FNCombineShareSchur(fn,old);
   ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
   ld = n;
@@ -203,14 +309,14 @@ PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
       ierr = FN_AllocateWorkMat(fn,A,&Z);CHKERRQ(ierr);
       ierr = FNEvaluateFunctionMat(ctx->f2,A,Z);CHKERRQ(ierr);
       ierr = FNEvaluateFunctionMatVec(ctx->f1,A,v);CHKERRQ(ierr);
-      ierr = PetscMalloc1(ld,&ipiv);CHKERRQ(ierr);
+      ierr = FNAllocateWork_Private(fn,0,0,ld);CHKERRQ(ierr);
+      ipiv = fn->iwork;
       ierr = MatDenseGetArray(Z,&Za);CHKERRQ(ierr);
       ierr = VecGetArray(v,&va);CHKERRQ(ierr);
       PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&n,&one,Za,&ld,ipiv,va,&ld,&info));
       if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESV %d",info);
       ierr = VecRestoreArray(v,&va);CHKERRQ(ierr);
       ierr = MatDenseRestoreArray(Z,&Za);CHKERRQ(ierr);
-      ierr = PetscFree(ipiv);CHKERRQ(ierr);
       ierr = FN_FreeWorkMat(fn,&Z);CHKERRQ(ierr);
       ierr = VecDestroy(&w);CHKERRQ(ierr);
       break;
@@ -221,6 +327,7 @@ PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
       ierr = FN_FreeWorkMat(fn,&Z);CHKERRQ(ierr);
       break;
   }
+  FNCombineRestoreSchur(fn,old);
   PetscFunctionReturn(0);
 #endif
 }
@@ -392,8 +499,10 @@ PETSC_EXTERN PetscErrorCode FNCreate_Combine(FN fn)
 
   fn->ops->evaluatefunction       = FNEvaluateFunction_Combine;
   fn->ops->evaluatederivative     = FNEvaluateDerivative_Combine;
-  fn->ops->evaluatefunctionmat    = FNEvaluateFunctionMat_Combine;
-  fn->ops->evaluatefunctionmatvec = FNEvaluateFunctionMatVec_Combine;
+  fn->ops->evaluatefunctionarray  = FNEvaluateFunctionArray_Combine;
+  fn->ops->evaluatederivativearray = FNEvaluateDerivativeArray_Combine;
+  fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Combine;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Combine;
   fn->ops->view                   = FNView_Combine;
   fn->ops->duplicate              = FNDuplicate_Combine;
   fn->ops->destroy                = FNDestroy_Combine;
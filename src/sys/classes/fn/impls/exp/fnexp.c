@@ -24,6 +24,10 @@
 #include <slepc/private/fnimpl.h>      /*I "slepcfn.h" I*/
 #include <slepcblaslapack.h>
 
+typedef struct {
+  Vec w[2];      /* work vectors of FNEvaluateFunctionMatVec, kept between calls */
+} FN_EXP;
+
 PetscErrorCode FNEvaluateFunction_Exp(FN fn,PetscScalar x,PetscScalar *y)
 {
   PetscFunctionBegin;
@@ -38,10 +42,23 @@ PetscErrorCode FNEvaluateDerivative_Exp(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode FNEvaluateFunctionArray_Exp(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) y[i] = PetscExpScalar(x[i]);
+  PetscFunctionReturn(0);
+}
+
 #define MAX_PADE 6
 #define SWAP(a,b,t) {t=a;a=b;b=t;}
 
-PetscErrorCode FNEvaluateFunctionMat_Exp(FN fn,Mat A,Mat B)
+/*
+   Scaling and squaring with a fixed-degree [6/6] Pade approximant, the
+   scaling parameter is chosen from the infinity-norm of A
+*/
+static PetscErrorCode FNEvaluateFunctionMat_Exp_Pade(FN fn,Mat A,Mat B)
 {
 #if defined(PETSC_MISSING_LAPACK_GESV) || defined(SLEPC_MISSING_LAPACK_LANGE)
   PetscFunctionBegin;
@@ -64,7 +81,13 @@ PetscErrorCode FNEvaluateFunctionMat_Exp(FN fn,Mat A,Mat B)
   ld  = n;
   ld2 = ld*ld;
   P   = Ba;
-  ierr = PetscMalloc6(m*m,&Q,m*m,&W,m*m,&As,m*m,&A2,ld,&rwork,ld,&ipiv);CHKERRQ(ierr);
+  ierr = FNAllocateWork_Private(fn,4*m*m,m,m);CHKERRQ(ierr);
+  Q     = fn->work;
+  W     = Q+m*m;
+  As    = W+m*m;
+  A2    = As+m*m;
+  rwork = fn->rwork;
+  ipiv  = fn->iwork;
   ierr = PetscMemcpy(As,Aa,ld2*sizeof(PetscScalar));CHKERRQ(ierr);
 
   /* Pade' coefficients */
@@ -127,18 +150,422 @@ PetscErrorCode FNEvaluateFunctionMat_Exp(FN fn,Mat A,Mat B)
   }
   if (P!=Ba) { ierr = PetscMemcpy(Ba,P,ld2*sizeof(PetscScalar));CHKERRQ(ierr); }
 
-  ierr = PetscFree6(Q,W,As,A2,rwork,ipiv);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(A,&Aa);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(B,&Ba);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 #endif
 }
 
+
+/*
+   Computes w = op(M)^p*x with p successive matrix-vector products, where op()
+   is either the identity or the conjugate transpose. Workspace: y (n scalars)
+*/
+static PetscErrorCode expm_applypower(PetscBLASInt n,PetscScalar *M,PetscBLASInt ld,PetscInt p,const char *trans,PetscScalar *x,PetscScalar *w,PetscScalar *y)
+{
+  PetscInt     k;
+  PetscBLASInt inc=1;
+  PetscScalar  *src=x,*dst,one=1.0,zero=0.0;
+
+  PetscFunctionBegin;
+  for (k=0;k<p;k++) {
+    dst = ((p-k)%2)? w: y;
+    PetscStackCallBLAS("BLASgemv",BLASgemv_(trans,&n,&n,&one,M,&ld,src,&inc,&zero,dst,&inc));
+    src = dst;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Estimates the 1-norm of M^p with the method of Hager and Higham (the one
+   used in LAPACK's xLACON), without forming M^p explicitly.
+   Workspace: work (4*n scalars)
+*/
+static PetscErrorCode expm_normest1(PetscBLASInt n,PetscScalar *M,PetscBLASInt ld,PetscInt p,PetscScalar *work,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,it;
+  PetscScalar    *x=work,*w=work+n,*z=work+2*n,*y=work+3*n,ztx;
+  PetscReal      est=0.0,estold=0.0,zmax;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) x[i] = 1.0/n;
+  for (it=0;it<5;it++) {
+    ierr = expm_applypower(n,M,ld,p,"N",x,w,y);CHKERRQ(ierr);
+    est = 0.0;
+    for (i=0;i<n;i++) est += PetscAbsScalar(w[i]);
+    if (it && est<=estold) { est = estold; break; }
+    for (i=0;i<n;i++) w[i] = (w[i]==(PetscScalar)0.0)? 1.0: w[i]/PetscAbsScalar(w[i]);
+    ierr = expm_applypower(n,M,ld,p,"C",w,z,y);CHKERRQ(ierr);
+    j = 0; zmax = 0.0;
+    for (i=0;i<n;i++) {
+      if (PetscAbsScalar(z[i])>zmax) { zmax = PetscAbsScalar(z[i]); j = i; }
+    }
+    if (it) {
+      ztx = 0.0;
+      for (i=0;i<n;i++) ztx += PetscConj(z[i])*x[i];
+      if (zmax<=PetscRealPart(ztx)) break;
+    }
+    for (i=0;i<n;i++) x[i] = 0.0;
+    x[j] = 1.0;
+    estold = est;
+  }
+  *nrm = est;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Number of additional squarings required so that the rounding errors in the
+   evaluation of the [m/m] Pade approximant of 2^(-s)*A do not dominate, see
+   Al-Mohy and Higham (2009). The 1-norm of |A|^(2m+1) is computed exactly
+   with matrix-vector products, since |A|^(2m+1) is nonnegative.
+   Workspace: rwork (2*n reals)
+*/
+static PetscInt expm_ell(PetscBLASInt n,PetscScalar *A,PetscBLASInt ld,PetscInt m,PetscReal scal,PetscReal *rwork)
+{
+  PetscInt  i,j,k;
+  PetscReal *x=rwork,*y=rwork+n,*t,sum,nrma=0.0,nrmabs=0.0,alpha,c;
+
+  switch (m) {
+    case 3:  c = 100800.0; break;
+    case 5:  c = 10059033600.0; break;
+    case 7:  c = 4487938430976000.0; break;
+    case 9:  c = 5914384781877411840000.0; break;
+    default: c = 113250775606021113483283660800000000.0; break;
+  }
+  for (j=0;j<n;j++) {
+    sum = 0.0;
+    for (i=0;i<n;i++) sum += PetscAbsScalar(A[i+j*ld]);
+    nrma = PetscMax(nrma,scal*sum);
+  }
+  if (nrma==0.0) return 0;
+  /* x' = e'*|A|^(2m+1) */
+  for (j=0;j<n;j++) x[j] = 1.0;
+  for (k=0;k<2*m+1;k++) {
+    for (j=0;j<n;j++) {
+      sum = 0.0;
+      for (i=0;i<n;i++) sum += x[i]*scal*PetscAbsScalar(A[i+j*ld]);
+      y[j] = sum;
+    }
+    t = x; x = y; y = t;
+  }
+  for (j=0;j<n;j++) nrmabs = PetscMax(nrmabs,x[j]);
+  if (nrmabs==0.0) return 0;
+  alpha = nrmabs/(nrma*c);
+  return PetscMax(0,(PetscInt)PetscCeilReal(PetscLogReal(alpha/(PETSC_MACHINE_EPSILON/2.0))/PetscLogReal(2.0)/(2*m)));
+}
+
+/*
+   Scaling and squaring with a variable-degree Pade approximant, m=3,5,7,9,13,
+   the degree and the scaling parameter are selected from estimates of
+   ||A^k||^(1/k), following
+
+   [1] N. J. Higham, "The scaling and squaring method for the matrix
+       exponential revisited", SIAM J. Matrix Anal. Appl. 26(4):1179-1193, 2005.
+   [2] A. H. Al-Mohy and N. J. Higham, "A new scaling and squaring algorithm
+       for the matrix exponential", SIAM J. Matrix Anal. Appl. 31(3):970-989, 2009.
+*/
+static PetscErrorCode FNEvaluateFunctionMat_Exp_Higham(FN fn,Mat A,Mat B)
+{
+#if defined(PETSC_MISSING_LAPACK_GESV) || defined(SLEPC_MISSING_LAPACK_LANGE)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GESV/LANGE - Lapack routines are unavailable");
+#else
+  PetscErrorCode    ierr;
+  PetscBLASInt      n,ld,ld2,*ipiv,info,inc=1;
+  PetscInt          m,i,j,k,s=0,deg;
+  PetscReal         d4,d6,d8,d10,eta1,eta3,eta4,nrm,*rwork;
+  PetscScalar       *Aa,*Ba,*As,*A2,*A4,*A6,*U,*V,*W,*P,*aux,*work,scal,one=1.0,zero=0.0;
+  const PetscReal   theta[] = { 1.495585217958292e-2,   /* m=3  */
+                                2.539398330063230e-1,   /* m=5  */
+                                9.504178996162932e-1,   /* m=7  */
+                                2.097847961257068e0,    /* m=9  */
+                                4.25 };                 /* m=13 */
+  const PetscScalar c3[]  = { 120.0, 60.0, 12.0, 1.0 },
+                    c5[]  = { 30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0 },
+                    c7[]  = { 17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0 },
+                    c9[]  = { 17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+                              2162160.0, 110880.0, 3960.0, 90.0, 1.0 },
+                    c13[] = { 64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+                              1187353796428800.0, 129060195264000.0, 10559470521600.0,
+                              670442572800.0, 33522128640.0, 1323241920.0, 40840800.0,
+                              960960.0, 16380.0, 182.0, 1.0 };
+  const PetscScalar *c;
+
+  PetscFunctionBegin;
+  ierr = MatDenseGetArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(B,&Ba);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ld  = n;
+  ld2 = ld*ld;
+  ierr = FNAllocateWork_Private(fn,7*m*m+4*m,2*m,m);CHKERRQ(ierr);
+  As    = fn->work;
+  A2    = As+m*m;
+  A4    = A2+m*m;
+  A6    = A4+m*m;
+  U     = A6+m*m;
+  V     = U+m*m;
+  W     = V+m*m;
+  work  = W+m*m;
+  rwork = fn->rwork;
+  ipiv  = fn->iwork;
+  ierr = PetscMemcpy(As,Aa,ld2*sizeof(PetscScalar));CHKERRQ(ierr);
+
+  /* select the degree of the approximant, computing only the needed powers of A */
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,As,&ld,As,&ld,&zero,A2,&ld));
+  ierr = expm_normest1(n,A2,ld,2,work,&nrm);CHKERRQ(ierr);
+  d4 = PetscPowReal(nrm,1.0/4.0);
+  ierr = expm_normest1(n,A2,ld,3,work,&nrm);CHKERRQ(ierr);
+  d6 = PetscPowReal(nrm,1.0/6.0);
+  eta1 = PetscMax(d4,d6);
+  if (eta1<=theta[0] && !expm_ell(n,As,ld,3,1.0,rwork)) deg = 3;
+  else {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,A2,&ld,A2,&ld,&zero,A4,&ld));
+    d4 = PetscPowReal(LAPACKlange_("O",&n,&n,A4,&ld,rwork),1.0/4.0);
+    if (PetscMax(d4,d6)<=theta[1] && !expm_ell(n,As,ld,5,1.0,rwork)) deg = 5;
+    else {
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,A2,&ld,A4,&ld,&zero,A6,&ld));
+      d6 = PetscPowReal(LAPACKlange_("O",&n,&n,A6,&ld,rwork),1.0/6.0);
+      ierr = expm_normest1(n,A4,ld,2,work,&nrm);CHKERRQ(ierr);
+      d8 = PetscPowReal(nrm,1.0/8.0);
+      eta3 = PetscMax(d6,d8);
+      if (eta3<=theta[2] && !expm_ell(n,As,ld,7,1.0,rwork)) deg = 7;
+      else if (eta3<=theta[3] && !expm_ell(n,As,ld,9,1.0,rwork)) deg = 9;
+      else {
+        ierr = expm_normest1(n,A2,ld,5,work,&nrm);CHKERRQ(ierr);
+        d10 = PetscPowReal(nrm,1.0/10.0);
+        eta4 = PetscMax(d8,d10);
+        eta1 = PetscMin(eta3,eta4);
+        s = PetscMax(0,(PetscInt)PetscCeilReal(PetscLogReal(eta1/theta[4])/PetscLogReal(2.0)));
+        s += expm_ell(n,As,ld,13,PetscPowRealInt(2.0,-s),rwork);
+        deg = 13;
+      }
+    }
+  }
+
+  /* evaluate the approximant as p(A)=V+U, q(A)=V-U, with U odd and V even */
+  switch (deg) {
+    case 3:
+    case 5:
+    case 7:
+    case 9:
+      c = (deg==3)? c3: (deg==5)? c5: (deg==7)? c7: c9;
+      if (deg==9) {  /* A8 is stored in W */
+        PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,A4,&ld,A4,&ld,&zero,W,&ld));
+      }
+      for (j=0;j<n;j++) {
+        for (i=0;i<n;i++) {
+          k = i+j*ld;
+          V[k] = c[2]*A2[k];
+          U[k] = c[3]*A2[k];
+          if (deg>3) {
+            V[k] += c[4]*A4[k];
+            U[k] += c[5]*A4[k];
+          }
+          if (deg>5) {
+            V[k] += c[6]*A6[k];
+            U[k] += c[7]*A6[k];
+          }
+          if (deg>7) {
+            V[k] += c[8]*W[k];
+            U[k] += c[9]*W[k];
+          }
+        }
+        V[j+j*ld] += c[0];
+        U[j+j*ld] += c[1];
+      }
+      /* U = A*U */
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,As,&ld,U,&ld,&zero,W,&ld));
+      SWAP(U,W,aux);
+      break;
+    case 13:
+      if (s) {
+        scal = PetscPowRealInt(2.0,-s);
+        PetscStackCallBLAS("BLASscal",BLASscal_(&ld2,&scal,As,&inc));
+        scal = PetscPowRealInt(2.0,-2*s);
+        PetscStackCallBLAS("BLASscal",BLASscal_(&ld2,&scal,A2,&inc));
+        scal = PetscPowRealInt(2.0,-4*s);
+        PetscStackCallBLAS("BLASscal",BLASscal_(&ld2,&scal,A4,&inc));
+        scal = PetscPowRealInt(2.0,-6*s);
+        PetscStackCallBLAS("BLASscal",BLASscal_(&ld2,&scal,A6,&inc));
+      }
+      c = c13;
+      /* V = A6*(c12*A6+c10*A4+c8*A2)+c6*A6+c4*A4+c2*A2+c0*I */
+      for (k=0;k<ld2;k++) U[k] = c[12]*A6[k]+c[10]*A4[k]+c[8]*A2[k];
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,A6,&ld,U,&ld,&zero,V,&ld));
+      for (k=0;k<ld2;k++) V[k] += c[6]*A6[k]+c[4]*A4[k]+c[2]*A2[k];
+      for (j=0;j<n;j++) V[j+j*ld] += c[0];
+      /* U = A*(A6*(c13*A6+c11*A4+c9*A2)+c7*A6+c5*A4+c3*A2+c1*I) */
+      for (k=0;k<ld2;k++) U[k] = c[13]*A6[k]+c[11]*A4[k]+c[9]*A2[k];
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,A6,&ld,U,&ld,&zero,W,&ld));
+      for (k=0;k<ld2;k++) W[k] += c[7]*A6[k]+c[5]*A4[k]+c[3]*A2[k];
+      for (j=0;j<n;j++) W[j+j*ld] += c[1];
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,As,&ld,W,&ld,&zero,U,&ld));
+      break;
+  }
+
+  /* solve (V-U)*F = V+U */
+  P = Ba;
+  for (k=0;k<ld2;k++) {
+    P[k] = V[k]+U[k];
+    V[k] -= U[k];
+  }
+  PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&n,&n,V,&ld,ipiv,P,&ld,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESV %d",info);
+
+  /* squaring phase */
+  for (k=1;k<=s;k++) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,P,&ld,P,&ld,&zero,W,&ld));
+    SWAP(P,W,aux);
+  }
+  if (P!=Ba) { ierr = PetscMemcpy(Ba,P,ld2*sizeof(PetscScalar));CHKERRQ(ierr); }
+
+  ierr = MatDenseRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&Ba);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   Backward error bounds theta_m of the truncated Taylor series of degree m,
+   for m=1,...,30,35,40,...,55 and a tolerance equal to the unit roundoff
+   in double precision, see Al-Mohy and Higham (2011)
+*/
+#define TAYLOR_NTHETA 35
+static const PetscReal taylor_theta[TAYLOR_NTHETA] = {
+  2.29e-16, 2.58e-8, 1.39e-5, 3.40e-4, 2.40e-3, 9.07e-3, 2.38e-2, 5.00e-2, 8.96e-2, 1.44e-1,
+  2.14e-1, 3.00e-1, 4.00e-1, 5.14e-1, 6.41e-1, 7.81e-1, 9.31e-1, 1.09, 1.26, 1.44,
+  1.62, 1.82, 2.01, 2.22, 2.43, 2.64, 2.86, 3.08, 3.31, 3.54,
+  4.7, 6.0, 7.2, 8.5, 9.9 };
+
+/*
+   FNExpTaylorParameters_Private - Selects the degree m of the Taylor polynomial
+   and the number of steps s to be used for computing exp(A)*b, given the 1-norm
+   of A, so that the number of matrix-vector products m*s is minimized.
+*/
+PetscErrorCode FNExpTaylorParameters_Private(PetscReal nrm,PetscInt *m,PetscInt *s)
+{
+  PetscInt  i,deg;
+  PetscReal steps,cost,mincost=PETSC_MAX_REAL;
+
+  PetscFunctionBegin;
+  *m = 0;
+  *s = 1;
+  if (nrm==0.0) PetscFunctionReturn(0);
+  for (i=0;i<TAYLOR_NTHETA;i++) {
+    deg = (i<30)? i+1: 30+5*(i-29);
+    steps = PetscMax(1.0,PetscCeilReal(nrm/taylor_theta[i]));
+    cost = deg*steps;
+    if (cost<mincost) {
+      mincost = cost;
+      *m = deg;
+      *s = (PetscInt)steps;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   FNExpTaylorStep_Private - Computes x = T_m(h*A)*x, where T_m is the Taylor
+   polynomial of degree m of the exponential, with m matrix-vector products at
+   most. The summation is stopped as soon as two consecutive terms are negligible.
+   Only MatMult() is used, so A can be a sparse or parallel matrix. On output,
+   err (optional) is the relative size of the last two terms of the series.
+   Workspace: w (two vectors)
+*/
+PetscErrorCode FNExpTaylorStep_Private(PetscScalar h,PetscInt m,Mat A,Vec x,Vec *w,PetscReal *err)
+{
+  PetscErrorCode ierr;
+  PetscInt       j;
+  PetscReal      c1,c2=0.0,nrm=1.0,tol=PETSC_MACHINE_EPSILON/2.0;
+  Vec            v=w[0],z=w[1],aux;
+
+  PetscFunctionBegin;
+  ierr = VecCopy(x,v);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_INFINITY,&c1);CHKERRQ(ierr);
+  for (j=1;j<=m;j++) {
+    ierr = MatMult(A,v,z);CHKERRQ(ierr);
+    ierr = VecScale(z,h/(PetscReal)j);CHKERRQ(ierr);
+    aux = v; v = z; z = aux;
+    ierr = VecNorm(v,NORM_INFINITY,&c2);CHKERRQ(ierr);
+    ierr = VecAXPY(x,1.0,v);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    if (c1+c2<=tol*nrm) break;
+    c1 = c2;
+  }
+  if (err) *err = (nrm>0.0)? (c1+c2)/nrm: 0.0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes exp(A)*e_1 with the truncated Taylor algorithm of Al-Mohy and Higham,
+
+   [3] A. H. Al-Mohy and N. J. Higham, "Computing the action of the matrix
+       exponential, with an application to exponential integrators", SIAM J.
+       Sci. Comput. 33(2):488-511, 2011.
+
+   which only requires matrix-vector products. If the estimated cost is larger
+   than computing the whole exp(A) then the latter is done instead.
+*/
+static PetscErrorCode FNEvaluateFunctionMatVec_Exp_Higham(FN fn,Mat A,Vec v)
+{
+  PetscErrorCode ierr;
+  FN_EXP         *ctx = (FN_EXP*)fn->data;
+  PetscInt       i,n,m,s,nw,nl,nwl;
+  PetscReal      nrm,nsq;
+  PetscScalar    *pv;
+  Mat            F;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,&n,NULL);CHKERRQ(ierr);
+  ierr = MatNorm(A,NORM_1,&nrm);CHKERRQ(ierr);
+  ierr = FNExpTaylorParameters_Private(nrm,&m,&s);CHKERRQ(ierr);
+  nsq = (nrm>4.25)? PetscCeilReal(PetscLogReal(nrm/4.25)/PetscLogReal(2.0)): 0.0;
+  if ((PetscReal)m*s <= n*(8.0+nsq)) {  /* m*s products with A versus about 8+nsq matrix-matrix products */
+    if (ctx->w[0]) {
+      ierr = VecGetSize(ctx->w[0],&nw);CHKERRQ(ierr);
+      ierr = VecGetLocalSize(ctx->w[0],&nwl);CHKERRQ(ierr);
+      ierr = VecGetLocalSize(v,&nl);CHKERRQ(ierr);
+      if (nw!=n || nwl!=nl) {  /* vectors of a previous call with a different layout */
+        ierr = VecDestroy(&ctx->w[0]);CHKERRQ(ierr);
+        ierr = VecDestroy(&ctx->w[1]);CHKERRQ(ierr);
+      }
+    }
+    if (!ctx->w[0]) {
+      ierr = PetscLogEventBegin(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
+      ierr = VecDuplicate(v,&ctx->w[0]);CHKERRQ(ierr);
+      ierr = VecDuplicate(v,&ctx->w[1]);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)fn,(PetscObject)ctx->w[0]);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)fn,(PetscObject)ctx->w[1]);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
+    }
+    ierr = VecSet(v,0.0);CHKERRQ(ierr);
+    ierr = VecGetArray(v,&pv);CHKERRQ(ierr);
+    pv[0] = 1.0;
+    ierr = VecRestoreArray(v,&pv);CHKERRQ(ierr);
+    for (i=0;i<s;i++) {
+      ierr = FNExpTaylorStep_Private(1.0/(PetscReal)s,m,A,v,ctx->w,NULL);CHKERRQ(ierr);
+    }
+  } else {
+    ierr = FN_AllocateWorkMat(fn,A,&F);CHKERRQ(ierr);
+    ierr = FNEvaluateFunctionMat_Exp_Higham(fn,A,F);CHKERRQ(ierr);
+    ierr = MatGetColumnVector(F,v,0);CHKERRQ(ierr);
+    ierr = FN_FreeWorkMat(fn,&F);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode FNView_Exp(FN fn,PetscViewer viewer)
 {
   PetscErrorCode ierr;
   PetscBool      isascii;
   char           str[50];
+  const char     *methodname[] = {
+                  "scaling & squaring, [m/m] Pade approximant (Higham)",
+                  "scaling & squaring, [6/6] Pade approximant"
+  };
+  const int      nmeth=sizeof(methodname)/sizeof(methodname[0]);
 
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
@@ -162,17 +589,43 @@ PetscErrorCode FNView_Exp(FN fn,PetscViewer viewer)
         ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
       }
     }
+    if (fn->method<nmeth) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  computing matrix functions with: %s\n",methodname[fn->method]);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode FNDestroy_Exp(FN fn)
+{
+  PetscErrorCode ierr;
+  FN_EXP         *ctx = (FN_EXP*)fn->data;
+
+  PetscFunctionBegin;
+  ierr = VecDestroy(&ctx->w[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->w[1]);CHKERRQ(ierr);
+  ierr = PetscFree(fn->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_EXTERN PetscErrorCode FNCreate_Exp(FN fn)
 {
+  PetscErrorCode ierr;
+  FN_EXP         *ctx;
+
   PetscFunctionBegin;
-  fn->ops->evaluatefunction    = FNEvaluateFunction_Exp;
-  fn->ops->evaluatederivative  = FNEvaluateDerivative_Exp;
-  fn->ops->evaluatefunctionmat = FNEvaluateFunctionMat_Exp;
-  fn->ops->view                = FNView_Exp;
+  ierr = PetscNewLog(fn,&ctx);CHKERRQ(ierr);
+  fn->data = (void*)ctx;
+
+  fn->ops->evaluatefunction       = FNEvaluateFunction_Exp;
+  fn->ops->evaluatederivative     = FNEvaluateDerivative_Exp;
+  fn->ops->evaluatefunctionarray  = FNEvaluateFunctionArray_Exp;
+  fn->ops->evaluatederivativearray = FNEvaluateFunctionArray_Exp;
+  fn->ops->evaluatefunctionmat[0] = FNEvaluateFunctionMat_Exp_Higham;
+  fn->ops->evaluatefunctionmat[1] = FNEvaluateFunctionMat_Exp_Pade;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Exp_Higham;
+  fn->ops->view                   = FNView_Exp;
+  fn->ops->destroy                = FNDestroy_Exp;
   PetscFunctionReturn(0);
 }
 
@@ -24,6 +24,85 @@
 #include <slepc/private/fnimpl.h>      /*I "slepcfn.h" I*/
 #include <slepcblaslapack.h>
 
+/*
+   FNSchurDecomposition_Private - Computes the Schur decomposition A = Q*T*Q' of the
+   (scaled) argument of a matrix function. On input T contains A, and it is overwritten
+   with the Schur form. The eigenvalues are returned in wr,wi if not NULL (wi is not
+   referenced in complex scalars). The caller provides the workspace, work of length
+   6*n and rwork of length n, since it usually lives in fn->work and fn->rwork.
+
+   If the Schur cache is enabled, the decomposition is kept together with the identity
+   and state of the argument of FNEvaluateFunctionMat() or FNEvaluateFunctionMatVec(),
+   and subsequent calls with the same unmodified matrix just copy it, multiplying T
+   and the eigenvalues if the scaling factor alpha is different.
+*/
+PetscErrorCode FNSchurDecomposition_Private(FN fn,PetscBLASInt n,PetscScalar *T,PetscBLASInt ld,PetscScalar *Q,PetscScalar *wr,PetscReal *wi,PetscScalar *work,PetscReal *rwork)
+{
+#if defined(SLEPC_MISSING_LAPACK_GEES)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GEES - Lapack routine is unavailable");
+#else
+  PetscErrorCode ierr;
+  FN_SCHUR       *sc = fn->schur;
+  PetscBLASInt   i,j,sdim,lwork,info;
+  PetscScalar    *ewr,s;
+  PetscReal      *ewi;
+
+  PetscFunctionBegin;
+  if (sc && fn->argid && sc->n==n && sc->id==fn->argid && sc->state==fn->argstate && sc->alpha!=0.0) {
+    s = fn->alpha/sc->alpha;
+    for (j=0;j<n;j++) {
+      for (i=0;i<n;i++) {
+        T[i+j*ld] = s*sc->T[i+j*n];
+        Q[i+j*ld] = sc->Q[i+j*n];
+      }
+    }
+    if (wr) for (i=0;i<n;i++) wr[i] = s*sc->wr[i];
+#if !defined(PETSC_USE_COMPLEX)
+    if (wi) for (i=0;i<n;i++) wi[i] = s*sc->wi[i];
+#endif
+    sc->nhit++;
+    PetscFunctionReturn(0);
+  }
+
+  lwork = 5*n;
+  ewr   = work;
+  ewi   = rwork;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKgees",LAPACKgees_("V","N",NULL,&n,T,&ld,&sdim,ewr,ewi,Q,&ld,work+n,&lwork,NULL,&info));
+#else
+  PetscStackCallBLAS("LAPACKgees",LAPACKgees_("V","N",NULL,&n,T,&ld,&sdim,ewr,Q,&ld,work+n,&lwork,ewi,NULL,&info));
+#endif
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEES %d",info);
+  if (wr) { ierr = PetscMemcpy(wr,ewr,n*sizeof(PetscScalar));CHKERRQ(ierr); }
+#if !defined(PETSC_USE_COMPLEX)
+  if (wi) { ierr = PetscMemcpy(wi,ewi,n*sizeof(PetscReal));CHKERRQ(ierr); }
+#endif
+
+  /* store the decomposition */
+  if (sc && fn->argid) {
+    if (n>sc->nalloc) {
+      ierr = PetscFree4(sc->T,sc->Q,sc->wr,sc->wi);CHKERRQ(ierr);
+      ierr = PetscMalloc4(n*n,&sc->T,n*n,&sc->Q,n,&sc->wr,n,&sc->wi);CHKERRQ(ierr);
+      sc->nalloc = n;
+    }
+    for (j=0;j<n;j++) {
+      for (i=0;i<n;i++) {
+        sc->T[i+j*n] = T[i+j*ld];
+        sc->Q[i+j*n] = Q[i+j*ld];
+      }
+    }
+    ierr = PetscMemcpy(sc->wr,ewr,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemcpy(sc->wi,ewi,n*sizeof(PetscReal));CHKERRQ(ierr);
+    sc->id    = fn->argid;
+    sc->state = fn->argstate;
+    sc->n     = n;
+    sc->alpha = fn->alpha;
+  }
+  PetscFunctionReturn(0);
+#endif
+}
+
 /*
    Compute the square root of an upper quasi-triangular matrix T,
    using Higham's algorithm (LAA 88, 1987). T is overwritten with sqrtm(T).
@@ -93,40 +172,33 @@ PetscErrorCode SlepcMatDenseSqrt(PetscBLASInt n,PetscScalar *T,PetscBLASInt ld)
    Simplified Schur-Parlett algorithm on an upper quasi-triangular matrix T,
    particularized for the square root function. T is overwritten with sqrtm(T).
    If firstonly then only the first column of T will contain relevant values.
+   The Schur decomposition is obtained with FNSchurDecomposition_Private(), so
+   that it can be reused from the cache of fn.
  */
-PetscErrorCode SlepcSchurParlettSqrt(PetscBLASInt n,PetscScalar *T,PetscBLASInt ld,PetscBool firstonly)
+PetscErrorCode SlepcSchurParlettSqrt(FN fn,PetscBLASInt n,PetscScalar *T,PetscBLASInt ld,PetscBool firstonly)
 {
-#if defined(SLEPC_MISSING_LAPACK_GEES) || defined(SLEPC_MISSING_LAPACK_TRSYL)
+#if defined(SLEPC_MISSING_LAPACK_TRSYL)
   PetscFunctionBegin;
-  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GEES/TRSYL - Lapack routines are unavailable");
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"TRSYL - Lapack routine is unavailable");
 #else
   PetscErrorCode ierr;
-  PetscBLASInt   i,j,k,r,ione=1,sdim,lwork,*s,*p,info,bs=BLOCKSIZE;
-  PetscScalar    *wr,*W,*Q,*work,one=1.0,zero=0.0,mone=-1.0;
+  PetscBLASInt   i,j,k,r,ione=1,*s,*p,info,bs=BLOCKSIZE;
+  PetscScalar    *W,*Q,one=1.0,zero=0.0,mone=-1.0;
   PetscInt       m,nblk;
   PetscReal      scal;
-#if defined(PETSC_USE_COMPLEX)
-  PetscReal      *rwork;
-#else
-  PetscReal      *wi;
-#endif
 
   PetscFunctionBegin;
   m     = n;
   nblk  = (m+bs-1)/bs;
-  lwork = 5*n;
   k     = firstonly? 1: n;
 
   /* compute Schur decomposition A*Q = Q*T */
-#if !defined(PETSC_USE_COMPLEX)
-  ierr = PetscMalloc7(m,&wr,m,&wi,m*k,&W,m*m,&Q,lwork,&work,nblk,&s,nblk,&p);CHKERRQ(ierr);
-  PetscStackCallBLAS("LAPACKgees",LAPACKgees_("V","N",NULL,&n,T,&ld,&sdim,wr,wi,Q,&ld,work,&lwork,NULL,&info));
-  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEES %d",info);
-#else
-  ierr = PetscMalloc7(m,&wr,m,&rwork,m*k,&W,m*m,&Q,lwork,&work,nblk,&s,nblk,&p);CHKERRQ(ierr);
-  PetscStackCallBLAS("LAPACKgees",LAPACKgees_("V","N",NULL,&n,T,&ld,&sdim,wr,Q,&ld,work,&lwork,rwork,NULL,&info));
-  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGEES %d",info);
-#endif
+  ierr = FNAllocateWork_Private(fn,m*k+m*m+6*m,m,2*nblk);CHKERRQ(ierr);
+  W = fn->work;
+  Q = W+m*k;
+  s = fn->iwork;
+  p = s+nblk;
+  ierr = FNSchurDecomposition_Private(fn,n,T,ld,Q,NULL,NULL,Q+m*m,fn->rwork);CHKERRQ(ierr);
 
   /* determine block sizes and positions, to avoid cutting 2x2 blocks */
   j = 0;
@@ -158,13 +230,162 @@ PetscErrorCode SlepcSchurParlettSqrt(PetscBLASInt n,PetscScalar *T,PetscBLASInt
   /* backtransform B = Q*T*Q' */
   PetscStackCallBLAS("BLASgemm",BLASgemm_("N","C",&n,&k,&n,&one,T,&ld,Q,&ld,&zero,W,&ld));
   PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&k,&n,&one,Q,&ld,W,&ld,&zero,T,&ld));
+  PetscFunctionReturn(0);
+#endif
+}
 
-#if !defined(PETSC_USE_COMPLEX)
-  ierr = PetscFree7(wr,wi,W,Q,work,s,p);CHKERRQ(ierr);
+
+/*
+   Computes the principal square root of the matrix T using the product form of the
+   Denman-Beavers iteration with determinantal scaling, see Higham, "Functions of
+   Matrices", 2008, section 6.3. T is overwritten with sqrtm(T), or with inv(sqrtm(T))
+   if inv is true. The work is done by LU factorizations, inversions and matrix
+   products, which perform better than the Schur method on large matrices.
+ */
+PetscErrorCode SlepcSqrtmDenmanBeavers(FN fn,PetscBLASInt n,PetscScalar *T,PetscBLASInt ld,PetscBool inv)
+{
+#if defined(PETSC_MISSING_LAPACK_GETRF) || defined(PETSC_MISSING_LAPACK_GETRI)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GETRF/GETRI - Lapack routines are unavailable");
 #else
-  ierr = PetscFree7(wr,rwork,W,Q,work,s,p);CHKERRQ(ierr);
-#endif
+  PetscErrorCode ierr;
+  PetscScalar    *M,*M2,*W,*work,work1,sone=1.0,szero=0.0,mu2;
+  PetscBLASInt   N,i,j,*piv,lwork,info;
+  PetscInt       it,maxit=25;
+  PetscReal      mu,ldet,nrm,tol;
+  PetscBool      scale=PETSC_TRUE;
+
+  PetscFunctionBegin;
+  N   = ld*n;
+  tol = PetscSqrtReal((PetscReal)n)*PETSC_MACHINE_EPSILON/2.0;
+  lwork = -1;
+  PetscStackCallBLAS("LAPACKgetri",LAPACKgetri_(&n,T,&ld,NULL,&work1,&lwork,&info));
+  ierr = PetscBLASIntCast((PetscInt)PetscRealPart(work1),&lwork);CHKERRQ(ierr);
+  ierr = FNAllocateWork_Private(fn,3*N+lwork,0,n);CHKERRQ(ierr);
+  M    = fn->work;
+  M2   = M+N;
+  W    = M2+N;
+  work = W+N;
+  piv  = fn->iwork;
+
+  /* M_0 = A, and the iterate is either Y_0 = A or Z_0 = I */
+  ierr = PetscMemcpy(M,T,N*sizeof(PetscScalar));CHKERRQ(ierr);
+  if (inv) {
+    ierr = PetscMemzero(T,N*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (i=0;i<n;i++) T[i+i*ld] = 1.0;
+  }
+
+  for (it=0;it<maxit;it++) {
+    /* M2 = inv(M_k), and the scaling factor mu = |det(M_k)|^(-1/(2n)) from its LU factors */
+    ierr = PetscMemcpy(M2,M,N*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,M2,&ld,piv,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRF %d",info);
+    mu = 1.0;
+    if (scale) {
+      ldet = 0.0;
+      for (i=0;i<n;i++) ldet += PetscLogReal(PetscAbsScalar(M2[i+i*ld]));
+      mu = PetscExpReal(-ldet/(2.0*n));
+    }
+    PetscStackCallBLAS("LAPACKgetri",LAPACKgetri_(&n,M2,&ld,piv,work,&lwork,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGETRI %d",info);
+
+    /* M_{k+1} = (I+(mu^2*M_k+mu^(-2)*inv(M_k))/2)/2 */
+    mu2 = mu*mu;
+    for (i=0;i<N;i++) M[i] = 0.25*(mu2*M[i]+M2[i]/mu2);
+    for (i=0;i<n;i++) M[i+i*ld] += 0.5;
+
+    /* Y_{k+1} = mu*Y_k*(I+mu^(-2)*inv(M_k))/2 */
+    for (i=0;i<N;i++) M2[i] *= 0.5/mu;
+    for (i=0;i<n;i++) M2[i+i*ld] += 0.5*mu;
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,T,&ld,M2,&ld,&szero,W,&ld));
+    ierr = PetscMemcpy(T,W,N*sizeof(PetscScalar));CHKERRQ(ierr);
+
+    /* check convergence, ||M_{k+1}-I||_F, and switch off scaling when close */
+    nrm = 0.0;
+    for (j=0;j<n;j++) {
+      for (i=0;i<n;i++) nrm += PetscSqr(PetscAbsScalar((i==j)? M[i+j*ld]-1.0: M[i+j*ld]));
+    }
+    nrm = PetscSqrtReal(nrm);
+    if (nrm<=tol) break;
+    if (nrm<1e-2) scale = PETSC_FALSE;
+  }
+  if (it==maxit) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_NOT_CONVERGED,"Denman-Beavers iteration did not converge after %D iterations",maxit);
+  ierr = PetscLogFlops(it*(4.0*n*n*n/3.0+2.0*n*n*n));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 #endif
 }
 
+/*
+   Computes the principal square root of the matrix T with the coupled Newton-Schulz
+   iteration, which only requires matrix-matrix products, see Higham, "Functions of
+   Matrices", 2008, section 6.7. Convergence is guaranteed when ||I-T/c||<1, where
+   c=||T||_F is the scaling used, e.g. if T is Hermitian positive definite. T is
+   overwritten with sqrtm(T), or with inv(sqrtm(T)) if inv is true.
+ */
+PetscErrorCode SlepcSqrtmNewtonSchulz(FN fn,PetscBLASInt n,PetscScalar *T,PetscBLASInt ld,PetscBool inv)
+{
+#if defined(SLEPC_MISSING_LAPACK_LANGE)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"LANGE - Lapack routine is unavailable");
+#else
+  PetscErrorCode ierr;
+  PetscScalar    *Y,*Z,*W,*V,sone=1.0,szero=0.0,alpha;
+  PetscBLASInt   N,i,j;
+  PetscInt       it,maxit=100;
+  PetscReal      c,nrm,nrm0=PETSC_MAX_REAL,tol;
+
+  PetscFunctionBegin;
+  N   = ld*n;
+  tol = PetscSqrtReal((PetscReal)n)*PETSC_MACHINE_EPSILON/2.0;
+  c   = LAPACKlange_("F",&n,&n,T,&ld,NULL);
+  if (c==0.0) {
+    if (inv) SETERRQ(PETSC_COMM_SELF,1,"Cannot compute the inverse square root of a zero matrix");
+    PetscFunctionReturn(0);
+  }
+  ierr = FNAllocateWork_Private(fn,4*N,0,0);CHKERRQ(ierr);
+  Y = fn->work;
+  Z = Y+N;
+  W = Z+N;
+  V = W+N;
+
+  /* Y_0 = T/c, Z_0 = I */
+  for (i=0;i<N;i++) Y[i] = T[i]/c;
+  ierr = PetscMemzero(Z,N*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (i=0;i<n;i++) Z[i+i*ld] = 1.0;
+
+  for (it=0;it<maxit;it++) {
+    /* W = (3*I-Z_k*Y_k)/2, and the residual ||I-Z_k*Y_k||_F */
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,Z,&ld,Y,&ld,&szero,W,&ld));
+    nrm = 0.0;
+    for (j=0;j<n;j++) {
+      for (i=0;i<n;i++) {
+        W[i+j*ld] = (i==j)? 1.0-W[i+j*ld]: -W[i+j*ld];
+        nrm += PetscSqr(PetscAbsScalar(W[i+j*ld]));
+      }
+    }
+    nrm = PetscSqrtReal(nrm);
+    /* stop when converged, or when rounding errors prevent further progress */
+    if (nrm<=tol || (nrm<1e-3 && nrm>=nrm0)) break;
+    nrm0 = nrm;
+    for (i=0;i<N;i++) W[i] *= 0.5;
+    for (i=0;i<n;i++) W[i+i*ld] += 1.0;
+    /* Y_{k+1} = Y_k*W, Z_{k+1} = W*Z_k */
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,Y,&ld,W,&ld,&szero,V,&ld));
+    ierr = PetscMemcpy(Y,V,N*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,W,&ld,Z,&ld,&szero,V,&ld));
+    ierr = PetscMemcpy(Z,V,N*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  if (it==maxit) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_NOT_CONVERGED,"Newton-Schulz iteration did not converge after %D iterations, the matrix may not be positive definite",maxit);
+
+  /* sqrtm(T) = sqrt(c)*Y, inv(sqrtm(T)) = Z/sqrt(c) */
+  if (inv) {
+    alpha = 1.0/PetscSqrtReal(c);
+    for (i=0;i<N;i++) T[i] = alpha*Z[i];
+  } else {
+    alpha = PetscSqrtReal(c);
+    for (i=0;i<N;i++) T[i] = alpha*Y[i];
+  }
+  ierr = PetscLogFlops(it*6.0*n*n*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
@@ -46,7 +46,37 @@ PetscErrorCode FNEvaluateDerivative_Invsqrt(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode FNEvaluateFunctionMat_Invsqrt(FN fn,Mat A,Mat B)
+PetscErrorCode FNEvaluateFunctionArray_Invsqrt(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    if (x[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Function not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+    if (x[i]<0.0) SETERRQ(PETSC_COMM_SELF,1,"Function not defined in the requested value");
+#endif
+  }
+  for (i=0;i<n;i++) y[i] = 1.0/PetscSqrtScalar(x[i]);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateDerivativeArray_Invsqrt(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    if (x[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+    if (x[i]<0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+#endif
+  }
+  for (i=0;i<n;i++) y[i] = -1.0/(2.0*PetscPowScalarReal(x[i],1.5));
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateFunctionMat_Invsqrt_Schur(FN fn,Mat A,Mat B)
 {
   PetscErrorCode ierr;
   PetscBLASInt   n,ld,*ipiv,info;
@@ -63,19 +93,19 @@ PetscErrorCode FNEvaluateFunctionMat_Invsqrt(FN fn,Mat A,Mat B)
   ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
   ld = n;
-  ierr = SlepcSchurParlettSqrt(n,Ba,n,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = SlepcSchurParlettSqrt(fn,n,Ba,n,PETSC_FALSE);CHKERRQ(ierr);
   /* compute B = A\B */
-  ierr = PetscMalloc1(ld,&ipiv);CHKERRQ(ierr);
+  ierr = FNAllocateWork_Private(fn,0,0,ld);CHKERRQ(ierr);
+  ipiv = fn->iwork;
   PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&n,&n,Wa,&ld,ipiv,Ba,&ld,&info));
   if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESV %d",info);
-  ierr = PetscFree(ipiv);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(W,&Wa);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(B,&Ba);CHKERRQ(ierr);
   ierr = FN_FreeWorkMat(fn,&W);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode FNEvaluateFunctionMatVec_Invsqrt(FN fn,Mat A,Vec v)
+PetscErrorCode FNEvaluateFunctionMatVec_Invsqrt_Schur(FN fn,Mat A,Vec v)
 {
   PetscErrorCode ierr;
   PetscBLASInt   n,ld,*ipiv,info,one=1;
@@ -92,12 +122,12 @@ PetscErrorCode FNEvaluateFunctionMatVec_Invsqrt(FN fn,Mat A,Vec v)
   ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
   ld = n;
-  ierr = SlepcSchurParlettSqrt(n,Ba,n,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = SlepcSchurParlettSqrt(fn,n,Ba,n,PETSC_TRUE);CHKERRQ(ierr);
   /* compute B_1 = A\B_1 */
-  ierr = PetscMalloc1(ld,&ipiv);CHKERRQ(ierr);
+  ierr = FNAllocateWork_Private(fn,0,0,ld);CHKERRQ(ierr);
+  ipiv = fn->iwork;
   PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&n,&one,Wa,&ld,ipiv,Ba,&ld,&info));
   if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESV %d",info);
-  ierr = PetscFree(ipiv);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(W,&Wa);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(B,&Ba);CHKERRQ(ierr);
   ierr = MatGetColumnVector(B,v,0);CHKERRQ(ierr);
@@ -106,11 +136,51 @@ PetscErrorCode FNEvaluateFunctionMatVec_Invsqrt(FN fn,Mat A,Vec v)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode FNEvaluateFunctionMat_Invsqrt_DBP(FN fn,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+  PetscBLASInt   n;
+  PetscScalar    *T;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  if (A!=B) { ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr); }
+  ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ierr = SlepcSqrtmDenmanBeavers(fn,n,T,n,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateFunctionMat_Invsqrt_NS(FN fn,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+  PetscBLASInt   n;
+  PetscScalar    *T;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  if (A!=B) { ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr); }
+  ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ierr = SlepcSqrtmNewtonSchulz(fn,n,T,n,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode FNView_Invsqrt(FN fn,PetscViewer viewer)
 {
   PetscErrorCode ierr;
   PetscBool      isascii;
   char           str[50];
+  const char     *methodname[] = {
+                  "Schur method for the square root",
+                  "Denman-Beavers (product form)",
+                  "Newton-Schulz iteration"
+  };
+  const int      nmeth=sizeof(methodname)/sizeof(methodname[0]);
 
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
@@ -134,6 +204,9 @@ PetscErrorCode FNView_Invsqrt(FN fn,PetscViewer viewer)
         ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
       }
     }
+    if (fn->method<nmeth) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  computing matrix functions with: %s\n",methodname[fn->method]);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -141,11 +214,15 @@ PetscErrorCode FNView_Invsqrt(FN fn,PetscViewer viewer)
 PETSC_EXTERN PetscErrorCode FNCreate_Invsqrt(FN fn)
 {
   PetscFunctionBegin;
-  fn->ops->evaluatefunction       = FNEvaluateFunction_Invsqrt;
-  fn->ops->evaluatederivative     = FNEvaluateDerivative_Invsqrt;
-  fn->ops->evaluatefunctionmat    = FNEvaluateFunctionMat_Invsqrt;
-  fn->ops->evaluatefunctionmatvec = FNEvaluateFunctionMatVec_Invsqrt;
-  fn->ops->view                   = FNView_Invsqrt;
+  fn->ops->evaluatefunction          = FNEvaluateFunction_Invsqrt;
+  fn->ops->evaluatederivative        = FNEvaluateDerivative_Invsqrt;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Invsqrt;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Invsqrt;
+  fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Invsqrt_Schur;
+  fn->ops->evaluatefunctionmat[1]    = FNEvaluateFunctionMat_Invsqrt_DBP;
+  fn->ops->evaluatefunctionmat[2]    = FNEvaluateFunctionMat_Invsqrt_NS;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Invsqrt_Schur;
+  fn->ops->view                      = FNView_Invsqrt;
   PetscFunctionReturn(0);
 }
 
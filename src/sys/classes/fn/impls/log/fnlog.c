@@ -22,6 +22,7 @@
 */
 
 #include <slepc/private/fnimpl.h>      /*I "slepcfn.h" I*/
+#include <slepcblaslapack.h>
 
 PetscErrorCode FNEvaluateFunction_Log(FN fn,PetscScalar x,PetscScalar *y)
 {
@@ -44,6 +45,221 @@ PetscErrorCode FNEvaluateDerivative_Log(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode FNEvaluateFunctionArray_Log(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) if (x[i]<0.0) SETERRQ(PETSC_COMM_SELF,1,"Function not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = PetscLogScalar(x[i]);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateDerivativeArray_Log(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    if (x[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+    if (x[i]<0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+#endif
+  }
+  for (i=0;i<n;i++) y[i] = 1.0/x[i];
+  PetscFunctionReturn(0);
+}
+
+/*
+   Nodes x and weights w of the m-point Gauss-Legendre quadrature rule in [0,1]
+*/
+static void logm_gauss_legendre(PetscInt m,PetscReal *x,PetscReal *w)
+{
+  PetscInt  i,j,it;
+  PetscReal z,z1,p1,p2,p3,pp=1.0;
+
+  for (i=0;i<(m+1)/2;i++) {
+    /* Newton iteration for the i-th root of the Legendre polynomial P_m */
+    z = PetscCosReal(PETSC_PI*(i+0.75)/(m+0.5));
+    for (it=0;it<100;it++) {
+      p1 = 1.0; p2 = 0.0;
+      for (j=1;j<=m;j++) {
+        p3 = p2; p2 = p1;
+        p1 = ((2.0*j-1.0)*z*p2-(j-1.0)*p3)/j;
+      }
+      pp = m*(z*p1-p2)/(z*z-1.0);
+      z1 = z;
+      z  = z1-p1/pp;
+      if (PetscAbsReal(z-z1)<=10*PETSC_MACHINE_EPSILON) break;
+    }
+    x[i]     = (1.0-z)/2.0;
+    x[m-1-i] = (1.0+z)/2.0;
+    w[i]     = 1.0/((1.0-z*z)*pp*pp);
+    w[m-1-i] = w[i];
+  }
+}
+
+/*
+   Inverse scaling and squaring algorithm for the principal logarithm,
+   simplified version of Algorithm 4.1 in
+
+   [1] A. H. Al-Mohy and N. J. Higham, "Improved inverse scaling and
+       squaring algorithms for the matrix logarithm", SIAM J. Sci. Comput.
+       34(4):C153-C169, 2012.
+
+   The Schur form T=Q'*A*Q is computed once, and square roots of T are taken
+   with the quasi-triangular kernel of the Schur-Parlett square root until
+   ||T-I||_1 is small enough for a diagonal Pade approximant of log(1+x) of
+   degree m<=16, which is evaluated in partial fraction form. The values
+   theta_m are the largest |x| for which the [m/m] approximant has relative
+   error below the unit roundoff in double precision. A is overwritten
+   with logm(A). If firstonly then only the first column will contain relevant
+   values.
+ */
+static PetscErrorCode logm_iss(FN fn,PetscBLASInt n,PetscScalar *T,PetscBLASInt ld,PetscBool firstonly)
+{
+#if defined(PETSC_MISSING_LAPACK_GESV)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GESV - Lapack routine is unavailable");
+#else
+  PetscErrorCode  ierr;
+  PetscBLASInt    i,j,k,info,*ipiv,ione=1;
+  PetscInt        s=0,p=0,q,m,m2,maxsqrt=100;
+  PetscScalar     *Q,*R,*W,*L,*Y,*d,*wr,*work,one=1.0,zero=0.0,a,r;
+  PetscReal       *rwork,nrm,sum,x[16],w[16];
+  const PetscReal theta[16] = { 3.649e-8, 3.759e-4, 8.196e-3, 3.783e-2, 9.291e-2, 1.656e-1, 2.457e-1, 3.253e-1,
+                                3.997e-1, 4.670e-1, 5.265e-1, 5.785e-1, 6.237e-1, 6.630e-1, 6.970e-1, 7.266e-1 };
+
+  PetscFunctionBegin;
+  k     = firstonly? 1: n;
+  ierr = FNAllocateWork_Private(fn,4*n*n+8*n,2*n,n);CHKERRQ(ierr);
+  Q     = fn->work;
+  R     = Q+n*n;
+  W     = R+n*n;
+  L     = W+n*n;
+  d     = L+n*n;
+  wr    = d+n;
+  work  = wr+n;
+  rwork = fn->rwork;
+  ipiv  = fn->iwork;
+
+  /* compute Schur decomposition A*Q = Q*T, or take it from the cache */
+  ierr = FNSchurDecomposition_Private(fn,n,T,ld,Q,wr,rwork,work,rwork+n);CHKERRQ(ierr);
+  for (i=0;i<n;i++) {
+#if !defined(PETSC_USE_COMPLEX)
+    if (rwork[i]==0.0 && wr[i]<=0.0) SETERRQ(PETSC_COMM_SELF,1,"Matrix has a real nonpositive eigenvalue, the principal logarithm is not defined");
+#else
+    if (PetscImaginaryPart(wr[i])==0.0 && PetscRealPart(wr[i])<=0.0) SETERRQ(PETSC_COMM_SELF,1,"Matrix has a real nonpositive eigenvalue, the principal logarithm is not defined");
+#endif
+    d[i] = T[i+i*ld];
+  }
+
+  /* take square roots until the degree m of the Pade approximant is small enough,
+     or another square root does not reduce it by more than one */
+  while (1) {
+    nrm = 0.0;
+    for (j=0;j<n;j++) {
+      sum = 0.0;
+      for (i=0;i<n;i++) sum += PetscAbsScalar((i==j)? T[i+j*ld]-1.0: T[i+j*ld]);
+      nrm = PetscMax(nrm,sum);
+    }
+    if (nrm<=theta[15]) {
+      for (m=1;nrm>theta[m-1];m++);
+      for (m2=1;nrm/2.0>theta[m2-1];m2++);
+      if (m-m2<=1 || p==2) break;
+      p++;
+    }
+    if (s==maxsqrt) SETERRQ1(PETSC_COMM_SELF,1,"Too many square roots (%D), the matrix may be close to singular",s);
+    ierr = SlepcMatDenseSqrt(n,T,ld);CHKERRQ(ierr);
+    s++;
+  }
+
+  /* R = T-I, recomputing the diagonal of 1x1 blocks to avoid cancellation */
+  for (j=0;j<n;j++) {
+    for (i=0;i<n;i++) R[i+j*ld] = T[i+j*ld];
+    R[j+j*ld] -= 1.0;
+#if !defined(PETSC_USE_COMPLEX)
+    if (rwork[j]!=0.0) continue;
+#endif
+    a = d[j];
+    r = a-1.0;
+    for (i=0;i<s;i++) {
+      a = PetscSqrtScalar(a);
+      r = r/(1.0+a);
+    }
+    R[j+j*ld] = r;
+  }
+
+  /* evaluate r_m(R) = sum_j w_j*(I+x_j*R)\R, applied to Q'*e_1 if firstonly */
+  if (firstonly) {
+    for (i=0;i<n;i++) work[i] = PetscConj(Q[i*ld]);
+    Y = work+n;
+    PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n,&n,&one,R,&ld,work,&ione,&zero,Y,&ione));
+  } else Y = R;
+  ierr = PetscMemzero(L,n*k*sizeof(PetscScalar));CHKERRQ(ierr);
+  logm_gauss_legendre(m,x,w);
+  for (q=0;q<m;q++) {
+    for (j=0;j<n;j++) {
+      for (i=0;i<n;i++) W[i+j*ld] = x[q]*R[i+j*ld];
+      W[j+j*ld] += 1.0;
+    }
+    ierr = PetscMemcpy(T,Y,n*k*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&n,&k,W,&ld,ipiv,T,&ld,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in Lapack xGESV %d",info);
+    for (i=0;i<n*k;i++) L[i] += w[q]*T[i];
+  }
+
+  /* undo the scaling, log(A) = 2^s*log(A^(1/2^s)), and backtransform Q*L*Q' */
+  for (i=0;i<n*k;i++) L[i] *= PetscPowRealInt(2.0,s);
+  if (firstonly) {
+    PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n,&n,&one,Q,&ld,L,&ione,&zero,T,&ione));
+  } else {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","C",&n,&n,&n,&one,L,&ld,Q,&ld,&zero,W,&ld));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&one,Q,&ld,W,&ld,&zero,T,&ld));
+  }
+  PetscFunctionReturn(0);
+#endif
+}
+
+PetscErrorCode FNEvaluateFunctionMat_Log(FN fn,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+  PetscBLASInt   n;
+  PetscScalar    *T;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  if (A!=B) { ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr); }
+  ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ierr = logm_iss(fn,n,T,n,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateFunctionMatVec_Log(FN fn,Mat A,Vec v)
+{
+  PetscErrorCode ierr;
+  PetscBLASInt   n;
+  PetscScalar    *T;
+  PetscInt       m;
+  Mat            B;
+
+  PetscFunctionBegin;
+  ierr = FN_AllocateWorkMat(fn,A,&B);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ierr = logm_iss(fn,n,T,n,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetColumnVector(B,v,0);CHKERRQ(ierr);
+  ierr = FN_FreeWorkMat(fn,&B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode FNView_Log(FN fn,PetscViewer viewer)
 {
   PetscErrorCode ierr;
@@ -79,9 +295,13 @@ PetscErrorCode FNView_Log(FN fn,PetscViewer viewer)
 PETSC_EXTERN PetscErrorCode FNCreate_Log(FN fn)
 {
   PetscFunctionBegin;
-  fn->ops->evaluatefunction    = FNEvaluateFunction_Log;
-  fn->ops->evaluatederivative  = FNEvaluateDerivative_Log;
-  fn->ops->view                = FNView_Log;
+  fn->ops->evaluatefunction          = FNEvaluateFunction_Log;
+  fn->ops->evaluatederivative        = FNEvaluateDerivative_Log;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Log;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Log;
+  fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Log;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Log;
+  fn->ops->view                      = FNView_Log;
   PetscFunctionReturn(0);
 }
 
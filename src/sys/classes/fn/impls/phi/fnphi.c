@@ -25,9 +25,12 @@
 */
 
 #include <slepc/private/fnimpl.h>      /*I "slepcfn.h" I*/
+#include <slepcblaslapack.h>
 
 typedef struct {
   PetscInt k;    /* index of the phi-function, defaults to k=1 */
+  FN       fexp; /* exponential used in FNEvaluateFunctionMatVec, created on demand */
+  Mat      H,F;  /* augmented matrix and its exponential, kept between calls */
 } FN_PHI;
 
 const static PetscReal rfactorial[] = { 1, 1, 0.5, 1.0/6, 1.0/24, 1.0/120, 1.0/720, 1.0/5040, 1.0/40320, 1.0/362880 };
@@ -79,6 +82,405 @@ PetscErrorCode FNEvaluateDerivative_Phi(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(0);
 }
 
+/*
+   The array versions unroll the recursion of PhiFunction and PhiDerivative,
+   with the loop over the index j outside and the loop over the points inside
+*/
+PetscErrorCode FNEvaluateFunctionArray_Phi(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       i,j;
+  PetscScalar    *phi;
+
+  PetscFunctionBegin;
+  ierr = FNAllocateWork_Private(fn,n,0,0);CHKERRQ(ierr);
+  phi = fn->work;
+  for (i=0;i<n;i++) phi[i] = PetscExpScalar(x[i]);
+  for (j=1;j<=ctx->k;j++)
+    for (i=0;i<n;i++) phi[i] = (phi[i]-rfactorial[j-1])/x[i];
+  ierr = PetscMemcpy(y,phi,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateDerivativeArray_Phi(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       i,j;
+  PetscScalar    *phi,*der;
+
+  PetscFunctionBegin;
+  ierr = FNAllocateWork_Private(fn,2*n,0,0);CHKERRQ(ierr);
+  phi = fn->work;
+  der = phi+n;
+  for (i=0;i<n;i++) der[i] = phi[i] = PetscExpScalar(x[i]);
+  for (j=1;j<=ctx->k;j++) {
+    for (i=0;i<n;i++) {
+      phi[i] = (phi[i]-rfactorial[j-1])/x[i];
+      der[i] = (der[i]-phi[i])/x[i];
+    }
+  }
+  ierr = PetscMemcpy(y,der,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes phi_0(A),...,phi_k(A) together with a scaling and squaring method,
+   see for instance
+
+   [1] B. Skaflestad and W. M. Wright, "The scaling and modified squaring
+       method for matrix functions related to the exponential", Appl. Numer.
+       Math. 59(3-4):783-799, 2009.
+
+   With X=A/2^s such that ||X||_1<=1/2, phi_k(X) is obtained from its Taylor
+   series, and the rest with phi_{j-1}(X) = X*phi_j(X)+I/(j-1)!. Then the
+   relation phi_j(2*X) = (phi_0(X)*phi_j(X)+sum_{i=1}^j phi_i(X)/(j-i)!)/2^j
+   is applied s times to all of them. On output, phi_j(A) is stored in
+   P+j*m*m, where P points to the workspace of fn.
+ */
+static PetscErrorCode PhiMatAll_Private(FN fn,PetscScalar *Aa,PetscInt m,PetscScalar **Pout)
+{
+#if defined(SLEPC_MISSING_LAPACK_LANGE)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"LANGE - Lapack routine is unavailable");
+#else
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscBLASInt   n,ld,ld2,one=1;
+  PetscInt       i,j,l,d,s=0,k=ctx->k;
+  PetscScalar    *X,*W,*P,*Pj,sone=1.0,szero=0.0,scal;
+  PetscReal      nrm,t,c;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ld  = n;
+  ld2 = ld*ld;
+  ierr = FNAllocateWork_Private(fn,(k+3)*m*m,m,0);CHKERRQ(ierr);
+  X = fn->work;
+  W = X+m*m;
+  P = W+m*m;   /* phi_j(X) is stored in P+j*m*m */
+
+  /* scaling, X = A/2^s */
+  nrm = LAPACKlange_("O",&n,&n,Aa,&ld,fn->rwork);
+  if (nrm>0.5) s = (PetscInt)PetscCeilReal(PetscLogReal(nrm/0.5)/PetscLogReal(2.0));
+  scal = PetscPowRealInt(2.0,-s);
+  nrm *= PetscRealPart(scal);
+  for (i=0;i<m*m;i++) X[i] = scal*Aa[i];
+
+  /* degree d of the Taylor polynomial, such that the first neglected term is below eps */
+  d = 0; t = 1.0;
+  while (d<30 && t*nrm/(d+1)>PETSC_MACHINE_EPSILON) { d++; t *= nrm/d; }
+
+  /* phi_k(X) = sum_{i=0}^d X^i/(i+k)!, evaluated with Horner's rule */
+  for (c=1.0,i=1;i<=d+k;i++) c /= i;
+  Pj = P+k*m*m;
+  ierr = PetscMemzero(Pj,m*m*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (j=0;j<m;j++) Pj[j+j*ld] = c;
+  for (i=d-1;i>=0;i--) {
+    c *= i+k+1;
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,X,&ld,Pj,&ld,&szero,W,&ld));
+    ierr = PetscMemcpy(Pj,W,ld2*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (j=0;j<m;j++) Pj[j+j*ld] += c;
+  }
+
+  /* phi_{j-1}(X) = X*phi_j(X)+I/(j-1)! */
+  for (j=k;j>0;j--) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,X,&ld,P+j*m*m,&ld,&szero,P+(j-1)*m*m,&ld));
+    for (i=0;i<m;i++) P[(j-1)*m*m+i+i*ld] += rfactorial[j-1];
+  }
+
+  /* squaring, processing j in decreasing order so that the old phi_i(X), i<=j, are still available */
+  for (l=0;l<s;l++) {
+    for (j=k;j>=0;j--) {
+      Pj = P+j*m*m;
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&sone,P,&ld,Pj,&ld,&szero,W,&ld));
+      for (i=1;i<=j;i++) {
+        scal = rfactorial[j-i];
+        PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&ld2,&scal,P+i*m*m,&one,W,&one));
+      }
+      scal = PetscPowRealInt(2.0,-j);
+      for (i=0;i<m*m;i++) Pj[i] = scal*W[i];
+    }
+  }
+  ierr = PetscLogFlops(2.0*n*n*n*(d+k+s*(k+1)));CHKERRQ(ierr);
+  *Pout = P;
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+   Only phi_k(A) is returned in B, see FNPhiEvaluateFunctionMatAll() to get
+   all the phi_j(A), j=0,...,k, computed along the way
+ */
+PetscErrorCode FNEvaluateFunctionMat_Phi(FN fn,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       m;
+  PetscScalar    *Aa,*Ba,*P;
+
+  PetscFunctionBegin;
+  ierr = MatDenseGetArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(B,&Ba);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PhiMatAll_Private(fn,Aa,m,&P);CHKERRQ(ierr);
+  ierr = PetscMemcpy(Ba,P+ctx->k*m*m,m*m*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&Ba);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes exp(Ahat), where
+
+            [ A  e_1  0 ]
+     Ahat = [ 0   0   I ]
+            [ 0   0   0 ]
+
+   is the augmented matrix of order n+k, see
+
+   [2] R. B. Sidje, "Expokit: a software package for computing matrix
+       exponentials", ACM Trans. Math. Softw. 24(1):130-156, 1998.
+
+   The top part of the first column of the result is exp(A)*e_1, and the top
+   part of column n+j-1 is phi_j(A)*e_1, j=1,...,k. The result is returned
+   in ctx->F, which is kept together with ctx->H for subsequent calls.
+ */
+static PetscErrorCode PhiAugmentedExp_Private(FN fn,Mat A,Mat *F)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       i,j,m,m1,n1,k=ctx->k;
+  PetscScalar    *Aa,*Ha;
+
+  PetscFunctionBegin;
+  if (!ctx->fexp) {
+    ierr = FNCreate(PetscObjectComm((PetscObject)fn),&ctx->fexp);CHKERRQ(ierr);
+    ierr = FNSetType(ctx->fexp,FNEXP);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)fn,(PetscObject)ctx->fexp);CHKERRQ(ierr);
+  }
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  m1 = m+k;
+  if (ctx->H) {
+    ierr = MatGetSize(ctx->H,&n1,NULL);CHKERRQ(ierr);
+    if (n1!=m1) {
+      ierr = MatDestroy(&ctx->H);CHKERRQ(ierr);
+      ierr = MatDestroy(&ctx->F);CHKERRQ(ierr);
+    }
+  }
+  if (!ctx->H) {
+    ierr = PetscLogEventBegin(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
+    ierr = MatCreateSeqDense(PETSC_COMM_SELF,m1,m1,NULL,&ctx->H);CHKERRQ(ierr);
+    ierr = MatCreateSeqDense(PETSC_COMM_SELF,m1,m1,NULL,&ctx->F);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)fn,(PetscObject)ctx->H);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)fn,(PetscObject)ctx->F);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = MatDenseGetArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(ctx->H,&Ha);CHKERRQ(ierr);
+  ierr = PetscMemzero(Ha,m1*m1*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (j=0;j<m;j++) {
+    for (i=0;i<m;i++) Ha[i+j*m1] = Aa[i+j*m];
+  }
+  if (k) Ha[m*m1] = 1.0;
+  for (i=m;i<m1-1;i++) Ha[i+(i+1)*m1] = 1.0;
+  ierr = MatDenseRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(ctx->H,&Ha);CHKERRQ(ierr);
+
+  ierr = FNEvaluateFunctionMat(ctx->fexp,ctx->H,ctx->F);CHKERRQ(ierr);
+  *F = ctx->F;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes phi_k(A)*e_1 from the last column of the augmented exponential
+ */
+PetscErrorCode FNEvaluateFunctionMatVec_Phi(FN fn,Mat A,Vec v)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       i,j,m,k=ctx->k;
+  PetscScalar    *Fa,*va;
+  Mat            F;
+
+  PetscFunctionBegin;
+  ierr = PhiAugmentedExp_Private(fn,A,&F);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(F,&Fa);CHKERRQ(ierr);
+  ierr = VecGetArray(v,&va);CHKERRQ(ierr);
+  j = k? m+k-1: 0;
+  for (i=0;i<m;i++) va[i] = Fa[i+j*(m+k)];
+  ierr = VecRestoreArray(v,&va);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(F,&Fa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FNPhiEvaluateFunctionMatAll_Phi(FN fn,Mat A,Mat *B)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       j,m;
+  PetscScalar    *Ma,*Ba,*P;
+  Mat            M;
+
+  PetscFunctionBegin;
+  if (fn->alpha!=(PetscScalar)1.0) {
+    ierr = FN_AllocateWorkMat(fn,A,&M);CHKERRQ(ierr);
+    ierr = MatScale(M,fn->alpha);CHKERRQ(ierr);
+  } else M = A;
+  ierr = PetscLogEventBegin(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(M,&Ma);CHKERRQ(ierr);
+  ierr = PhiMatAll_Private(fn,Ma,m,&P);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(M,&Ma);CHKERRQ(ierr);
+  for (j=0;j<=ctx->k;j++) {
+    ierr = MatDenseGetArray(B[j],&Ba);CHKERRQ(ierr);
+    ierr = PetscMemcpy(Ba,P+j*m*m,m*m*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = MatDenseRestoreArray(B[j],&Ba);CHKERRQ(ierr);
+    ierr = MatScale(B[j],fn->beta);CHKERRQ(ierr);
+  }
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  if (fn->alpha!=(PetscScalar)1.0) {
+    ierr = FN_FreeWorkMat(fn,&M);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   FNPhiEvaluateFunctionMatAll - Computes the matrix phi-functions of all
+   indices up to the one of fn, B[j]=phi_j(A) for j=0,...,k.
+
+   Logically Collective on FN
+
+   Input Parameters:
++  fn - the math function context
+-  A  - matrix on which the functions must be evaluated
+
+   Output Parameter:
+.  B  - array of k+1 matrices where the results are placed
+
+   Notes:
+   The index k is the one set with FNPhiSetIndex(). All phi_j(A) are obtained
+   in the same scaling and squaring process used by FNEvaluateFunctionMat()
+   to compute phi_k(A), so the cost is that of a single evaluation. The
+   scaling factors of fn are applied to all functions.
+
+   A must be a square matrix of type MATSEQDENSE, and the matrices B[j] must
+   be of the same type and dimension, and different from A.
+
+   Level: advanced
+
+.seealso: FNPhiEvaluateFunctionMatVecAll(), FNPhiSetIndex(), FNEvaluateFunctionMat()
+@*/
+PetscErrorCode FNPhiEvaluateFunctionMatAll(FN fn,Mat A,Mat *B)
+{
+  PetscErrorCode ierr;
+  PetscInt       j,k,m,n;
+  PetscBool      match;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidHeaderSpecific(A,MAT_CLASSID,2);
+  PetscValidPointer(B,3);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQDENSE,&match);CHKERRQ(ierr);
+  if (!match) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"Mat A must be of type seqdense");
+  ierr = MatGetSize(A,&m,&n);CHKERRQ(ierr);
+  if (m!=n) SETERRQ2(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_SIZ,"Mat A is not square (has %D rows, %D cols)",m,n);
+  ierr = FNPhiGetIndex(fn,&k);CHKERRQ(ierr);
+  for (j=0;j<=k;j++) {
+    PetscValidHeaderSpecific(B[j],MAT_CLASSID,3);
+    if (B[j]==A) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_IDN,"The result matrices must be different from A");
+    ierr = PetscObjectTypeCompare((PetscObject)B[j],MATSEQDENSE,&match);CHKERRQ(ierr);
+    if (!match) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"The result matrices must be of type seqdense");
+    ierr = MatGetSize(B[j],&m,NULL);CHKERRQ(ierr);
+    if (m!=n) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_SIZ,"Matrices A and B[j] must have the same dimension");
+  }
+  ierr = PetscUseMethod(fn,"FNPhiEvaluateFunctionMatAll_C",(FN,Mat,Mat*),(fn,A,B));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FNPhiEvaluateFunctionMatVecAll_Phi(FN fn,Mat A,Vec *v)
+{
+  PetscErrorCode ierr;
+  FN_PHI         *ctx = (FN_PHI*)fn->data;
+  PetscInt       i,j,c,m,k=ctx->k;
+  PetscScalar    *Fa,*va;
+  Mat            M,F;
+
+  PetscFunctionBegin;
+  if (fn->alpha!=(PetscScalar)1.0) {
+    ierr = FN_AllocateWorkMat(fn,A,&M);CHKERRQ(ierr);
+    ierr = MatScale(M,fn->alpha);CHKERRQ(ierr);
+  } else M = A;
+  ierr = PetscLogEventBegin(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  ierr = PhiAugmentedExp_Private(fn,M,&F);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(F,&Fa);CHKERRQ(ierr);
+  for (j=0;j<=k;j++) {
+    c = j? m+j-1: 0;
+    ierr = VecGetArray(v[j],&va);CHKERRQ(ierr);
+    for (i=0;i<m;i++) va[i] = Fa[i+c*(m+k)];
+    ierr = VecRestoreArray(v[j],&va);CHKERRQ(ierr);
+    ierr = VecScale(v[j],fn->beta);CHKERRQ(ierr);
+  }
+  ierr = MatDenseRestoreArray(F,&Fa);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  if (fn->alpha!=(PetscScalar)1.0) {
+    ierr = FN_FreeWorkMat(fn,&M);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   FNPhiEvaluateFunctionMatVecAll - Computes the first column of the matrix
+   phi-functions of all indices up to the one of fn, v[j]=phi_j(A)*e_1 for
+   j=0,...,k.
+
+   Logically Collective on FN
+
+   Input Parameters:
++  fn - the math function context
+-  A  - matrix on which the functions must be evaluated
+
+   Output Parameter:
+.  v  - array of k+1 vectors where the results are placed
+
+   Notes:
+   All vectors are extracted from the exponential of a single augmented
+   matrix of order n+k, the same one used by FNEvaluateFunctionMatVec() to
+   compute phi_k(A)*e_1, so this is as expensive as one evaluation.
+
+   Level: advanced
+
+.seealso: FNPhiEvaluateFunctionMatAll(), FNPhiSetIndex(), FNEvaluateFunctionMatVec()
+@*/
+PetscErrorCode FNPhiEvaluateFunctionMatVecAll(FN fn,Mat A,Vec *v)
+{
+  PetscErrorCode ierr;
+  PetscInt       j,k,m,n;
+  PetscBool      match;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidHeaderSpecific(A,MAT_CLASSID,2);
+  PetscValidPointer(v,3);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQDENSE,&match);CHKERRQ(ierr);
+  if (!match) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"Mat A must be of type seqdense");
+  ierr = MatGetSize(A,&m,&n);CHKERRQ(ierr);
+  if (m!=n) SETERRQ2(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_SIZ,"Mat A is not square (has %D rows, %D cols)",m,n);
+  ierr = FNPhiGetIndex(fn,&k);CHKERRQ(ierr);
+  for (j=0;j<=k;j++) {
+    PetscValidHeaderSpecific(v[j],VEC_CLASSID,3);
+    ierr = VecGetSize(v[j],&m);CHKERRQ(ierr);
+    if (m!=n) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_SIZ,"Matrix A and vectors v[j] must have the same size");
+  }
+  ierr = PetscUseMethod(fn,"FNPhiEvaluateFunctionMatVecAll_C",(FN,Mat,Vec*),(fn,A,v));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode FNPhiSetIndex_Phi(FN fn,PetscInt k)
 {
   FN_PHI *ctx = (FN_PHI*)fn->data;
@@ -222,9 +624,14 @@ PetscErrorCode FNDestroy_Phi(FN fn)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = FNDestroy(&((FN_PHI*)fn->data)->fexp);CHKERRQ(ierr);
+  ierr = MatDestroy(&((FN_PHI*)fn->data)->H);CHKERRQ(ierr);
+  ierr = MatDestroy(&((FN_PHI*)fn->data)->F);CHKERRQ(ierr);
   ierr = PetscFree(fn->data);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiSetIndex_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiGetIndex_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiEvaluateFunctionMatAll_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiEvaluateFunctionMatVecAll_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -238,14 +645,20 @@ PETSC_EXTERN PetscErrorCode FNCreate_Phi(FN fn)
   fn->data = (void*)ctx;
   ctx->k   = 1;
 
-  fn->ops->evaluatefunction    = FNEvaluateFunction_Phi;
-  fn->ops->evaluatederivative  = FNEvaluateDerivative_Phi;
-  fn->ops->setfromoptions      = FNSetFromOptions_Phi;
-  fn->ops->view                = FNView_Phi;
-  fn->ops->duplicate           = FNDuplicate_Phi;
-  fn->ops->destroy             = FNDestroy_Phi;
+  fn->ops->evaluatefunction          = FNEvaluateFunction_Phi;
+  fn->ops->evaluatederivative        = FNEvaluateDerivative_Phi;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Phi;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Phi;
+  fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Phi;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Phi;
+  fn->ops->setfromoptions            = FNSetFromOptions_Phi;
+  fn->ops->view                      = FNView_Phi;
+  fn->ops->duplicate                 = FNDuplicate_Phi;
+  fn->ops->destroy                   = FNDestroy_Phi;
   ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiSetIndex_C",FNPhiSetIndex_Phi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiGetIndex_C",FNPhiGetIndex_Phi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiEvaluateFunctionMatAll_C",FNPhiEvaluateFunctionMatAll_Phi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)fn,"FNPhiEvaluateFunctionMatVecAll_C",FNPhiEvaluateFunctionMatVecAll_Phi);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -71,12 +71,11 @@ static PetscErrorCode FNEvaluateFunctionMat_Private(FN fn,PetscScalar *Aa,PetscS
   ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
   ld = n;
   k  = firstonly? 1: n;
-  if (Aa==Ba) {
-    ierr = PetscMalloc4(m*m,&P,m*m,&Q,m*m,&W,ld,&ipiv);CHKERRQ(ierr);
-  } else {
-    P = Ba;
-    ierr = PetscMalloc3(m*m,&Q,m*m,&W,ld,&ipiv);CHKERRQ(ierr);
-  }
+  ierr = FNAllocateWork_Private(fn,3*m*m,0,m);CHKERRQ(ierr);
+  Q    = fn->work;
+  W    = Q+m*m;
+  P    = (Aa==Ba)? W+m*m: Ba;
+  ipiv = fn->iwork;
   ierr = PetscMemzero(P,m*m*sizeof(PetscScalar));CHKERRQ(ierr);
   if (!ctx->np) {
     for (i=0;i<m;i++) P[i+i*ld] = 1.0;
@@ -101,9 +100,6 @@ static PetscErrorCode FNEvaluateFunctionMat_Private(FN fn,PetscScalar *Aa,PetscS
   }
   if (Aa==Ba) {
     ierr = PetscMemcpy(Aa,P,m*k*sizeof(PetscScalar));CHKERRQ(ierr);
-    ierr = PetscFree4(P,Q,W,ipiv);CHKERRQ(ierr);
-  } else {
-    ierr = PetscFree3(Q,W,ipiv);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 #endif
@@ -177,6 +173,80 @@ PetscErrorCode FNEvaluateDerivative_Rational(FN fn,PetscScalar x,PetscScalar *yp
   PetscFunctionReturn(0);
 }
 
+/*
+   Horner's rule applied to all points simultaneously, so that the inner loop
+   runs over the points and can be vectorized
+*/
+PetscErrorCode FNEvaluateFunctionArray_Rational(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscErrorCode ierr;
+  FN_RATIONAL    *ctx = (FN_RATIONAL*)fn->data;
+  PetscInt       i,j;
+  PetscScalar    *p,*q;
+
+  PetscFunctionBegin;
+  ierr = FNAllocateWork_Private(fn,2*n,0,0);CHKERRQ(ierr);
+  p = fn->work;
+  q = p+n;
+  if (!ctx->np) {
+    for (i=0;i<n;i++) p[i] = 1.0;
+  } else {
+    for (i=0;i<n;i++) p[i] = ctx->pcoeff[0];
+    for (j=1;j<ctx->np;j++)
+      for (i=0;i<n;i++) p[i] = ctx->pcoeff[j]+x[i]*p[i];
+  }
+  if (!ctx->nq) {
+    ierr = PetscMemcpy(y,p,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  } else {
+    for (i=0;i<n;i++) q[i] = ctx->qcoeff[0];
+    for (j=1;j<ctx->nq;j++)
+      for (i=0;i<n;i++) q[i] = ctx->qcoeff[j]+x[i]*q[i];
+    for (i=0;i<n;i++) if (q[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Function not defined in the requested value");
+    for (i=0;i<n;i++) y[i] = p[i]/q[i];
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateDerivativeArray_Rational(FN fn,PetscInt n,PetscScalar *x,PetscScalar *yp)
+{
+  PetscErrorCode ierr;
+  FN_RATIONAL    *ctx = (FN_RATIONAL*)fn->data;
+  PetscInt       i,j;
+  PetscScalar    *p,*q,*pp,*qp;
+
+  PetscFunctionBegin;
+  ierr = FNAllocateWork_Private(fn,4*n,0,0);CHKERRQ(ierr);
+  p  = fn->work;
+  pp = p+n;
+  q  = pp+n;
+  qp = q+n;
+  if (!ctx->np) {
+    for (i=0;i<n;i++) { p[i] = 1.0; pp[i] = 0.0; }
+  } else {
+    for (i=0;i<n;i++) { p[i] = ctx->pcoeff[0]; pp[i] = 0.0; }
+    for (j=1;j<ctx->np;j++) {
+      for (i=0;i<n;i++) {
+        pp[i] = p[i]+x[i]*pp[i];
+        p[i] = ctx->pcoeff[j]+x[i]*p[i];
+      }
+    }
+  }
+  if (!ctx->nq) {
+    ierr = PetscMemcpy(yp,pp,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  } else {
+    for (i=0;i<n;i++) { q[i] = ctx->qcoeff[0]; qp[i] = 0.0; }
+    for (j=1;j<ctx->nq;j++) {
+      for (i=0;i<n;i++) {
+        qp[i] = q[i]+x[i]*qp[i];
+        q[i] = ctx->qcoeff[j]+x[i]*q[i];
+      }
+    }
+    for (i=0;i<n;i++) if (q[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+    for (i=0;i<n;i++) yp[i] = (pp[i]*q[i]-p[i]*qp[i])/(q[i]*q[i]);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode FNView_Rational(FN fn,PetscViewer viewer)
 {
   PetscErrorCode ierr;
@@ -526,8 +596,10 @@ PETSC_EXTERN PetscErrorCode FNCreate_Rational(FN fn)
 
   fn->ops->evaluatefunction       = FNEvaluateFunction_Rational;
   fn->ops->evaluatederivative     = FNEvaluateDerivative_Rational;
-  fn->ops->evaluatefunctionmat    = FNEvaluateFunctionMat_Rational;
-  fn->ops->evaluatefunctionmatvec = FNEvaluateFunctionMatVec_Rational;
+  fn->ops->evaluatefunctionarray  = FNEvaluateFunctionArray_Rational;
+  fn->ops->evaluatederivativearray = FNEvaluateDerivativeArray_Rational;
+  fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Rational;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Rational;
   fn->ops->setfromoptions         = FNSetFromOptions_Rational;
   fn->ops->view                   = FNView_Rational;
   fn->ops->duplicate              = FNDuplicate_Rational;
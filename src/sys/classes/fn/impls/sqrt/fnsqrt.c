@@ -44,7 +44,34 @@ PetscErrorCode FNEvaluateDerivative_Sqrt(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode FNEvaluateFunctionMat_Sqrt(FN fn,Mat A,Mat B)
+PetscErrorCode FNEvaluateFunctionArray_Sqrt(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) if (x[i]<0.0) SETERRQ(PETSC_COMM_SELF,1,"Function not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = PetscSqrtScalar(x[i]);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateDerivativeArray_Sqrt(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    if (x[i]==0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+    if (x[i]<0.0) SETERRQ(PETSC_COMM_SELF,1,"Derivative not defined in the requested value");
+#endif
+  }
+  for (i=0;i<n;i++) y[i] = 1.0/(2.0*PetscSqrtScalar(x[i]));
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateFunctionMat_Sqrt_Schur(FN fn,Mat A,Mat B)
 {
   PetscErrorCode ierr;
   PetscBLASInt   n;
@@ -56,12 +83,12 @@ PetscErrorCode FNEvaluateFunctionMat_Sqrt(FN fn,Mat A,Mat B)
   ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
   ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
-  ierr = SlepcSchurParlettSqrt(n,T,n,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = SlepcSchurParlettSqrt(fn,n,T,n,PETSC_FALSE);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode FNEvaluateFunctionMatVec_Sqrt(FN fn,Mat A,Vec v)
+PetscErrorCode FNEvaluateFunctionMatVec_Sqrt_Schur(FN fn,Mat A,Vec v)
 {
   PetscErrorCode ierr;
   PetscBLASInt   n;
@@ -74,18 +101,58 @@ PetscErrorCode FNEvaluateFunctionMatVec_Sqrt(FN fn,Mat A,Vec v)
   ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
   ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
   ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
-  ierr = SlepcSchurParlettSqrt(n,T,n,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = SlepcSchurParlettSqrt(fn,n,T,n,PETSC_TRUE);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
   ierr = MatGetColumnVector(B,v,0);CHKERRQ(ierr);
   ierr = FN_FreeWorkMat(fn,&B);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode FNEvaluateFunctionMat_Sqrt_DBP(FN fn,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+  PetscBLASInt   n;
+  PetscScalar    *T;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  if (A!=B) { ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr); }
+  ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ierr = SlepcSqrtmDenmanBeavers(fn,n,T,n,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode FNEvaluateFunctionMat_Sqrt_NS(FN fn,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+  PetscBLASInt   n;
+  PetscScalar    *T;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  if (A!=B) { ierr = MatCopy(A,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr); }
+  ierr = MatDenseGetArray(B,&T);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&n);CHKERRQ(ierr);
+  ierr = SlepcSqrtmNewtonSchulz(fn,n,T,n,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(B,&T);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode FNView_Sqrt(FN fn,PetscViewer viewer)
 {
   PetscErrorCode ierr;
   PetscBool      isascii;
   char           str[50];
+  const char     *methodname[] = {
+                  "Schur method for the square root",
+                  "Denman-Beavers (product form)",
+                  "Newton-Schulz iteration"
+  };
+  const int      nmeth=sizeof(methodname)/sizeof(methodname[0]);
 
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
@@ -109,6 +176,9 @@ PetscErrorCode FNView_Sqrt(FN fn,PetscViewer viewer)
         ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
       }
     }
+    if (fn->method<nmeth) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  computing matrix functions with: %s\n",methodname[fn->method]);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -116,11 +186,15 @@ PetscErrorCode FNView_Sqrt(FN fn,PetscViewer viewer)
 PETSC_EXTERN PetscErrorCode FNCreate_Sqrt(FN fn)
 {
   PetscFunctionBegin;
-  fn->ops->evaluatefunction       = FNEvaluateFunction_Sqrt;
-  fn->ops->evaluatederivative     = FNEvaluateDerivative_Sqrt;
-  fn->ops->evaluatefunctionmat    = FNEvaluateFunctionMat_Sqrt;
-  fn->ops->evaluatefunctionmatvec = FNEvaluateFunctionMatVec_Sqrt;
-  fn->ops->view                   = FNView_Sqrt;
+  fn->ops->evaluatefunction          = FNEvaluateFunction_Sqrt;
+  fn->ops->evaluatederivative        = FNEvaluateDerivative_Sqrt;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Sqrt;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Sqrt;
+  fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Sqrt_Schur;
+  fn->ops->evaluatefunctionmat[1]    = FNEvaluateFunctionMat_Sqrt_DBP;
+  fn->ops->evaluatefunctionmat[2]    = FNEvaluateFunctionMat_Sqrt_NS;
+  fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Sqrt_Schur;
+  fn->ops->view                      = FNView_Sqrt;
   PetscFunctionReturn(0);
 }
 
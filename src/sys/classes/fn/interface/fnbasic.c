@@ -27,7 +27,7 @@
 PetscFunctionList FNList = 0;
 PetscBool         FNRegisterAllCalled = PETSC_FALSE;
 PetscClassId      FN_CLASSID = 0;
-PetscLogEvent     FN_Evaluate = 0;
+PetscLogEvent     FN_Evaluate = 0,FN_AllocateWork = 0;
 static PetscBool  FNPackageInitialized = PETSC_FALSE;
 
 /*@C
@@ -74,6 +74,8 @@ PetscErrorCode FNInitializePackage(void)
   ierr = FNRegisterAll();CHKERRQ(ierr);
   /* Register Events */
   ierr = PetscLogEventRegister("FNEvaluate",FN_CLASSID,&FN_Evaluate);CHKERRQ(ierr);
+  /* logged only when the workspace of an FN grows, so -log_view reports the number of reallocations */
+  ierr = PetscLogEventRegister("FNAllocateWork",FN_CLASSID,&FN_AllocateWork);CHKERRQ(ierr);
   /* Process info exclusions */
   ierr = PetscOptionsGetString(NULL,NULL,"-info_exclude",logList,256,&opt);CHKERRQ(ierr);
   if (opt) {
@@ -122,9 +124,19 @@ PetscErrorCode FNCreate(MPI_Comm comm,FN *newfn)
 
   fn->alpha    = 1.0;
   fn->beta     = 1.0;
+  fn->method   = 0;
 
   fn->nw       = 0;
   fn->cw       = 0;
+  fn->work     = NULL;
+  fn->rwork    = NULL;
+  fn->iwork    = NULL;
+  fn->lwork    = 0;
+  fn->lrwork   = 0;
+  fn->liwork   = 0;
+  fn->schur    = NULL;
+  fn->argid    = 0;
+  fn->argstate = 0;
   fn->data     = NULL;
 
   *newfn = fn;
@@ -343,6 +355,148 @@ PetscErrorCode FNGetScale(FN fn,PetscScalar *alpha,PetscScalar *beta)
   PetscFunctionReturn(0);
 }
 
+/*@
+   FNSetMethod - Selects the method to be used to evaluate functions of matrices.
+
+   Logically Collective on FN
+
+   Input Parameter:
++  fn   - the math function context
+-  meth - an index indentifying the method
+
+   Options Database Key:
+.  -fn_method <meth> - Sets the method
+
+   Notes:
+   In some FN types there are more than one algorithms available for computing
+   matrix functions. In that case, this function allows choosing the wanted method.
+
+   If meth is currently set to 0 (the default) and the input argument A of
+   FNEvaluateFunctionMat() is a symmetric/Hermitian matrix, then the computation
+   is done via the eigendecomposition of A, rather than with the general algorithm.
+
+   Level: intermediate
+
+.seealso: FNGetMethod(), FNEvaluateFunctionMat()
+@*/
+PetscErrorCode FNSetMethod(FN fn,PetscInt meth)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidLogicalCollectiveInt(fn,meth,2);
+  if (meth<0) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_OUTOFRANGE,"The method must be a non-negative integer");
+  if (meth>=FN_MAX_SOLVE) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_OUTOFRANGE,"Too large value for the method");
+  fn->method = meth;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   FNGetMethod - Gets the method currently used in the FN.
+
+   Not Collective
+
+   Input Parameter:
+.  fn - the math function context
+
+   Output Parameter:
+.  meth - identifier of the method
+
+   Level: intermediate
+
+.seealso: FNSetMethod()
+@*/
+PetscErrorCode FNGetMethod(FN fn,PetscInt *meth)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidPointer(meth,2);
+  *meth = fn->method;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FNSchurCacheDestroy_Private(FN_SCHUR **sc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*sc) PetscFunctionReturn(0);
+  ierr = PetscFree4((*sc)->T,(*sc)->Q,(*sc)->wr,(*sc)->wi);CHKERRQ(ierr);
+  ierr = PetscFree(*sc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   FNSetSchurCache - Activates or deactivates the cache of the Schur decomposition
+   of the matrix argument.
+
+   Logically Collective on FN
+
+   Input Parameters:
++  fn  - the math function context
+-  flg - whether the Schur decomposition must be kept
+
+   Options Database Key:
+.  -fn_schur_cache <boolean> - Activates/deactivates the cache
+
+   Notes:
+   Some methods for matrix functions start by computing the Schur decomposition
+   of the argument, e.g., the default methods of FNSQRT, FNINVSQRT and FNLOG. With
+   the cache active, this decomposition is kept and reused in subsequent calls to
+   FNEvaluateFunctionMat() or FNEvaluateFunctionMatVec() as long as the argument
+   is the same Mat object and it has not been modified. The scaling factor alpha
+   set with FNSetScale() may differ between calls.
+
+   In a function of type FNCOMBINE, the cache is shared with the child functions
+   that do not have their own cache, so that for instance f(A)=g(A)*h(A) requires
+   a single Schur decomposition of A. See also FNEvaluateFunctionMatMultiple().
+
+   The cache is not active by default, since it stores two matrices of the same
+   size as the argument.
+
+   Level: advanced
+
+.seealso: FNGetSchurCache(), FNEvaluateFunctionMat(), FNEvaluateFunctionMatMultiple()
+@*/
+PetscErrorCode FNSetSchurCache(FN fn,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidLogicalCollectiveBool(fn,flg,2);
+  if (flg && !fn->schur) {
+    ierr = PetscNewLog(fn,&fn->schur);CHKERRQ(ierr);
+  } else if (!flg) {
+    ierr = FNSchurCacheDestroy_Private(&fn->schur);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   FNGetSchurCache - Returns the flag indicating whether the Schur decomposition
+   of the matrix argument is kept.
+
+   Not Collective
+
+   Input Parameter:
+.  fn - the math function context
+
+   Output Parameter:
+.  flg - the flag
+
+   Level: advanced
+
+.seealso: FNSetSchurCache()
+@*/
+PetscErrorCode FNGetSchurCache(FN fn,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidPointer(flg,2);
+  *flg = fn->schur? PETSC_TRUE: PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
 /*@
    FNEvaluateFunction - Computes the value of the function f(x) for a given x.
 
@@ -419,6 +573,145 @@ PetscErrorCode FNEvaluateDerivative(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(0);
 }
 
+/*@
+   FNEvaluateFunctionArray - Computes the value of the function f(x) for each
+   of the n values in an array.
+
+   Logically Collective on FN
+
+   Input Parameters:
++  fn - the math function context
+.  n  - the number of values
+-  x  - array of length n with the values where the function must be evaluated
+
+   Output Parameter:
+.  y  - array of length n with the results f(x[i])
+
+   Notes:
+   Scaling factors are taken into account, so the actual function evaluation
+   will return beta*f(alpha*x[i]).
+
+   This is equivalent to calling FNEvaluateFunction() n times, but the overhead
+   of the call is paid only once and the function types may evaluate the whole
+   array with a single loop, which is faster when many points are sampled.
+   The arrays x and y may be the same, in which case x is overwritten.
+
+   Level: intermediate
+
+.seealso: FNEvaluateFunction(), FNEvaluateDerivativeArray()
+@*/
+PetscErrorCode FNEvaluateFunctionArray(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidLogicalCollectiveInt(fn,n,2);
+  PetscValidType(fn,1);
+  if (n<0) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_OUTOFRANGE,"Argument n cannot be negative");
+  if (!n) PetscFunctionReturn(0);
+  PetscValidScalarPointer(x,3);
+  PetscValidScalarPointer(y,4);
+  ierr = PetscLogEventBegin(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  for (i=0;i<n;i++) y[i] = fn->alpha*x[i];
+  if (fn->ops->evaluatefunctionarray) {
+    ierr = (*fn->ops->evaluatefunctionarray)(fn,n,y,y);CHKERRQ(ierr);
+  } else {
+    for (i=0;i<n;i++) {
+      ierr = (*fn->ops->evaluatefunction)(fn,y[i],y+i);CHKERRQ(ierr);
+    }
+  }
+  for (i=0;i<n;i++) y[i] *= fn->beta;
+  ierr = PetscLogEventEnd(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   FNEvaluateDerivativeArray - Computes the value of the derivative f'(x) for
+   each of the n values in an array.
+
+   Logically Collective on FN
+
+   Input Parameters:
++  fn - the math function context
+.  n  - the number of values
+-  x  - array of length n with the values where the derivative must be evaluated
+
+   Output Parameter:
+.  y  - array of length n with the results f'(x[i])
+
+   Notes:
+   Scaling factors are taken into account, so the actual derivative evaluation
+   will return alpha*beta*f'(alpha*x[i]).
+
+   The arrays x and y may be the same, in which case x is overwritten.
+
+   Level: intermediate
+
+.seealso: FNEvaluateDerivative(), FNEvaluateFunctionArray()
+@*/
+PetscErrorCode FNEvaluateDerivativeArray(FN fn,PetscInt n,PetscScalar *x,PetscScalar *y)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidLogicalCollectiveInt(fn,n,2);
+  PetscValidType(fn,1);
+  if (n<0) SETERRQ(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_OUTOFRANGE,"Argument n cannot be negative");
+  if (!n) PetscFunctionReturn(0);
+  PetscValidScalarPointer(x,3);
+  PetscValidScalarPointer(y,4);
+  ierr = PetscLogEventBegin(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  for (i=0;i<n;i++) y[i] = fn->alpha*x[i];
+  if (fn->ops->evaluatederivativearray) {
+    ierr = (*fn->ops->evaluatederivativearray)(fn,n,y,y);CHKERRQ(ierr);
+  } else {
+    for (i=0;i<n;i++) {
+      ierr = (*fn->ops->evaluatederivative)(fn,y[i],y+i);CHKERRQ(ierr);
+    }
+  }
+  for (i=0;i<n;i++) y[i] *= fn->alpha*fn->beta;
+  ierr = PetscLogEventEnd(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   FNAllocateWork_Private - Makes sure the workspace arrays of FN have at least the
+   requested size. The arrays only grow, so they are reused in subsequent evaluations
+   of matrix functions of the same or smaller size.
+*/
+PetscErrorCode FNAllocateWork_Private(FN fn,PetscInt s,PetscInt r,PetscInt i)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s<=fn->lwork && r<=fn->lrwork && i<=fn->liwork) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
+  if (s>fn->lwork) {
+    ierr = PetscFree(fn->work);CHKERRQ(ierr);
+    ierr = PetscMalloc1(s,&fn->work);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)fn,(s-fn->lwork)*sizeof(PetscScalar));CHKERRQ(ierr);
+    fn->lwork = s;
+  }
+  if (r>fn->lrwork) {
+    ierr = PetscFree(fn->rwork);CHKERRQ(ierr);
+    ierr = PetscMalloc1(r,&fn->rwork);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)fn,(r-fn->lrwork)*sizeof(PetscReal));CHKERRQ(ierr);
+    fn->lrwork = r;
+  }
+  if (i>fn->liwork) {
+    ierr = PetscFree(fn->iwork);CHKERRQ(ierr);
+    ierr = PetscMalloc1(i,&fn->iwork);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)fn,(i-fn->liwork)*sizeof(PetscBLASInt));CHKERRQ(ierr);
+    fn->liwork = i;
+  }
+  ierr = PetscLogEventEnd(FN_AllocateWork,fn,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode FNEvaluateFunctionMat_Sym_Private(FN fn,PetscScalar *As,PetscScalar *Bs,PetscInt m,PetscBool firstonly)
 {
 #if defined(PETSC_MISSING_LAPACK_SYEV) || defined(SLEPC_MISSING_LAPACK_LACPY)
@@ -444,12 +737,17 @@ static PetscErrorCode FNEvaluateFunctionMat_Sym_Private(FN fn,PetscScalar *As,Pe
 #if defined(PETSC_USE_COMPLEX)
   PetscStackCallBLAS("LAPACKsyev",LAPACKsyev_("V","L",&n,As,&ld,&dummy,&a,&lwork,&rdummy,&info));
   ierr = PetscBLASIntCast((PetscInt)PetscRealPart(a),&lwork);CHKERRQ(ierr);
-  ierr = PetscMalloc5(m,&eig,m*m,&Q,m*k,&W,lwork,&work,PetscMax(1,3*m-2),&rwork);CHKERRQ(ierr);
+  ierr = FNAllocateWork_Private(fn,m*m+m*k+lwork,m+PetscMax(1,3*m-2),0);CHKERRQ(ierr);
+  rwork = fn->rwork+m;
 #else
   PetscStackCallBLAS("LAPACKsyev",LAPACKsyev_("V","L",&n,As,&ld,&dummy,&a,&lwork,&info));
   ierr = PetscBLASIntCast((PetscInt)PetscRealPart(a),&lwork);CHKERRQ(ierr);
-  ierr = PetscMalloc4(m,&eig,m*m,&Q,m*k,&W,lwork,&work);CHKERRQ(ierr);
+  ierr = FNAllocateWork_Private(fn,m*m+m*k+lwork,m,0);CHKERRQ(ierr);
 #endif
+  eig  = fn->rwork;
+  Q    = fn->work;
+  W    = Q+m*m;
+  work = W+m*k;
 
   /* compute eigendecomposition */
   PetscStackCallBLAS("LAPACKlacpy",LAPACKlacpy_("L",&n,&n,As,&ld,Q,&ld));
@@ -468,11 +766,6 @@ static PetscErrorCode FNEvaluateFunctionMat_Sym_Private(FN fn,PetscScalar *As,Pe
   }
   /* Bs = Q*W */
   PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&k,&n,&one,Q,&ld,W,&ld,&zero,Bs,&ld));
-#if defined(PETSC_USE_COMPLEX)
-  ierr = PetscFree5(eig,Q,W,work,rwork);CHKERRQ(ierr);
-#else
-  ierr = PetscFree4(eig,Q,W,work);CHKERRQ(ierr);
-#endif
   PetscFunctionReturn(0);
 #endif
 }
@@ -562,6 +855,10 @@ PetscErrorCode FNEvaluateFunctionMat(FN fn,Mat A,Mat B)
   ierr = MatIsHermitianKnown(A,&set,&flg);CHKERRQ(ierr);
   symm = set? flg: PETSC_FALSE;
 
+  /* identify the argument for the Schur cache */
+  ierr = PetscObjectGetId((PetscObject)A,&fn->argid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)A,&fn->argstate);CHKERRQ(ierr);
+
   /* scale argument */
   if (fn->alpha!=(PetscScalar)1.0) {
     ierr = FN_AllocateWorkMat(fn,A,&M);CHKERRQ(ierr);
@@ -574,19 +871,22 @@ PetscErrorCode FNEvaluateFunctionMat(FN fn,Mat A,Mat B)
   /* evaluate matrix function */
   ierr = PetscLogEventBegin(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
   ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
-  if (symm) {
+  if (symm && !fn->method) {  /* prefer diagonalization */
     if (fn->ops->evaluatefunctionmatsym) {
       ierr = (*fn->ops->evaluatefunctionmatsym)(fn,M,F);CHKERRQ(ierr);
     } else {
       ierr = FNEvaluateFunctionMat_Sym_Default(fn,M,F);CHKERRQ(ierr);
     }
   } else {
-    if (fn->ops->evaluatefunctionmat) {
-      ierr = (*fn->ops->evaluatefunctionmat)(fn,M,F);CHKERRQ(ierr);
-    } else SETERRQ1(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"Matrix function not implemented in FN type %s",((PetscObject)fn)->type_name);
+    if (fn->ops->evaluatefunctionmat[fn->method]) {
+      ierr = (*fn->ops->evaluatefunctionmat[fn->method])(fn,M,F);CHKERRQ(ierr);
+    } else if (!fn->method) {
+      SETERRQ1(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"Matrix function not implemented in FN type %s",((PetscObject)fn)->type_name);
+    } else SETERRQ1(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_OUTOFRANGE,"The specified method number %D does not exist for this FN type",fn->method);
   }
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  fn->argid = 0;
 
   if (fn->alpha!=(PetscScalar)1.0) {
     ierr = FN_FreeWorkMat(fn,&M);CHKERRQ(ierr);
@@ -597,6 +897,61 @@ PetscErrorCode FNEvaluateFunctionMat(FN fn,Mat A,Mat B)
   PetscFunctionReturn(0);
 }
 
+/*@C
+   FNEvaluateFunctionMatMultiple - Computes the value of several functions
+   for the same matrix, B[i]=f_i(A).
+
+   Logically Collective on FN
+
+   Input Parameters:
++  nf - number of functions
+.  fn - array of nf math function contexts
+-  A  - matrix on which the functions must be evaluated
+
+   Output Parameter:
+.  B  - array of nf matrices where the results are placed
+
+   Notes:
+   This is equivalent to calling FNEvaluateFunctionMat(fn[i],A,B[i]) for each
+   function, but the Schur decomposition of A is computed only once and shared
+   by the functions whose method requires it, see FNSetSchurCache(). Functions
+   that have their own cache active use it instead.
+
+   The matrices B[i] must be different from A, since A is used by all the
+   evaluations.
+
+   Level: advanced
+
+.seealso: FNEvaluateFunctionMat(), FNSetSchurCache()
+@*/
+PetscErrorCode FNEvaluateFunctionMatMultiple(PetscInt nf,FN *fn,Mat A,Mat *B)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  FN_SCHUR       *sc,*old;
+
+  PetscFunctionBegin;
+  if (nf<0) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Argument nf cannot be negative");
+  if (!nf) PetscFunctionReturn(0);
+  PetscValidPointer(fn,2);
+  PetscValidHeaderSpecific(A,MAT_CLASSID,3);
+  PetscValidPointer(B,4);
+  for (i=0;i<nf;i++) {
+    PetscValidHeaderSpecific(fn[i],FN_CLASSID,2);
+    PetscValidHeaderSpecific(B[i],MAT_CLASSID,4);
+    if (B[i]==A) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_IDN,"The result matrices must be different from A");
+  }
+  ierr = PetscNew(&sc);CHKERRQ(ierr);
+  for (i=0;i<nf;i++) {
+    old = fn[i]->schur;
+    if (!old) fn[i]->schur = sc;
+    ierr = FNEvaluateFunctionMat(fn[i],A,B[i]);CHKERRQ(ierr);
+    fn[i]->schur = old;
+  }
+  ierr = FNSchurCacheDestroy_Private(&sc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    FNEvaluateFunctionMatVec_Default - computes the full matrix f(A)
    and then copies the first column.
@@ -608,9 +963,11 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Default(FN fn,Mat A,Vec v)
 
   PetscFunctionBegin;
   ierr = FN_AllocateWorkMat(fn,A,&F);CHKERRQ(ierr);
-  if (fn->ops->evaluatefunctionmat) {
-    ierr = (*fn->ops->evaluatefunctionmat)(fn,A,F);CHKERRQ(ierr);
-  } else SETERRQ1(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"Matrix function not implemented in FN type %s",((PetscObject)fn)->type_name);
+  if (fn->ops->evaluatefunctionmat[fn->method]) {
+    ierr = (*fn->ops->evaluatefunctionmat[fn->method])(fn,A,F);CHKERRQ(ierr);
+  } else if (!fn->method) {
+    SETERRQ1(PetscObjectComm((PetscObject)fn),PETSC_ERR_SUP,"Matrix function not implemented in FN type %s",((PetscObject)fn)->type_name);
+  } else SETERRQ1(PetscObjectComm((PetscObject)fn),PETSC_ERR_ARG_OUTOFRANGE,"The specified method number %D does not exist for this FN type",fn->method);
   ierr = MatGetColumnVector(F,v,0);CHKERRQ(ierr);
   ierr = FN_FreeWorkMat(fn,&F);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -683,6 +1040,10 @@ PetscErrorCode FNEvaluateFunctionMatVec(FN fn,Mat A,Vec v)
   ierr = MatIsHermitianKnown(A,&set,&flg);CHKERRQ(ierr);
   symm = set? flg: PETSC_FALSE;
 
+  /* identify the argument for the Schur cache */
+  ierr = PetscObjectGetId((PetscObject)A,&fn->argid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)A,&fn->argstate);CHKERRQ(ierr);
+
   /* scale argument */
   if (fn->alpha!=(PetscScalar)1.0) {
     ierr = FN_AllocateWorkMat(fn,A,&M);CHKERRQ(ierr);
@@ -692,21 +1053,22 @@ PetscErrorCode FNEvaluateFunctionMatVec(FN fn,Mat A,Vec v)
   /* evaluate matrix function */
   ierr = PetscLogEventBegin(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
   ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
-  if (symm) {
+  if (symm && !fn->method) {  /* prefer diagonalization */
     if (fn->ops->evaluatefunctionmatvecsym) {
       ierr = (*fn->ops->evaluatefunctionmatvecsym)(fn,M,v);CHKERRQ(ierr);
     } else {
       ierr = FNEvaluateFunctionMatVec_Sym_Default(fn,M,v);CHKERRQ(ierr);
     }
   } else {
-    if (fn->ops->evaluatefunctionmatvec) {
-      ierr = (*fn->ops->evaluatefunctionmatvec)(fn,M,v);CHKERRQ(ierr);
+    if (fn->ops->evaluatefunctionmatvec[fn->method]) {
+      ierr = (*fn->ops->evaluatefunctionmatvec[fn->method])(fn,M,v);CHKERRQ(ierr);
     } else {
       ierr = FNEvaluateFunctionMatVec_Default(fn,M,v);CHKERRQ(ierr);
     }
   }
   ierr = PetscFPTrapPop();CHKERRQ(ierr);
   ierr = PetscLogEventEnd(FN_Evaluate,fn,0,0,0);CHKERRQ(ierr);
+  fn->argid = 0;
 
   if (fn->alpha!=(PetscScalar)1.0) {
     ierr = FN_FreeWorkMat(fn,&M);CHKERRQ(ierr);
@@ -735,8 +1097,8 @@ PetscErrorCode FNSetFromOptions(FN fn)
   PetscErrorCode ierr;
   char           type[256];
   PetscScalar    array[2];
-  PetscInt       k;
-  PetscBool      flg;
+  PetscInt       k,meth;
+  PetscBool      flg,cache;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(fn,FN_CLASSID,1);
@@ -757,6 +1119,13 @@ PetscErrorCode FNSetFromOptions(FN fn)
       ierr = FNSetScale(fn,array[0],array[1]);CHKERRQ(ierr);
     }
 
+    ierr = PetscOptionsInt("-fn_method","Method to be used for computing matrix functions","FNSetMethod",fn->method,&meth,&flg);CHKERRQ(ierr);
+    if (flg) { ierr = FNSetMethod(fn,meth);CHKERRQ(ierr); }
+
+    cache = fn->schur? PETSC_TRUE: PETSC_FALSE;
+    ierr = PetscOptionsBool("-fn_schur_cache","Keep the Schur decomposition of the matrix argument","FNSetSchurCache",cache,&cache,&flg);CHKERRQ(ierr);
+    if (flg) { ierr = FNSetSchurCache(fn,cache);CHKERRQ(ierr); }
+
     if (fn->ops->setfromoptions) {
       ierr = (*fn->ops->setfromoptions)(PetscOptionsObject,fn);CHKERRQ(ierr);
     }
@@ -805,6 +1174,9 @@ PetscErrorCode FNView(FN fn,PetscViewer viewer)
       ierr = (*fn->ops->view)(fn,viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
     }
+    if (fn->schur) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  keeping the Schur decomposition of the matrix argument, reused %D times\n",fn->schur->nhit);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -835,6 +1207,7 @@ PetscErrorCode FNDuplicate(FN fn,MPI_Comm comm,FN *newfn)
   PetscErrorCode ierr;
   FNType         type;
   PetscScalar    alpha,beta;
+  PetscInt       meth;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(fn,FN_CLASSID,1);
@@ -845,6 +1218,9 @@ PetscErrorCode FNDuplicate(FN fn,MPI_Comm comm,FN *newfn)
   ierr = FNSetType(*newfn,type);CHKERRQ(ierr);
   ierr = FNGetScale(fn,&alpha,&beta);CHKERRQ(ierr);
   ierr = FNSetScale(*newfn,alpha,beta);CHKERRQ(ierr);
+  ierr = FNGetMethod(fn,&meth);CHKERRQ(ierr);
+  ierr = FNSetMethod(*newfn,meth);CHKERRQ(ierr);
+  ierr = FNSetSchurCache(*newfn,fn->schur? PETSC_TRUE: PETSC_FALSE);CHKERRQ(ierr);
   if (fn->ops->duplicate) {
     ierr = (*fn->ops->duplicate)(fn,comm,newfn);CHKERRQ(ierr);
   }
@@ -876,6 +1252,10 @@ PetscErrorCode FNDestroy(FN *fn)
   for (i=0;i<(*fn)->nw;i++) {
     ierr = MatDestroy(&(*fn)->W[i]);CHKERRQ(ierr);
   }
+  ierr = PetscFree((*fn)->work);CHKERRQ(ierr);
+  ierr = PetscFree((*fn)->rwork);CHKERRQ(ierr);
+  ierr = PetscFree((*fn)->iwork);CHKERRQ(ierr);
+  ierr = FNSchurCacheDestroy_Private(&(*fn)->schur);CHKERRQ(ierr);
   ierr = PetscHeaderDestroy(fn);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,217 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-2016, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+
+   SLEPc is free software: you can redistribute it and/or modify it under  the
+   terms of version 3 of the GNU Lesser General Public License as published by
+   the Free Software Foundation.
+
+   SLEPc  is  distributed in the hope that it will be useful, but WITHOUT  ANY
+   WARRANTY;  without even the implied warranty of MERCHANTABILITY or  FITNESS
+   FOR  A  PARTICULAR PURPOSE. See the GNU Lesser General Public  License  for
+   more details.
+
+   You  should have received a copy of the GNU Lesser General  Public  License
+   along with SLEPc. If not, see <http://www.gnu.org/licenses/>.
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test the sorting of eigenvalues with the available comparison functions.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of eigenvalues.\n\n";
+
+#include <slepc/private/slepcimpl.h>
+
+/*
+   Insertion sort used by SlepcSortEigenvalues() before the merge sort,
+   equal values end up in reverse order with respect to the input
+*/
+static PetscErrorCode RefSortEigenvalues(SlepcSC sc,PetscInt n,PetscScalar *eigr,PetscScalar *eigi,PetscInt *perm)
+{
+  PetscErrorCode ierr;
+  PetscScalar    re,im;
+  PetscInt       i,j,result,tmp;
+
+  PetscFunctionBeginUser;
+  for (i=n-1;i>=0;i--) {
+    re = eigr[perm[i]];
+    im = eigi[perm[i]];
+    j = i+1;
+#if !defined(PETSC_USE_COMPLEX)
+    if (im!=0) {
+      i--;
+      im = eigi[perm[i]];
+    }
+#endif
+    while (j<n) {
+      ierr = SlepcSCCompare(sc,re,im,eigr[perm[j]],eigi[perm[j]],&result);CHKERRQ(ierr);
+      if (result<0) break;
+#if !defined(PETSC_USE_COMPLEX)
+      if (!im) {
+        if (eigi[perm[j]] == 0.0) {
+#endif
+          tmp = perm[j-1]; perm[j-1] = perm[j]; perm[j] = tmp;
+          j++;
+#if !defined(PETSC_USE_COMPLEX)
+        } else {
+          tmp = perm[j-1]; perm[j-1] = perm[j]; perm[j] = perm[j+1]; perm[j+1] = tmp;
+          j+=2;
+        }
+      } else {
+        if (eigi[perm[j]] == 0.0) {
+          tmp = perm[j-2]; perm[j-2] = perm[j]; perm[j] = perm[j-1]; perm[j-1] = tmp;
+          j++;
+        } else {
+          tmp = perm[j-2]; perm[j-2] = perm[j]; perm[j] = tmp;
+          tmp = perm[j-1]; perm[j-1] = perm[j+1]; perm[j+1] = tmp;
+          j+=2;
+        }
+      }
+#endif
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Insertion sort used by the DS sorting functions before the merge sort,
+   equal values keep their order in the input
+*/
+static PetscErrorCode RefSortItems(SlepcSC sc,PetscInt m,PetscScalar *kr,PetscScalar *ki,PetscInt *idx)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,result,tmp;
+
+  PetscFunctionBeginUser;
+  for (i=0;i<m;i++) idx[i] = i;
+  for (i=1;i<m;i++) {
+    tmp = idx[i];
+    for (j=i-1;j>=0;j--) {
+      ierr = SlepcSCCompare(sc,kr[tmp],ki[tmp],kr[idx[j]],ki[idx[j]],&result);CHKERRQ(ierr);
+      if (result>=0) break;
+      idx[j+1] = idx[j];
+    }
+    idx[j+1] = tmp;
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  struct _n_SlepcSC scdata;
+  SlepcSC        sc=&scdata;
+  PetscScalar    *eigr,*eigi,target=0.6;
+  PetscInt       i,j,c,q,n=2000,m,nw[3],*perm,*pref,*idx,*iref,*ipart,*mark;
+  PetscReal      a,b;
+  PetscBool      laterfirst,ok;
+  unsigned int   seed=12345;
+  const char     *cname[] = { "LargestMagnitude","SmallestMagnitude","LargestReal","SmallestReal",
+                              "LargestImaginary","SmallestImaginary","TargetMagnitude","TargetReal",
+                              "TargetImaginary","SmallestPosReal" };
+  PetscErrorCode (*cfun[])(PetscScalar,PetscScalar,PetscScalar,PetscScalar,PetscInt*,void*) = {
+                              SlepcCompareLargestMagnitude,SlepcCompareSmallestMagnitude,SlepcCompareLargestReal,
+                              SlepcCompareSmallestReal,SlepcCompareLargestImaginary,SlepcCompareSmallestImaginary,
+                              SlepcCompareTargetMagnitude,SlepcCompareTargetReal,SlepcCompareTargetImaginary,
+                              SlepcCompareSmallestPosReal };
+  const int      ncomp=sizeof(cname)/sizeof(cname[0]);
+
+  ierr = SlepcInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Sorting of %D eigenvalues with duplicates and conjugate pairs.\n",n);CHKERRQ(ierr);
+  ierr = PetscMalloc7(n,&eigr,n,&eigi,n,&perm,n,&pref,n,&idx,n,&iref,n,&ipart);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&mark);CHKERRQ(ierr);
+
+  /* values on a coarse grid, so that there are many duplicates, and about one third
+     of them in complex conjugate pairs (consecutive in real scalars) */
+  for (i=0;i<n;i++) {
+    seed = 1103515245*seed+12345;
+    a = ((PetscReal)((seed>>8)%41)-20.0)/8.0;
+    seed = 1103515245*seed+12345;
+    b = ((PetscReal)((seed>>8)%5)+1.0)/4.0;
+    eigi[i] = 0.0;
+    if (i<n-1 && (seed>>16)%3==0) {
+#if !defined(PETSC_USE_COMPLEX)
+      eigr[i] = a; eigi[i] = b;
+      eigr[i+1] = a; eigi[i+1] = -b;
+#else
+      eigr[i] = a+PETSC_i*b;
+      eigr[i+1] = a-PETSC_i*b;
+      eigi[i+1] = 0.0;
+#endif
+      i++;
+    } else eigr[i] = a;
+  }
+
+  sc->map    = NULL;
+  sc->mapobj = NULL;
+  sc->rg     = NULL;
+  nw[0] = 1; nw[1] = 10; nw[2] = n/3;
+  for (c=0;c<ncomp;c++) {
+    sc->comparison    = cfun[c];
+    sc->comparisonctx = &target;
+    ok = PETSC_TRUE;
+
+    /* SlepcSortEigenvalues() must give the same permutation as the insertion sort */
+    for (i=0;i<n;i++) perm[i] = pref[i] = i;
+    ierr = SlepcSortEigenvalues(sc,n,eigr,eigi,perm);CHKERRQ(ierr);
+    ierr = RefSortEigenvalues(sc,n,eigr,eigi,pref);CHKERRQ(ierr);
+    for (i=0;i<n;i++) if (perm[i]!=pref[i]) ok = PETSC_FALSE;
+    if (!ok) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD," %s: SlepcSortEigenvalues differs from the insertion sort\n",cname[c]);CHKERRQ(ierr);
+    }
+
+    /* items as built by the DS sorting functions, the first eigenvalue of each pair */
+    m = 0;
+    for (i=0;i<n;i++) {
+      eigr[m] = eigr[i]; eigi[m] = eigi[i];
+#if !defined(PETSC_USE_COMPLEX)
+      if (eigi[i]!=0.0) i++;
+#endif
+      m++;
+    }
+    ierr = SlepcSCSort_Private(sc,m,eigr,eigi,PETSC_FALSE,0,idx);CHKERRQ(ierr);
+    ierr = RefSortItems(sc,m,eigr,eigi,iref);CHKERRQ(ierr);
+    for (i=0;i<m;i++) if (idx[i]!=iref[i]) ok = PETSC_FALSE;
+    if (!ok) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD," %s: the DS ordering differs from the insertion sort\n",cname[c]);CHKERRQ(ierr);
+    }
+
+    /* partial selection: the first nw entries as in the full sort, the rest any order */
+    for (q=0;q<2;q++) {
+      laterfirst = q? PETSC_TRUE: PETSC_FALSE;
+      ierr = SlepcSCSort_Private(sc,m,eigr,eigi,laterfirst,0,idx);CHKERRQ(ierr);
+      for (j=0;j<3;j++) {
+        ierr = SlepcSCSort_Private(sc,m,eigr,eigi,laterfirst,nw[j],ipart);CHKERRQ(ierr);
+        ierr = PetscMemzero(mark,m*sizeof(PetscInt));CHKERRQ(ierr);
+        for (i=0;i<m;i++) {
+          if (i<nw[j] && ipart[i]!=idx[i]) ok = PETSC_FALSE;
+          if (ipart[i]<0 || ipart[i]>=m || mark[ipart[i]]++) ok = PETSC_FALSE;
+        }
+        if (!ok) {
+          ierr = PetscPrintf(PETSC_COMM_WORLD," %s: wrong partial selection of %D items\n",cname[c],nw[j]);CHKERRQ(ierr);
+          break;
+        }
+      }
+    }
+
+    /* restore the full list for the next comparison function */
+    for (i=m-1,j=n-1;i>=0;i--) {
+#if !defined(PETSC_USE_COMPLEX)
+      if (eigi[i]!=0.0) { eigr[j] = eigr[i]; eigi[j--] = -eigi[i]; }
+#endif
+      eigr[j] = eigr[i]; eigi[j--] = eigi[i];
+    }
+    if (ok) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD," %s: ok\n",cname[c]);CHKERRQ(ierr);
+    }
+  }
+
+  ierr = PetscFree7(eigr,eigi,perm,pref,idx,iref,ipart);CHKERRQ(ierr);
+  ierr = PetscFree(mark);CHKERRQ(ierr);
+  ierr = SlepcFinalize();
+  return ierr;
+}
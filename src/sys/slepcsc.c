@@ -80,6 +80,103 @@ PetscErrorCode SlepcSCCompare(SlepcSC sc,PetscScalar ar,PetscScalar ai,PetscScal
   PetscFunctionReturn(0);
 }
 
+/*
+   Determines whether item a, which was before item b in the input list,
+   must be placed before it
+*/
+PETSC_STATIC_INLINE PetscErrorCode SlepcSCBefore_Private(SlepcSC sc,const PetscScalar *kr,const PetscScalar *ki,PetscBool laterfirst,PetscInt a,PetscInt b,PetscBool *before)
+{
+  PetscErrorCode ierr;
+  PetscInt       result;
+
+  PetscFunctionBegin;
+  if (laterfirst) {
+    ierr = SlepcSCCompare(sc,kr[a],ki[a],kr[b],ki[b],&result);CHKERRQ(ierr);
+    *before = PetscNot(result>=0);
+  } else {
+    ierr = SlepcSCCompare(sc,kr[b],ki[b],kr[a],ki[a],&result);CHKERRQ(ierr);
+    *before = PetscNot(result<0);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Merge sort of the items idx[lo:hi-1], using aux as workspace
+*/
+static PetscErrorCode SlepcSCMergeSort_Private(SlepcSC sc,const PetscScalar *kr,const PetscScalar *ki,PetscBool laterfirst,PetscInt lo,PetscInt hi,PetscInt *idx,PetscInt *aux)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,p,mid;
+  PetscBool      before;
+
+  PetscFunctionBegin;
+  if (hi-lo<2) PetscFunctionReturn(0);
+  mid = (lo+hi)/2;
+  ierr = SlepcSCMergeSort_Private(sc,kr,ki,laterfirst,lo,mid,idx,aux);CHKERRQ(ierr);
+  ierr = SlepcSCMergeSort_Private(sc,kr,ki,laterfirst,mid,hi,idx,aux);CHKERRQ(ierr);
+  /* items of the left half were before those of the right half in the input,
+     nothing to do if the halves are already in order (e.g. nearly sorted lists) */
+  ierr = SlepcSCBefore_Private(sc,kr,ki,laterfirst,idx[mid-1],idx[mid],&before);CHKERRQ(ierr);
+  if (before) PetscFunctionReturn(0);
+  i = lo; j = mid; p = lo;
+  while (i<mid && j<hi) {
+    ierr = SlepcSCBefore_Private(sc,kr,ki,laterfirst,idx[i],idx[j],&before);CHKERRQ(ierr);
+    aux[p++] = before? idx[i++]: idx[j++];
+  }
+  while (i<mid) aux[p++] = idx[i++];
+  while (j<hi) aux[p++] = idx[j++];
+  ierr = PetscMemcpy(idx+lo,aux+lo,(hi-lo)*sizeof(PetscInt));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   SlepcSCSort_Private - Sorts m items with keys (kr[i],ki[i]) according to
+   the sorting criterion, returning in idx the indices of the items in the
+   sorted order.
+
+   Items that compare equal keep their relative order in the input, or the
+   reverse order if laterfirst is true (this is the behaviour of an insertion
+   sort that processes the list from the end).
+
+   If 0<nw<m, only the first nw positions of idx are sorted (partial
+   selection) and the rest of positions contain the remaining items in no
+   particular order. The number of comparisons is O(m log m), or O(m log nw)
+   in the partial case.
+*/
+PetscErrorCode SlepcSCSort_Private(SlepcSC sc,PetscInt m,const PetscScalar *kr,const PetscScalar *ki,PetscBool laterfirst,PetscInt nw,PetscInt *idx)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,q,it,lo,hi,mid,cnt=0,nrest=0,result,*aux;
+
+  PetscFunctionBegin;
+  if (m<=0) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(m,&aux);CHKERRQ(ierr);
+  if (nw>0 && nw<m) {
+    /* keep the best nw items sorted in idx[0:cnt-1], binary insertion */
+    for (q=0;q<m;q++) {
+      it = laterfirst? m-1-q: q;
+      lo = 0; hi = cnt;
+      while (lo<hi) {
+        mid = (lo+hi)/2;
+        ierr = SlepcSCCompare(sc,kr[it],ki[it],kr[idx[mid]],ki[idx[mid]],&result);CHKERRQ(ierr);
+        if (result<0) hi = mid;
+        else lo = mid+1;
+      }
+      if (lo>=nw) { aux[nrest++] = it; continue; }
+      if (cnt==nw) aux[nrest++] = idx[--cnt];
+      ierr = PetscMemmove(idx+lo+1,idx+lo,(cnt-lo)*sizeof(PetscInt));CHKERRQ(ierr);
+      idx[lo] = it;
+      cnt++;
+    }
+    ierr = PetscMemcpy(idx+cnt,aux,nrest*sizeof(PetscInt));CHKERRQ(ierr);
+  } else {
+    for (i=0;i<m;i++) idx[i] = i;
+    ierr = SlepcSCMergeSort_Private(sc,kr,ki,laterfirst,0,m,idx,aux);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(aux);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    SlepcSortEigenvalues - Sorts a list of eigenvalues according to the
    sorting criterion specified in a SlepcSC context.
@@ -98,7 +195,9 @@ PetscErrorCode SlepcSCCompare(SlepcSC sc,PetscScalar ar,PetscScalar ai,PetscScal
    Note:
    The result is a list of indices in the original eigenvalue array
    corresponding to the first n eigenvalues sorted in the specified
-   criterion.
+   criterion. A merge sort is used, so the number of comparisons is
+   O(n log n). Eigenvalues that are equal according to the criterion
+   appear in reverse order with respect to the input.
 
    Level: developer
 
@@ -107,54 +206,42 @@ PetscErrorCode SlepcSCCompare(SlepcSC sc,PetscScalar ar,PetscScalar ai,PetscScal
 PetscErrorCode SlepcSortEigenvalues(SlepcSC sc,PetscInt n,PetscScalar *eigr,PetscScalar *eigi,PetscInt *perm)
 {
   PetscErrorCode ierr;
-  PetscScalar    re,im;
-  PetscInt       i,j,result,tmp;
+  PetscScalar    *kr,*ki,tr;
+  PetscInt       i,j,m,s,len,tmp,*first,*idx,*orig;
 
   PetscFunctionBegin;
   PetscValidPointer(sc,1);
   PetscValidScalarPointer(eigr,3);
   PetscValidScalarPointer(eigi,4);
   PetscValidIntPointer(perm,5);
-  /* insertion sort */
+  if (n<=1) PetscFunctionReturn(0);
+  ierr = PetscMalloc5(n,&kr,n,&ki,n,&first,n,&idx,n,&orig);CHKERRQ(ierr);
+  /* build the list of items, keeping together every complex conjugated eigenpair */
+  m = 0;
   for (i=n-1;i>=0;i--) {
-    re = eigr[perm[i]];
-    im = eigi[perm[i]];
-    j = i+1;
+    kr[m] = eigr[perm[i]];
+    ki[m] = eigi[perm[i]];
 #if !defined(PETSC_USE_COMPLEX)
-    if (im!=0) {
+    if (ki[m]!=0.0 && i>0) {
       /* complex eigenvalue */
       i--;
-      im = eigi[perm[i]];
+      ki[m] = eigi[perm[i]];
     }
 #endif
-    while (j<n) {
-      ierr = SlepcSCCompare(sc,re,im,eigr[perm[j]],eigi[perm[j]],&result);CHKERRQ(ierr);
-      if (result<0) break;
-#if !defined(PETSC_USE_COMPLEX)
-      /* keep together every complex conjugated eigenpair */
-      if (!im) {
-        if (eigi[perm[j]] == 0.0) {
-#endif
-          tmp = perm[j-1]; perm[j-1] = perm[j]; perm[j] = tmp;
-          j++;
-#if !defined(PETSC_USE_COMPLEX)
-        } else {
-          tmp = perm[j-1]; perm[j-1] = perm[j]; perm[j] = perm[j+1]; perm[j+1] = tmp;
-          j+=2;
-        }
-      } else {
-        if (eigi[perm[j]] == 0.0) {
-          tmp = perm[j-2]; perm[j-2] = perm[j]; perm[j] = perm[j-1]; perm[j-1] = tmp;
-          j++;
-        } else {
-          tmp = perm[j-2]; perm[j-2] = perm[j]; perm[j] = tmp;
-          tmp = perm[j-1]; perm[j-1] = perm[j+1]; perm[j+1] = tmp;
-          j+=2;
-        }
-      }
-#endif
-    }
+    first[m++] = i;
+  }
+  for (i=0,j=m-1;i<j;i++,j--) {  /* restore the original order of items */
+    tr = kr[i]; kr[i] = kr[j]; kr[j] = tr;
+    tr = ki[i]; ki[i] = ki[j]; ki[j] = tr;
+    tmp = first[i]; first[i] = first[j]; first[j] = tmp;
+  }
+  ierr = SlepcSCSort_Private(sc,m,kr,ki,PETSC_TRUE,0,idx);CHKERRQ(ierr);
+  ierr = PetscMemcpy(orig,perm,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (s=0,j=0;s<m;s++) {
+    len = ((idx[s]<m-1)? first[idx[s]+1]: n)-first[idx[s]];
+    for (i=0;i<len;i++) perm[j++] = orig[first[idx[s]]+i];
   }
+  ierr = PetscFree5(kr,ki,first,idx,orig);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 